@@ -5,6 +5,7 @@
 #include "VectorIterator.h"
 #include "VectorChangedEventArgs.h"
 #include <algorithm>
+#include <iterator>
 
 // Nearly all Vector need to set DependencyObjectBase flag 
 // to make DependencyObject as ComposableBase
@@ -286,17 +287,94 @@ public:
         RaiseChildrenChanged(winrt::CollectionChange::Reset, 0u);
     }
 
+    // Replaces the content of the vector with values, raising a single Reset.
     void ReplaceAll(winrt::array_view<T_type const> values)
     {
-        Clear();
-        for (auto value : values)
+        std::vector<T_Storage> wrappedValues;
+        wrappedValues.reserve(values.size());
+        for (auto const& value : values)
         {
-            Append(value);
+            wrappedValues.push_back(wrap(value));
+        }
+
+        m_vector.swap(wrappedValues);
+        RaiseChildrenChanged(winrt::CollectionChange::Reset, 0u);
+    }
+
+    // Inserts values at index. A single value raises ItemInserted, more raise a single Reset.
+    void InsertRange(uint32_t const index, winrt::array_view<T_type const> values)
+    {
+        if (index > static_cast<uint32_t>(m_vector.size()))
+        {
+            throw winrt::hresult_out_of_bounds();
+        }
+
+        if (values.size() > 0)
+        {
+            m_vector.reserve(m_vector.size() + values.size());
+            std::vector<T_Storage> wrappedValues;
+            wrappedValues.reserve(values.size());
+            for (auto const& value : values)
+            {
+                wrappedValues.push_back(wrap(value));
+            }
+
+            m_vector.insert(m_vector.begin() + index, std::make_move_iterator(wrappedValues.begin()), std::make_move_iterator(wrappedValues.end()));
+            RaiseRangeChanged(winrt::CollectionChange::ItemInserted, index, values.size());
         }
     }
 
+    // Removes count items starting at index. A single item raises ItemRemoved, more raise a single Reset.
+    void RemoveRange(uint32_t const index, uint32_t const count)
+    {
+        if (index > static_cast<uint32_t>(m_vector.size()) || count > static_cast<uint32_t>(m_vector.size()) - index)
+        {
+            throw winrt::hresult_out_of_bounds();
+        }
+
+        if (count > 0)
+        {
+            m_vector.erase(m_vector.begin() + index, m_vector.begin() + index + count);
+            RaiseRangeChanged(winrt::CollectionChange::ItemRemoved, index, count);
+        }
+    }
+
+    // Replaces removeCount items starting at index with values. Raises a single Reset
+    // instead of one notification per item, and shifts the tail of the vector only once.
+    void ReplaceRange(uint32_t const index, uint32_t const removeCount, winrt::array_view<T_type const> values)
+    {
+        if (index > static_cast<uint32_t>(m_vector.size()) || removeCount > static_cast<uint32_t>(m_vector.size()) - index)
+        {
+            throw winrt::hresult_out_of_bounds();
+        }
+
+        std::vector<T_Storage> wrappedValues;
+        wrappedValues.reserve(values.size());
+        for (auto const& value : values)
+        {
+            wrappedValues.push_back(wrap(value));
+        }
+
+        const auto first = m_vector.erase(m_vector.begin() + index, m_vector.begin() + index + removeCount);
+        m_vector.insert(first, std::make_move_iterator(wrappedValues.begin()), std::make_move_iterator(wrappedValues.end()));
+        RaiseChildrenChanged(winrt::CollectionChange::Reset, 0u);
+    }
+
     virtual void RaiseChildrenChanged(winrt::CollectionChange collectionChange, unsigned int index) {};
 
+    // IVectorChangedEventArgs describes a single item, so changes to several items are raised as a Reset.
+    void RaiseRangeChanged(winrt::CollectionChange collectionChange, unsigned int index, uint32_t count)
+    {
+        if (count == 1)
+        {
+            RaiseChildrenChanged(collectionChange, index);
+        }
+        else
+        {
+            RaiseChildrenChanged(winrt::CollectionChange::Reset, 0u);
+        }
+    }
+
     void reserve(unsigned int n) { m_vector.reserve(n); }
 protected:
     using T_Storage = typename Wrapper::Holder;
@@ -521,6 +599,21 @@ struct VectorOptionsFromFlag :
             auto inner = this->GetVectorInnerImpl(); \
             return inner->ReplaceAll(value); \
         } \
+        void InsertRange(uint32_t index, winrt::array_view<typename Options##::T_type const> values) \
+        { \
+            auto inner = this->GetVectorInnerImpl(); \
+            return inner->InsertRange(index, values); \
+        } \
+        void RemoveRange(uint32_t index, uint32_t count) \
+        { \
+            auto inner = this->GetVectorInnerImpl(); \
+            return inner->RemoveRange(index, count); \
+        } \
+        void ReplaceRange(uint32_t index, uint32_t removeCount, winrt::array_view<typename Options##::T_type const> values) \
+        { \
+            auto inner = this->GetVectorInnerImpl(); \
+            return inner->ReplaceRange(index, removeCount, values); \
+        } \
         private:
 
 // Implement IIterator or IBindableIterator Interface
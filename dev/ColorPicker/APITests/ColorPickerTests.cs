@@ -6,6 +6,7 @@ using MUXControlsTestApp.Utilities;
 using System;
 using System.Numerics;
 using System.Collections;
+using System.Collections.Generic;
 using System.Linq;
 using System.Threading;
 using Windows.Foundation;
@@ -32,6 +33,8 @@ using ColorPicker = Microsoft.UI.Xaml.Controls.ColorPicker;
 using ColorChangedEventArgs = Microsoft.UI.Xaml.Controls.ColorChangedEventArgs;
 using ColorSpectrum = Microsoft.UI.Xaml.Controls.Primitives.ColorSpectrum;
 using XamlControlsXamlMetaDataProvider = Microsoft.UI.Xaml.XamlTypeInfo.XamlControlsXamlMetaDataProvider;
+using ColorSpectrumTestHooks = Microsoft.UI.Private.Controls.ColorSpectrumTestHooks;
+using ColorSpectrumTestParameters = Microsoft.UI.Private.Controls.ColorSpectrumTestParameters;
 
 namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
 {
@@ -268,6 +271,87 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
             });
         }
 
+        [TestMethod]
+        public void VerifyColorSpectrumRenderingMatchesPerPixelPath()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                foreach (var parameters in GetColorSpectrumTestParameters())
+                {
+                    Verify.AreEqual(0, ColorSpectrumTestHooks.CountRenderedBytesDifferentFromPerPixelPath(parameters),
+                        string.Format("Rendered {0} {1} spectrum of size {2} should match the per-pixel path.", parameters.Shape, parameters.Components, parameters.Size));
+                }
+            });
+        }
+
+        [TestMethod]
+        public void VerifyColorSpectrumHitTestingMatchesPerPixelPath()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                foreach (var parameters in GetColorSpectrumTestParameters())
+                {
+                    Verify.AreEqual(0, ColorSpectrumTestHooks.CountHitTestResultsDifferentFromPerPixelPath(parameters),
+                        string.Format("Hit-testing a {0} {1} spectrum of size {2} should match the per-pixel path.", parameters.Shape, parameters.Components, parameters.Size));
+                }
+            });
+        }
+
+        [TestMethod]
+        public void VerifyColorSpectrumPlaneCacheHoldsOnlyExactPlanes()
+        {
+            StackPanel panel = null;
+            RunOnUIThread.Execute(() =>
+            {
+                Content = null;
+            });
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                // Other tests share the cache.
+                ColorSpectrumTestHooks.ClearPlaneCache();
+
+                panel = new StackPanel();
+                Content = panel;
+            });
+
+            AddColorSpectrumAndWaitForFill(panel, 200);
+            RunOnUIThread.Execute(() =>
+            {
+                Verify.AreEqual(1, ColorSpectrumTestHooks.GetPlaneCacheEntryCount(), "The rendered planes should be cached.");
+            });
+
+            AddColorSpectrumAndWaitForFill(panel, 200);
+            RunOnUIThread.Execute(() =>
+            {
+                Verify.AreEqual(1, ColorSpectrumTestHooks.GetPlaneCacheEntryCount(), "A spectrum of the same size should reuse the cached planes.");
+            });
+
+            AddColorSpectrumAndWaitForFill(panel, 100);
+            RunOnUIThread.Execute(() =>
+            {
+                Verify.AreEqual(1, ColorSpectrumTestHooks.GetPlaneCacheEntryCount(), "Planes resampled from a larger spectrum should not be cached.");
+
+                Content = null;
+            });
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                Verify.AreEqual(1, ColorSpectrumTestHooks.GetPlaneCacheEntryCount(), "The cached planes should outlive the spectrums that use them.");
+
+                panel = new StackPanel();
+                Content = panel;
+            });
+
+            AddColorSpectrumAndWaitForFill(panel, 200);
+            RunOnUIThread.Execute(() =>
+            {
+                Verify.AreEqual(1, ColorSpectrumTestHooks.GetPlaneCacheEntryCount(), "Showing the spectrum again should reuse the cached planes.");
+            });
+        }
+
         [TestMethod]
         public void VerifyVisualTree()
         {
@@ -281,6 +365,24 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
             VisualTreeTestHelper.VerifyVisualTree(root: colorPicker, verificationFileNamePrefix: "ColorPicker");
         }
 
+        // Every shape and components combination, at an odd size so that rows don't fill whole SIMD lanes,
+        // with both the full ranges and narrowed ones.
+        private static IEnumerable<ColorSpectrumTestParameters> GetColorSpectrumTestParameters()
+        {
+            foreach (ColorSpectrumShape shape in Enum.GetValues(typeof(ColorSpectrumShape)))
+            {
+                foreach (ColorSpectrumComponents components in Enum.GetValues(typeof(ColorSpectrumComponents)))
+                {
+                    yield return new ColorSpectrumTestParameters {
+                        Size = 61, Shape = shape, Components = components,
+                        MinHue = 0, MaxHue = 359, MinSaturation = 0, MaxSaturation = 100, MinValue = 0, MaxValue = 100 };
+                    yield return new ColorSpectrumTestParameters {
+                        Size = 61, Shape = shape, Components = components,
+                        MinHue = 37, MaxHue = 300, MinSaturation = 20, MaxSaturation = 80, MinValue = 10, MaxValue = 90 };
+                }
+            }
+        }
+
         // This takes a FrameworkElement parameter so you can pass in either a ColorPicker or a ColorSpectrum.
         private void SetAsRootAndWaitForColorSpectrumFill(FrameworkElement element)
         {
@@ -305,5 +407,36 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
 
             spectrumLoadedEvent.WaitOne();
         }
+
+        // Cached planes are applied synchronously during layout, before Loaded is raised,
+        // so rather than listening for the Fill to change we poll until it's been set.
+        private void AddColorSpectrumAndWaitForFill(Panel panel, double size)
+        {
+            ColorSpectrum colorSpectrum = null;
+            RunOnUIThread.Execute(() =>
+            {
+                colorSpectrum = new ColorSpectrum { Width = size, Height = size };
+                panel.Children.Add(colorSpectrum);
+                panel.UpdateLayout();
+            });
+
+            bool isFilled = false;
+            for (int attempt = 0; attempt < 100 && !isFilled; attempt++)
+            {
+                IdleSynchronizer.Wait();
+                RunOnUIThread.Execute(() =>
+                {
+                    var spectrumRectangle = VisualTreeUtils.FindVisualChildByName(colorSpectrum, "SpectrumRectangle") as Rectangle;
+                    isFilled = spectrumRectangle != null && spectrumRectangle.Fill != null;
+                });
+
+                if (!isFilled)
+                {
+                    Thread.Sleep(50);
+                }
+            }
+
+            Verify.IsTrue(isFilled, "The ColorSpectrum should have been filled.");
+        }
     }
 }
\ No newline at end of file
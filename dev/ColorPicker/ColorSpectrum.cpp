@@ -86,7 +86,7 @@ void ColorSpectrum::OnApplyTemplate()
     }
 
     // If we haven't yet created our bitmaps, do so now.
-    if (m_hsvValues.size() == 0)
+    if (!m_planeSetFromLastBitmapCreation)
     {
         CreateBitmapsAndColorMap();
     }
@@ -502,7 +502,7 @@ void ColorSpectrum::UpdateColorFromPoint(const winrt::PointerPoint& point)
 {
     // If we haven't initialized our HSV value array yet, then we should just ignore any user input -
     // we don't yet know what to do with it.
-    if (m_hsvValues.size() == 0)
+    if (!m_planeSetFromLastBitmapCreation)
     {
         return;
     }
@@ -521,10 +521,10 @@ void ColorSpectrum::UpdateColorFromPoint(const winrt::PointerPoint& point)
         yPosition = (radius / distanceFromRadius) * (yPosition - radius) + radius;
     }
 
-    // Now we need to find the index into the array of HSL values at each point in the spectrum m_image.
+    // Now we need to find the pixel of the spectrum image that is at this point.
     int x = static_cast<int>(round(xPosition));
     int y = static_cast<int>(round(yPosition));
-    const int width = static_cast<int>(round(m_imageWidthFromLastBitmapCreation));
+    const ColorSpectrumRenderer::SpectrumParameters& spectrumParameters = m_planeSetFromLastBitmapCreation->parameters;
 
     if (x < 0)
     {
@@ -544,9 +544,13 @@ void ColorSpectrum::UpdateColorFromPoint(const winrt::PointerPoint& point)
         y = static_cast<int>(round(m_imageHeightFromLastBitmapCreation)) - 1;
     }
 
+    // Since the image was rounded to whole pixels, the point can still be one pixel past its last row or column.
+    x = min(x, spectrumParameters.size - 1);
+    y = min(y, spectrumParameters.size - 1);
+
     // The gradient image contains two dimensions of HSL information, but not the third.
     // We should keep the third where it already was.
-    Hsv hsvAtPoint = m_hsvValues[y * width + x];
+    Hsv hsvAtPoint = ColorSpectrumRenderer::GetHsvAt<Hsv>(spectrumParameters, y, x);
 
     const auto components = Components();
     const auto hsvColor = HsvColor();
@@ -875,7 +879,6 @@ void ColorSpectrum::CreateBitmapsAndColorMap()
     spectrumOverlayEllipse.Width(minDimension);
     spectrumOverlayEllipse.Height(minDimension);
 
-    const winrt::float4 hsvColor = HsvColor();
     const int minHue = MinHue();
     int maxHue = MaxHue();
     const int minSaturation = MinSaturation();
@@ -901,39 +904,63 @@ void ColorSpectrum::CreateBitmapsAndColorMap()
         maxValue = minValue;
     }
 
-    const Hsv hsv = { hsv::GetHue(hsvColor), hsv::GetSaturation(hsvColor), hsv::GetValue(hsvColor) };
+    ColorSpectrumRenderer::SpectrumParameters spectrumParameters;
+    spectrumParameters.size = static_cast<int>(round(minDimension));
+    spectrumParameters.shape = static_cast<ColorSpectrumRenderer::SpectrumShape>(shape);
+    spectrumParameters.components = static_cast<ColorSpectrumRenderer::SpectrumComponents>(components);
+    spectrumParameters.minHue = minHue;
+    spectrumParameters.maxHue = maxHue;
+    spectrumParameters.minSaturation = minSaturation;
+    spectrumParameters.maxSaturation = maxSaturation;
+    spectrumParameters.minValue = minValue;
+    spectrumParameters.maxValue = maxValue;
+
+    // Whatever bitmap creation is still in progress is for a configuration we no longer display.
+    if (m_createImageBitmapAction)
+    {
+        m_createImageBitmapAction.Cancel();
+        m_createImageBitmapAction = nullptr;
+    }
+
+    // If this configuration was generated before, by this ColorSpectrum or by another one, we can use it right away.
+    if (auto cachedPlaneSet = ColorSpectrumPlaneCache::Instance().Find(spectrumParameters))
+    {
+        UpdateBitmapsFromPlaneSet(minDimension, cachedPlaneSet);
+        return;
+    }
+
+    // If only the size differs from a configuration that was generated at a larger size,
+    // then we'll resample its planes instead of computing every pixel again.
+    const shared_ptr<const ColorSpectrumPlaneSet> resamplingSource = ColorSpectrumPlaneCache::Instance().FindResamplingSource(spectrumParameters);
 
     // The middle 4 are only needed and used in the case of hue as the third dimension.
     // Saturation and luminosity need only a min and max.
-    shared_ptr<vector<::byte>> bgraMinPixelData = make_shared<vector<::byte>>();
-    shared_ptr<vector<::byte>> bgraMiddle1PixelData = make_shared<vector<::byte>>();
-    shared_ptr<vector<::byte>> bgraMiddle2PixelData = make_shared<vector<::byte>>();
-    shared_ptr<vector<::byte>> bgraMiddle3PixelData = make_shared<vector<::byte>>();
-    shared_ptr<vector<::byte>> bgraMiddle4PixelData = make_shared<vector<::byte>>();
-    shared_ptr<vector<::byte>> bgraMaxPixelData = make_shared<vector<::byte>>();
-    shared_ptr<vector<Hsv>> newHsvValues = make_shared<vector<Hsv>>();
-
-    const auto pixelCount = static_cast<size_t>(round(minDimension) * round(minDimension));
+    // The pixels are written in place, possibly from several threads, so every buffer is allocated up front.
+    const auto pixelCount = static_cast<size_t>(spectrumParameters.size) * static_cast<size_t>(spectrumParameters.size);
     const size_t pixelDataSize = pixelCount * 4;
-    bgraMinPixelData->reserve(pixelDataSize);
+
+    auto newPlaneSet = make_shared<ColorSpectrumPlaneSet>();
+    newPlaneSet->parameters = spectrumParameters;
+    newPlaneSet->isResampled = resamplingSource != nullptr;
+    newPlaneSet->bgraMinPixelData = make_shared<vector<::byte>>(pixelDataSize);
+    newPlaneSet->bgraMiddle1PixelData = make_shared<vector<::byte>>();
+    newPlaneSet->bgraMiddle2PixelData = make_shared<vector<::byte>>();
+    newPlaneSet->bgraMiddle3PixelData = make_shared<vector<::byte>>();
+    newPlaneSet->bgraMiddle4PixelData = make_shared<vector<::byte>>();
+    newPlaneSet->bgraMaxPixelData = make_shared<vector<::byte>>(pixelDataSize);
 
     // We'll only save pixel data for the middle bitmaps if our third dimension is hue.
     if (components == winrt::ColorSpectrumComponents::ValueSaturation ||
         components == winrt::ColorSpectrumComponents::SaturationValue)
     {
-        bgraMiddle1PixelData->reserve(pixelDataSize);
-        bgraMiddle2PixelData->reserve(pixelDataSize);
-        bgraMiddle3PixelData->reserve(pixelDataSize);
-        bgraMiddle4PixelData->reserve(pixelDataSize);
+        newPlaneSet->bgraMiddle1PixelData->resize(pixelDataSize);
+        newPlaneSet->bgraMiddle2PixelData->resize(pixelDataSize);
+        newPlaneSet->bgraMiddle3PixelData->resize(pixelDataSize);
+        newPlaneSet->bgraMiddle4PixelData->resize(pixelDataSize);
     }
 
-    bgraMaxPixelData->reserve(pixelDataSize);
-    newHsvValues->reserve(pixelCount);
-
-    const int minDimensionInt = static_cast<int>(round(minDimension));
     winrt::WorkItemHandler workItemHandler(
-        [minDimensionInt, hsv, minHue, maxHue, minSaturation, maxSaturation, minValue, maxValue, shape, components,
-        bgraMinPixelData, bgraMiddle1PixelData, bgraMiddle2PixelData, bgraMiddle3PixelData, bgraMiddle4PixelData, bgraMaxPixelData, newHsvValues]
+        [newPlaneSet, resamplingSource]
     (winrt::IAsyncAction workItem)
         {
             // As the user perceives it, every time the third dimension not represented in the ColorSpectrum changes,
@@ -950,53 +977,65 @@ void ColorSpectrum::CreateBitmapsAndColorMap()
             // We'll then blend between whichever colors our hue exists between - e.g., an orange color would use red and yellow with an opacity of 50%.
             // This optimization does incur slightly more startup time initially since we have to generate multiple bitmaps at once instead of only one,
             // but the running time savings after that are *huge* when we can just set an opacity instead of generating a brand new bitmap.
-            if (shape == winrt::ColorSpectrumShape::Box)
+            const ColorSpectrumRenderer::SpectrumParameters& spectrumParameters = newPlaneSet->parameters;
+            const auto isCanceled = [workItem]() { return workItem.Status() == winrt::AsyncStatus::Canceled; };
+
+            if (resamplingSource)
             {
-                for (int x = minDimensionInt - 1; x >= 0; --x)
+                const std::pair<const vector<::byte>&, vector<::byte>&> planePairs[] =
                 {
-                    for (int y = minDimensionInt - 1; y >= 0; --y)
+                    { *resamplingSource->bgraMinPixelData, *newPlaneSet->bgraMinPixelData },
+                    { *resamplingSource->bgraMiddle1PixelData, *newPlaneSet->bgraMiddle1PixelData },
+                    { *resamplingSource->bgraMiddle2PixelData, *newPlaneSet->bgraMiddle2PixelData },
+                    { *resamplingSource->bgraMiddle3PixelData, *newPlaneSet->bgraMiddle3PixelData },
+                    { *resamplingSource->bgraMiddle4PixelData, *newPlaneSet->bgraMiddle4PixelData },
+                    { *resamplingSource->bgraMaxPixelData, *newPlaneSet->bgraMaxPixelData },
+                };
+
+                for (auto const& [sourcePixelData, destinationPixelData] : planePairs)
+                {
+                    if (isCanceled())
                     {
-                        if (workItem.Status() == winrt::AsyncStatus::Canceled)
-                        {
-                            break;
-                        }
-
-                        ColorSpectrum::FillPixelForBox(
-                            x, y, hsv, minDimensionInt, components, minHue, maxHue, minSaturation, maxSaturation, minValue, maxValue,
-                            bgraMinPixelData, bgraMiddle1PixelData, bgraMiddle2PixelData, bgraMiddle3PixelData, bgraMiddle4PixelData, bgraMaxPixelData,
-                            newHsvValues);
+                        return;
+                    }
+
+                    if (!destinationPixelData.empty())
+                    {
+                        ColorSpectrumRenderer::ResamplePlane(
+                            sourcePixelData.data(),
+                            resamplingSource->parameters.size,
+                            destinationPixelData.data(),
+                            spectrumParameters.size,
+                            spectrumParameters.shape);
                     }
                 }
             }
             else
             {
-                for (int y = 0; y < minDimensionInt; ++y)
+                const bool thirdDimensionIsHue = ColorSpectrumRenderer::ThirdDimensionIsHue(spectrumParameters.components);
+
+                ColorSpectrumRenderer::SpectrumPlanes planes;
+                planes.min = newPlaneSet->bgraMinPixelData->data();
+                planes.middle1 = thirdDimensionIsHue ? newPlaneSet->bgraMiddle1PixelData->data() : nullptr;
+                planes.middle2 = thirdDimensionIsHue ? newPlaneSet->bgraMiddle2PixelData->data() : nullptr;
+                planes.middle3 = thirdDimensionIsHue ? newPlaneSet->bgraMiddle3PixelData->data() : nullptr;
+                planes.middle4 = thirdDimensionIsHue ? newPlaneSet->bgraMiddle4PixelData->data() : nullptr;
+                planes.max = newPlaneSet->bgraMaxPixelData->data();
+
+                // Other tiles are rendered by additional thread pool work items rather than by threads of our own.
+                const auto queueOnThreadPool = [](std::function<void()> const& work)
                 {
-                    for (int x = 0; x < minDimensionInt; ++x)
-                    {
-                        if (workItem.Status() == winrt::AsyncStatus::Canceled)
-                        {
-                            break;
-                        }
-
-                        ColorSpectrum::FillPixelForRing(
-                            x, y, minDimensionInt / 2.0, hsv, components, minHue, maxHue, minSaturation, maxSaturation, minValue, maxValue,
-                            bgraMinPixelData, bgraMiddle1PixelData, bgraMiddle2PixelData, bgraMiddle3PixelData, bgraMiddle4PixelData, bgraMaxPixelData,
-                            newHsvValues);
-                    }
-                }
+                    winrt::ThreadPool::RunAsync(winrt::WorkItemHandler([work](winrt::IAsyncAction const&) { work(); }));
+                };
+
+                ColorSpectrumRenderer::Render(spectrumParameters, planes, isCanceled, queueOnThreadPool);
             }
         });
 
-    if (m_createImageBitmapAction)
-    {
-        m_createImageBitmapAction.Cancel();
-    }
-
     m_createImageBitmapAction = winrt::ThreadPool::RunAsync(workItemHandler);
     auto strongThis = get_strong();
     m_createImageBitmapAction.Completed(winrt::AsyncActionCompletedHandler(
-        [strongThis, minDimension, components, bgraMinPixelData, bgraMiddle1PixelData, bgraMiddle2PixelData, bgraMiddle3PixelData, bgraMiddle4PixelData, bgraMaxPixelData, newHsvValues]
+        [strongThis, minDimension, newPlaneSet]
     (winrt::IAsyncAction asyncInfo, winrt::AsyncStatus asyncStatus)
     {
         if (asyncStatus != winrt::AsyncStatus::Completed)
@@ -1004,434 +1043,105 @@ void ColorSpectrum::CreateBitmapsAndColorMap()
             return;
         }
 
-        strongThis->m_createImageBitmapAction = nullptr;
-
         strongThis->m_dispatcherHelper.RunAsync(
-            [strongThis, minDimension, bgraMinPixelData, bgraMiddle1PixelData, bgraMiddle2PixelData, bgraMiddle3PixelData, bgraMiddle4PixelData, bgraMaxPixelData, newHsvValues]()
+            [strongThis, minDimension, newPlaneSet, asyncInfo]()
         {
-            const int pixelWidth = static_cast<int>(round(minDimension));
-            const int pixelHeight = static_cast<int>(round(minDimension));
+            ColorSpectrumPlaneCache::Instance().Add(newPlaneSet);
 
-            const winrt::ColorSpectrumComponents components = strongThis->Components();
-
-            if (SharedHelpers::IsRS2OrHigher())
-            {
-                winrt::LoadedImageSurface minSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMinPixelData);
-                winrt::LoadedImageSurface maxSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMaxPixelData);
-
-                switch (components)
-                {
-                case winrt::ColorSpectrumComponents::HueValue:
-                case winrt::ColorSpectrumComponents::ValueHue:
-                    strongThis->m_saturationMinimumSurface = minSurface;
-                    strongThis->m_saturationMaximumSurface = maxSurface;
-                    break;
-                case winrt::ColorSpectrumComponents::HueSaturation:
-                case winrt::ColorSpectrumComponents::SaturationHue:
-                    strongThis->m_valueSurface = maxSurface;
-                    break;
-                case winrt::ColorSpectrumComponents::ValueSaturation:
-                case winrt::ColorSpectrumComponents::SaturationValue:
-                    strongThis->m_hueRedSurface = minSurface;
-                    strongThis->m_hueYellowSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMiddle1PixelData);
-                    strongThis->m_hueGreenSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMiddle2PixelData);
-                    strongThis->m_hueCyanSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMiddle3PixelData);
-                    strongThis->m_hueBlueSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, bgraMiddle4PixelData);
-                    strongThis->m_huePurpleSurface = maxSurface;
-                    break;
-                }
-            }
-            else
+            // A cached configuration may have been applied since this one was requested,
+            // in which case these planes are no longer the ones we want to display.
+            if (strongThis->m_createImageBitmapAction != asyncInfo)
             {
-                winrt::WriteableBitmap minBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMinPixelData);
-                winrt::WriteableBitmap maxBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMaxPixelData);
-
-                switch (components)
-                {
-                case winrt::ColorSpectrumComponents::HueValue:
-                case winrt::ColorSpectrumComponents::ValueHue:
-                    strongThis->m_saturationMinimumBitmap = minBitmap;
-                    strongThis->m_saturationMaximumBitmap = maxBitmap;
-                    break;
-                case winrt::ColorSpectrumComponents::HueSaturation:
-                case winrt::ColorSpectrumComponents::SaturationHue:
-                    strongThis->m_valueBitmap = maxBitmap;
-                    break;
-                case winrt::ColorSpectrumComponents::ValueSaturation:
-                case winrt::ColorSpectrumComponents::SaturationValue:
-                    strongThis->m_hueRedBitmap = minBitmap;
-                    strongThis->m_hueYellowBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMiddle1PixelData);
-                    strongThis->m_hueGreenBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMiddle2PixelData);
-                    strongThis->m_hueCyanBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMiddle3PixelData);
-                    strongThis->m_hueBlueBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, bgraMiddle4PixelData);
-                    strongThis->m_huePurpleBitmap = maxBitmap;
-                    break;
-                }
+                return;
             }
 
-            strongThis->m_shapeFromLastBitmapCreation = strongThis->Shape();
-            strongThis->m_componentsFromLastBitmapCreation = strongThis->Components();
-            strongThis->m_imageWidthFromLastBitmapCreation = minDimension;
-            strongThis->m_imageHeightFromLastBitmapCreation = minDimension;
-            strongThis->m_minHueFromLastBitmapCreation = strongThis->MinHue();
-            strongThis->m_maxHueFromLastBitmapCreation = strongThis->MaxHue();
-            strongThis->m_minSaturationFromLastBitmapCreation = strongThis->MinSaturation();
-            strongThis->m_maxSaturationFromLastBitmapCreation = strongThis->MaxSaturation();
-            strongThis->m_minValueFromLastBitmapCreation = strongThis->MinValue();
-            strongThis->m_maxValueFromLastBitmapCreation = strongThis->MaxValue();
-
-            strongThis->m_hsvValues = *newHsvValues;
-
-            strongThis->UpdateBitmapSources();
-            strongThis->UpdateEllipse();
+            strongThis->m_createImageBitmapAction = nullptr;
+            strongThis->UpdateBitmapsFromPlaneSet(minDimension, newPlaneSet);
         });
     }));
 }
 
-void ColorSpectrum::FillPixelForBox(
-    double x,
-    double y,
-    const Hsv &baseHsv,
-    double minDimension,
-    winrt::ColorSpectrumComponents components,
-    double minHue,
-    double maxHue,
-    double minSaturation,
-    double maxSaturation,
-    double minValue,
-    double maxValue,
-    shared_ptr<vector<::byte>> bgraMinPixelData,
-    shared_ptr<vector<::byte>> bgraMiddle1PixelData,
-    shared_ptr<vector<::byte>> bgraMiddle2PixelData,
-    shared_ptr<vector<::byte>> bgraMiddle3PixelData,
-    shared_ptr<vector<::byte>> bgraMiddle4PixelData,
-    shared_ptr<vector<::byte>> bgraMaxPixelData,
-    shared_ptr<vector<Hsv>> newHsvValues)
-{
-    const double hMin = minHue;
-    const double hMax = maxHue;
-    const double sMin = minSaturation / 100.0;
-    const double sMax = maxSaturation / 100.0;
-    const double vMin = minValue / 100.0;
-    const double vMax = maxValue / 100.0;
-
-    Hsv hsvMin = baseHsv;
-    Hsv hsvMiddle1 = baseHsv;
-    Hsv hsvMiddle2 = baseHsv;
-    Hsv hsvMiddle3 = baseHsv;
-    Hsv hsvMiddle4 = baseHsv;
-    Hsv hsvMax = baseHsv;
-
-    const double xPercent = (minDimension - 1 - x) / (minDimension - 1);
-    const double yPercent = (minDimension - 1 - y) / (minDimension - 1);
-
-    switch (components)
-    {
-    case winrt::ColorSpectrumComponents::HueValue:
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + yPercent * (hMax - hMin);
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + xPercent * (vMax - vMin);
-        hsvMin.s = 0;
-        hsvMax.s = 1;
-        break;
-
-    case winrt::ColorSpectrumComponents::HueSaturation:
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + yPercent * (hMax - hMin);
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + xPercent * (sMax - sMin);
-        hsvMin.v = 0;
-        hsvMax.v = 1;
-        break;
-
-    case winrt::ColorSpectrumComponents::ValueHue:
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + yPercent * (vMax - vMin);
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + xPercent * (hMax - hMin);
-        hsvMin.s = 0;
-        hsvMax.s = 1;
-        break;
-
-    case winrt::ColorSpectrumComponents::ValueSaturation:
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + yPercent * (vMax - vMin);
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + xPercent * (sMax - sMin);
-        hsvMin.h = 0;
-        hsvMiddle1.h = 60;
-        hsvMiddle2.h = 120;
-        hsvMiddle3.h = 180;
-        hsvMiddle4.h = 240;
-        hsvMax.h = 300;
-        break;
-
-    case winrt::ColorSpectrumComponents::SaturationHue:
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + yPercent * (sMax - sMin);
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + xPercent * (hMax - hMin);
-        hsvMin.v = 0;
-        hsvMax.v = 1;
-        break;
-
-    case winrt::ColorSpectrumComponents::SaturationValue:
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + yPercent * (sMax - sMin);
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + xPercent * (vMax - vMin);
-        hsvMin.h = 0;
-        hsvMiddle1.h = 60;
-        hsvMiddle2.h = 120;
-        hsvMiddle3.h = 180;
-        hsvMiddle4.h = 240;
-        hsvMax.h = 300;
-        break;
-    }
-
-    // If saturation is an axis in the spectrum with hue, or value is an axis, then we want
-    // that axis to go from maximum at the top to minimum at the bottom,
-    // or maximum at the outside to minimum at the inside in the case of the ring configuration,
-    // so we'll invert the number before assigning the HSL value to the array.
-    // Otherwise, we'll have a very narrow section in the middle that actually has meaningful hue
-    // in the case of the ring configuration.
-    if (components == winrt::ColorSpectrumComponents::HueSaturation ||
-        components == winrt::ColorSpectrumComponents::SaturationHue)
-    {
-        hsvMin.s = sMax - hsvMin.s + sMin;
-        hsvMiddle1.s = sMax - hsvMiddle1.s + sMin;
-        hsvMiddle2.s = sMax - hsvMiddle2.s + sMin;
-        hsvMiddle3.s = sMax - hsvMiddle3.s + sMin;
-        hsvMiddle4.s = sMax - hsvMiddle4.s + sMin;
-        hsvMax.s = sMax - hsvMax.s + sMin;
-    }
-    else
-    {
-        hsvMin.v = vMax - hsvMin.v + vMin;
-        hsvMiddle1.v = vMax - hsvMiddle1.v + vMin;
-        hsvMiddle2.v = vMax - hsvMiddle2.v + vMin;
-        hsvMiddle3.v = vMax - hsvMiddle3.v + vMin;
-        hsvMiddle4.v = vMax - hsvMiddle4.v + vMin;
-        hsvMax.v = vMax - hsvMax.v + vMin;
-    }
-
-    newHsvValues->push_back(hsvMin);
-
-    const Rgb rgbMin = HsvToRgb(hsvMin);
-    bgraMinPixelData->push_back(static_cast<::byte>(round(rgbMin.b * 255))); // b
-    bgraMinPixelData->push_back(static_cast<::byte>(round(rgbMin.g * 255))); // g
-    bgraMinPixelData->push_back(static_cast<::byte>(round(rgbMin.r * 255))); // r
-    bgraMinPixelData->push_back(255); // a - ignored
-
-    // We'll only save pixel data for the middle bitmaps if our third dimension is hue.
-    if (components == winrt::ColorSpectrumComponents::ValueSaturation ||
-        components == winrt::ColorSpectrumComponents::SaturationValue)
-    {
-        const Rgb rgbMiddle1 = HsvToRgb(hsvMiddle1);
-        bgraMiddle1PixelData->push_back(static_cast<::byte>(round(rgbMiddle1.b * 255))); // b
-        bgraMiddle1PixelData->push_back(static_cast<::byte>(round(rgbMiddle1.g * 255))); // g
-        bgraMiddle1PixelData->push_back(static_cast<::byte>(round(rgbMiddle1.r * 255))); // r
-        bgraMiddle1PixelData->push_back(255); // a - ignored
-
-        const Rgb rgbMiddle2 = HsvToRgb(hsvMiddle2);
-        bgraMiddle2PixelData->push_back(static_cast<::byte>(round(rgbMiddle2.b * 255))); // b
-        bgraMiddle2PixelData->push_back(static_cast<::byte>(round(rgbMiddle2.g * 255))); // g
-        bgraMiddle2PixelData->push_back(static_cast<::byte>(round(rgbMiddle2.r * 255))); // r
-        bgraMiddle2PixelData->push_back(255); // a - ignored
-
-        const Rgb rgbMiddle3 = HsvToRgb(hsvMiddle3);
-        bgraMiddle3PixelData->push_back(static_cast<::byte>(round(rgbMiddle3.b * 255))); // b
-        bgraMiddle3PixelData->push_back(static_cast<::byte>(round(rgbMiddle3.g * 255))); // g
-        bgraMiddle3PixelData->push_back(static_cast<::byte>(round(rgbMiddle3.r * 255))); // r
-        bgraMiddle3PixelData->push_back(255); // a - ignored
-
-        const Rgb rgbMiddle4 = HsvToRgb(hsvMiddle4);
-        bgraMiddle4PixelData->push_back(static_cast<::byte>(round(rgbMiddle4.b * 255))); // b
-        bgraMiddle4PixelData->push_back(static_cast<::byte>(round(rgbMiddle4.g * 255))); // g
-        bgraMiddle4PixelData->push_back(static_cast<::byte>(round(rgbMiddle4.r * 255))); // r
-        bgraMiddle4PixelData->push_back(255); // a - ignored
-    }
-
-    const Rgb rgbMax = HsvToRgb(hsvMax);
-    bgraMaxPixelData->push_back(static_cast<::byte>(round(rgbMax.b * 255))); // b
-    bgraMaxPixelData->push_back(static_cast<::byte>(round(rgbMax.g * 255))); // g
-    bgraMaxPixelData->push_back(static_cast<::byte>(round(rgbMax.r * 255))); // r
-    bgraMaxPixelData->push_back(255); // a - ignored
-}
-
-void ColorSpectrum::FillPixelForRing(
-    double x,
-    double y,
-    double radius,
-    const Hsv &baseHsv,
-    winrt::ColorSpectrumComponents components,
-    double minHue,
-    double maxHue,
-    double minSaturation,
-    double maxSaturation,
-    double minValue,
-    double maxValue,
-    shared_ptr<vector<::byte>> bgraMinPixelData,
-    shared_ptr<vector<::byte>> bgraMiddle1PixelData,
-    shared_ptr<vector<::byte>> bgraMiddle2PixelData,
-    shared_ptr<vector<::byte>> bgraMiddle3PixelData,
-    shared_ptr<vector<::byte>> bgraMiddle4PixelData,
-    shared_ptr<vector<::byte>> bgraMaxPixelData,
-    shared_ptr<vector<Hsv>> newHsvValues)
+void ColorSpectrum::UpdateBitmapsFromPlaneSet(double minDimension, std::shared_ptr<const ColorSpectrumPlaneSet> const& planeSet)
 {
-    const double hMin = minHue;
-    const double hMax = maxHue;
-    const double sMin = minSaturation / 100.0;
-    const double sMax = maxSaturation / 100.0;
-    const double vMin = minValue / 100.0;
-    const double vMax = maxValue / 100.0;
-
-    double distanceFromRadius = sqrt(pow(x - radius, 2) + pow(y - radius, 2));
-
-    double xToUse = x;
-    double yToUse = y;
-
-    // If we're outside the ring, then we want the pixel to appear as blank.
-    // However, to avoid issues with rounding errors, we'll act as though this point
-    // is on the edge of the ring for the purposes of returning an HSL value.
-    // That way, hittesting on the edges will always return the correct value.
-    if (distanceFromRadius > radius)
+    // The images only need to be recreated if the pixel data is not what they were created from.
+    if (planeSet != m_planeSetFromLastBitmapCreation)
     {
-        xToUse = (radius / distanceFromRadius) * (x - radius) + radius;
-        yToUse = (radius / distanceFromRadius) * (y - radius) + radius;
-        distanceFromRadius = radius;
-    }
-
-    Hsv hsvMin = baseHsv;
-    Hsv hsvMiddle1 = baseHsv;
-    Hsv hsvMiddle2 = baseHsv;
-    Hsv hsvMiddle3 = baseHsv;
-    Hsv hsvMiddle4 = baseHsv;
-    Hsv hsvMax = baseHsv;
-
-    const double r = 1 - distanceFromRadius / radius;
+        const int pixelWidth = planeSet->parameters.size;
+        const int pixelHeight = planeSet->parameters.size;
 
-    double theta = atan2((radius - yToUse), (radius - xToUse)) * 180.0 / M_PI;
-    theta += 180.0;
-    theta = floor(theta);
+        const auto components = static_cast<winrt::ColorSpectrumComponents>(planeSet->parameters.components);
 
-    while (theta > 360)
-    {
-        theta -= 360;
-    }
-
-    const double thetaPercent = theta / 360;
-
-    switch (components)
-    {
-    case winrt::ColorSpectrumComponents::HueValue:
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + thetaPercent * (hMax - hMin);
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + r * (vMax - vMin);
-        hsvMin.s = 0;
-        hsvMax.s = 1;
-        break;
-
-    case winrt::ColorSpectrumComponents::HueSaturation:
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + thetaPercent * (hMax - hMin);
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + r * (sMax - sMin);
-        hsvMin.v = 0;
-        hsvMax.v = 1;
-        break;
-
-    case winrt::ColorSpectrumComponents::ValueHue:
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + thetaPercent * (vMax - vMin);
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + r * (hMax - hMin);
-        hsvMin.s = 0;
-        hsvMax.s = 1;
-        break;
-
-    case winrt::ColorSpectrumComponents::ValueSaturation:
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + thetaPercent * (vMax - vMin);
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + r * (sMax - sMin);
-        hsvMin.h = 0;
-        hsvMiddle1.h = 60;
-        hsvMiddle2.h = 120;
-        hsvMiddle3.h = 180;
-        hsvMiddle4.h = 240;
-        hsvMax.h = 300;
-        break;
+        if (SharedHelpers::IsRS2OrHigher())
+        {
+            winrt::LoadedImageSurface minSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, planeSet->bgraMinPixelData);
+            winrt::LoadedImageSurface maxSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, planeSet->bgraMaxPixelData);
 
-    case winrt::ColorSpectrumComponents::SaturationHue:
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + thetaPercent * (sMax - sMin);
-        hsvMin.h = hsvMiddle1.h = hsvMiddle2.h = hsvMiddle3.h = hsvMiddle4.h = hsvMax.h = hMin + r * (hMax - hMin);
-        hsvMin.v = 0;
-        hsvMax.v = 1;
-        break;
+            switch (components)
+            {
+            case winrt::ColorSpectrumComponents::HueValue:
+            case winrt::ColorSpectrumComponents::ValueHue:
+                m_saturationMinimumSurface = minSurface;
+                m_saturationMaximumSurface = maxSurface;
+                break;
+            case winrt::ColorSpectrumComponents::HueSaturation:
+            case winrt::ColorSpectrumComponents::SaturationHue:
+                m_valueSurface = maxSurface;
+                break;
+            case winrt::ColorSpectrumComponents::ValueSaturation:
+            case winrt::ColorSpectrumComponents::SaturationValue:
+                m_hueRedSurface = minSurface;
+                m_hueYellowSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, planeSet->bgraMiddle1PixelData);
+                m_hueGreenSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, planeSet->bgraMiddle2PixelData);
+                m_hueCyanSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, planeSet->bgraMiddle3PixelData);
+                m_hueBlueSurface = CreateSurfaceFromPixelData(pixelWidth, pixelHeight, planeSet->bgraMiddle4PixelData);
+                m_huePurpleSurface = maxSurface;
+                break;
+            }
+        }
+        else
+        {
+            winrt::WriteableBitmap minBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, planeSet->bgraMinPixelData);
+            winrt::WriteableBitmap maxBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, planeSet->bgraMaxPixelData);
 
-    case winrt::ColorSpectrumComponents::SaturationValue:
-        hsvMin.s = hsvMiddle1.s = hsvMiddle2.s = hsvMiddle3.s = hsvMiddle4.s = hsvMax.s = sMin + thetaPercent * (sMax - sMin);
-        hsvMin.v = hsvMiddle1.v = hsvMiddle2.v = hsvMiddle3.v = hsvMiddle4.v = hsvMax.v = vMin + r * (vMax - vMin);
-        hsvMin.h = 0;
-        hsvMiddle1.h = 60;
-        hsvMiddle2.h = 120;
-        hsvMiddle3.h = 180;
-        hsvMiddle4.h = 240;
-        hsvMax.h = 300;
-        break;
-    }
+            switch (components)
+            {
+            case winrt::ColorSpectrumComponents::HueValue:
+            case winrt::ColorSpectrumComponents::ValueHue:
+                m_saturationMinimumBitmap = minBitmap;
+                m_saturationMaximumBitmap = maxBitmap;
+                break;
+            case winrt::ColorSpectrumComponents::HueSaturation:
+            case winrt::ColorSpectrumComponents::SaturationHue:
+                m_valueBitmap = maxBitmap;
+                break;
+            case winrt::ColorSpectrumComponents::ValueSaturation:
+            case winrt::ColorSpectrumComponents::SaturationValue:
+                m_hueRedBitmap = minBitmap;
+                m_hueYellowBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, planeSet->bgraMiddle1PixelData);
+                m_hueGreenBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, planeSet->bgraMiddle2PixelData);
+                m_hueCyanBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, planeSet->bgraMiddle3PixelData);
+                m_hueBlueBitmap = CreateBitmapFromPixelData(pixelWidth, pixelHeight, planeSet->bgraMiddle4PixelData);
+                m_huePurpleBitmap = maxBitmap;
+                break;
+            }
+        }
 
-    // If saturation is an axis in the spectrum with hue, or value is an axis, then we want
-    // that axis to go from maximum at the top to minimum at the bottom,
-    // or maximum at the outside to minimum at the inside in the case of the ring configuration,
-    // so we'll invert the number before assigning the HSL value to the array.
-    // Otherwise, we'll have a very narrow section in the middle that actually has meaningful hue
-    // in the case of the ring configuration.
-    if (components == winrt::ColorSpectrumComponents::HueSaturation ||
-        components == winrt::ColorSpectrumComponents::SaturationHue)
-    {
-        hsvMin.s = sMax - hsvMin.s + sMin;
-        hsvMiddle1.s = sMax - hsvMiddle1.s + sMin;
-        hsvMiddle2.s = sMax - hsvMiddle2.s + sMin;
-        hsvMiddle3.s = sMax - hsvMiddle3.s + sMin;
-        hsvMiddle4.s = sMax - hsvMiddle4.s + sMin;
-        hsvMax.s = sMax - hsvMax.s + sMin;
+        m_planeSetFromLastBitmapCreation = planeSet;
     }
-    else
-    {
-        hsvMin.v = vMax - hsvMin.v + vMin;
-        hsvMiddle1.v = vMax - hsvMiddle1.v + vMin;
-        hsvMiddle2.v = vMax - hsvMiddle2.v + vMin;
-        hsvMiddle3.v = vMax - hsvMiddle3.v + vMin;
-        hsvMiddle4.v = vMax - hsvMiddle4.v + vMin;
-        hsvMax.v = vMax - hsvMax.v + vMin;
-    }
-
-    newHsvValues->push_back(hsvMin);
 
-    const Rgb rgbMin = HsvToRgb(hsvMin);
-    bgraMinPixelData->push_back(static_cast<::byte>(round(rgbMin.b * 255))); // b
-    bgraMinPixelData->push_back(static_cast<::byte>(round(rgbMin.g * 255))); // g
-    bgraMinPixelData->push_back(static_cast<::byte>(round(rgbMin.r * 255))); // r
-    bgraMinPixelData->push_back(255); // a
+    m_shapeFromLastBitmapCreation = static_cast<winrt::ColorSpectrumShape>(planeSet->parameters.shape);
+    m_componentsFromLastBitmapCreation = static_cast<winrt::ColorSpectrumComponents>(planeSet->parameters.components);
+    m_imageWidthFromLastBitmapCreation = minDimension;
+    m_imageHeightFromLastBitmapCreation = minDimension;
+    m_minHueFromLastBitmapCreation = MinHue();
+    m_maxHueFromLastBitmapCreation = MaxHue();
+    m_minSaturationFromLastBitmapCreation = MinSaturation();
+    m_maxSaturationFromLastBitmapCreation = MaxSaturation();
+    m_minValueFromLastBitmapCreation = MinValue();
+    m_maxValueFromLastBitmapCreation = MaxValue();
 
-    // We'll only save pixel data for the middle bitmaps if our third dimension is hue.
-    if (components == winrt::ColorSpectrumComponents::ValueSaturation ||
-        components == winrt::ColorSpectrumComponents::SaturationValue)
-    {
-        const Rgb rgbMiddle1 = HsvToRgb(hsvMiddle1);
-        bgraMiddle1PixelData->push_back(static_cast<::byte>(round(rgbMiddle1.b * 255))); // b
-        bgraMiddle1PixelData->push_back(static_cast<::byte>(round(rgbMiddle1.g * 255))); // g
-        bgraMiddle1PixelData->push_back(static_cast<::byte>(round(rgbMiddle1.r * 255))); // r
-        bgraMiddle1PixelData->push_back(255); // a
-
-        const Rgb rgbMiddle2 = HsvToRgb(hsvMiddle2);
-        bgraMiddle2PixelData->push_back(static_cast<::byte>(round(rgbMiddle2.b * 255))); // b
-        bgraMiddle2PixelData->push_back(static_cast<::byte>(round(rgbMiddle2.g * 255))); // g
-        bgraMiddle2PixelData->push_back(static_cast<::byte>(round(rgbMiddle2.r * 255))); // r
-        bgraMiddle2PixelData->push_back(255); // a
-
-        const Rgb rgbMiddle3 = HsvToRgb(hsvMiddle3);
-        bgraMiddle3PixelData->push_back(static_cast<::byte>(round(rgbMiddle3.b * 255))); // b
-        bgraMiddle3PixelData->push_back(static_cast<::byte>(round(rgbMiddle3.g * 255))); // g
-        bgraMiddle3PixelData->push_back(static_cast<::byte>(round(rgbMiddle3.r * 255))); // r
-        bgraMiddle3PixelData->push_back(255); // a
-
-        const Rgb rgbMiddle4 = HsvToRgb(hsvMiddle4);
-        bgraMiddle4PixelData->push_back(static_cast<::byte>(round(rgbMiddle4.b * 255))); // b
-        bgraMiddle4PixelData->push_back(static_cast<::byte>(round(rgbMiddle4.g * 255))); // g
-        bgraMiddle4PixelData->push_back(static_cast<::byte>(round(rgbMiddle4.r * 255))); // r
-        bgraMiddle4PixelData->push_back(255); // a
-    }
-
-    const Rgb rgbMax = HsvToRgb(hsvMax);
-    bgraMaxPixelData->push_back(static_cast<::byte>(round(rgbMax.b * 255))); // b
-    bgraMaxPixelData->push_back(static_cast<::byte>(round(rgbMax.g * 255))); // g
-    bgraMaxPixelData->push_back(static_cast<::byte>(round(rgbMax.r * 255))); // r
-    bgraMaxPixelData->push_back(255); // a
+    UpdateBitmapSources();
+    UpdateEllipse();
 }
 
 void ColorSpectrum::UpdateBitmapSources()
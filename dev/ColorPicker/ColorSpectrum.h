@@ -5,6 +5,7 @@
 
 #include "ColorHelpers.h"
 #include "ColorChangedEventArgs.h"
+#include "ColorSpectrumPlaneCache.h"
 #include "DispatcherHelper.h"
 
 #include "ColorSpectrum.g.h"
@@ -66,56 +67,16 @@ private:
     void UpdateEllipse();
 
     void CreateBitmapsAndColorMap();
+    void UpdateBitmapsFromPlaneSet(double minDimension, std::shared_ptr<const ColorSpectrumPlaneSet> const& planeSet);
     void UpdateBitmapSources();
 
     bool SelectionEllipseShouldBeLight();
 
-    // Helpers used by CreateBitmapsAndColorMap() to fill pixel data and create bitmaps from that data.
-    static void FillPixelForBox(
-        double x,
-        double y,
-        const Hsv &baseHsv,
-        double minDimension,
-        winrt::ColorSpectrumComponents components,
-        double minHue,
-        double maxHue,
-        double minSaturation,
-        double maxSaturation,
-        double minValue,
-        double maxValue,
-        std::shared_ptr<std::vector<byte>> bgraMinPixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle1PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle2PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle3PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle4PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMaxPixelData,
-        std::shared_ptr<std::vector<Hsv>> newHsvValues);
-    static void FillPixelForRing(
-        double x,
-        double y,
-        double radius,
-        const Hsv &baseHsv,
-        winrt::ColorSpectrumComponents components,
-        double minHue,
-        double maxHue,
-        double minSaturation,
-        double maxSaturation,
-        double minValue,
-        double maxValue,
-        std::shared_ptr<std::vector<byte>> bgraMinPixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle1PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle2PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle3PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMiddle4PixelData,
-        std::shared_ptr<std::vector<byte>> bgraMaxPixelData,
-        std::shared_ptr<std::vector<Hsv>> newHsvValues);
-
     bool m_updatingColor;
     bool m_updatingHsvColor;
     bool m_isPointerOver;
     bool m_isPointerPressed;
     bool m_shouldShowLargeSelection;
-    std::vector<Hsv> m_hsvValues;
 
     // XAML elements
     tracker_ref<winrt::Grid> m_layoutRoot{ this };
@@ -176,6 +137,11 @@ private:
     int m_minValueFromLastBitmapCreation{ 0 };
     int m_maxValueFromLastBitmapCreation{ 0 };
 
+    // The pixel data the current bitmaps were created from, which can be shared with other
+    // ColorSpectrum instances through ColorSpectrumPlaneCache. Its parameters are also
+    // what we use to compute the color under the pointer.
+    std::shared_ptr<const ColorSpectrumPlaneSet> m_planeSetFromLastBitmapCreation;
+
     winrt::Color m_oldColor{ 255, 255, 255, 255 };
     winrt::float4 m_oldHsvColor{ 0.0, 0.0, 1.0, 1.0 };
 
@@ -0,0 +1,128 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "pch.h"
+#include "common.h"
+#include "ColorSpectrumPlaneCache.h"
+
+size_t ColorSpectrumPlaneSet::SizeInBytes() const
+{
+    size_t sizeInBytes = 0;
+
+    for (auto const& pixelData : { bgraMinPixelData, bgraMiddle1PixelData, bgraMiddle2PixelData, bgraMiddle3PixelData, bgraMiddle4PixelData, bgraMaxPixelData })
+    {
+        if (pixelData)
+        {
+            sizeInBytes += pixelData->size();
+        }
+    }
+
+    return sizeInBytes;
+}
+
+ColorSpectrumPlaneCache& ColorSpectrumPlaneCache::Instance()
+{
+    static ColorSpectrumPlaneCache s_instance;
+    return s_instance;
+}
+
+ColorSpectrumPlaneCache::ColorSpectrumPlaneCache()
+{
+    // The cache lives as long as the process, so the handler is never removed.
+    // MemoryManager is not available to every app, in which case the byte budget is the only bound.
+    try
+    {
+        winrt::MemoryManager::AppMemoryUsageIncreased([](auto const&, auto const&)
+            {
+                const auto level = winrt::MemoryManager::AppMemoryUsageLevel();
+                if (level == winrt::AppMemoryUsageLevel::High || level == winrt::AppMemoryUsageLevel::OverLimit)
+                {
+                    Instance().Clear();
+                }
+            });
+    }
+    catch (winrt::hresult_error const&)
+    {
+    }
+}
+
+std::shared_ptr<const ColorSpectrumPlaneSet> ColorSpectrumPlaneCache::Find(const ColorSpectrumRenderer::SpectrumParameters& parameters)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if ((*it)->parameters == parameters)
+        {
+            // Move the entry to the front of the list since it is now the most recently used.
+            m_entries.splice(m_entries.begin(), m_entries, it);
+            return m_entries.front();
+        }
+    }
+
+    return nullptr;
+}
+
+std::shared_ptr<const ColorSpectrumPlaneSet> ColorSpectrumPlaneCache::FindResamplingSource(const ColorSpectrumRenderer::SpectrumParameters& parameters)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::shared_ptr<const ColorSpectrumPlaneSet> source;
+
+    for (auto const& entry : m_entries)
+    {
+        auto entryParameters = entry->parameters;
+        entryParameters.size = parameters.size;
+
+        if (entry->parameters.size > parameters.size &&
+            entryParameters == parameters &&
+            (!source || entry->parameters.size < source->parameters.size))
+        {
+            source = entry;
+        }
+    }
+
+    return source;
+}
+
+void ColorSpectrumPlaneCache::Add(std::shared_ptr<const ColorSpectrumPlaneSet> const& planeSet)
+{
+    if (planeSet->isResampled)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if ((*it)->parameters == planeSet->parameters)
+        {
+            m_sizeInBytes -= (*it)->SizeInBytes();
+            m_entries.erase(it);
+            break;
+        }
+    }
+
+    m_entries.push_front(planeSet);
+    m_sizeInBytes += planeSet->SizeInBytes();
+
+    while (m_sizeInBytes > s_maxSizeInBytes && m_entries.size() > 1)
+    {
+        m_sizeInBytes -= m_entries.back()->SizeInBytes();
+        m_entries.pop_back();
+    }
+}
+
+void ColorSpectrumPlaneCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_sizeInBytes = 0;
+}
+
+size_t ColorSpectrumPlaneCache::EntryCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
@@ -0,0 +1,63 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include "ColorSpectrumRenderer.h"
+
+// The pixel data generated for one ColorSpectrum configuration.
+struct ColorSpectrumPlaneSet
+{
+    ColorSpectrumRenderer::SpectrumParameters parameters{};
+
+    // Resampled planes only approximate what rendering these parameters produces,
+    // so they are never added to the cache.
+    bool isResampled{ false };
+
+    // The middle planes are only populated when hue is the third dimension.
+    std::shared_ptr<std::vector<::byte>> bgraMinPixelData;
+    std::shared_ptr<std::vector<::byte>> bgraMiddle1PixelData;
+    std::shared_ptr<std::vector<::byte>> bgraMiddle2PixelData;
+    std::shared_ptr<std::vector<::byte>> bgraMiddle3PixelData;
+    std::shared_ptr<std::vector<::byte>> bgraMiddle4PixelData;
+    std::shared_ptr<std::vector<::byte>> bgraMaxPixelData;
+
+    size_t SizeInBytes() const;
+};
+
+// Least recently used cache of the plane sets generated by ColorSpectrum, shared by every instance
+// so that reopening a picker, or showing several pickers with the same configuration, does not
+// regenerate the same pixels. Plane sets are immutable once added to the cache. They stay cached
+// until they are evicted to stay within the byte budget, or until the app runs low on memory.
+class ColorSpectrumPlaneCache final
+{
+public:
+    static ColorSpectrumPlaneCache& Instance();
+
+    // Returns the plane set generated for exactly these parameters, if any.
+    std::shared_ptr<const ColorSpectrumPlaneSet> Find(const ColorSpectrumRenderer::SpectrumParameters& parameters);
+
+    // Returns the smallest plane set generated for the same configuration at a larger size, if any,
+    // from which planes for these parameters can be resampled instead of being rendered.
+    std::shared_ptr<const ColorSpectrumPlaneSet> FindResamplingSource(const ColorSpectrumRenderer::SpectrumParameters& parameters);
+
+    void Add(std::shared_ptr<const ColorSpectrumPlaneSet> const& planeSet);
+
+    void Clear();
+
+    size_t EntryCount();
+
+private:
+    ColorSpectrumPlaneCache();
+
+    // The most recently used entry is always kept, even if it is larger than the budget.
+    static constexpr size_t s_maxSizeInBytes = 96 * 1024 * 1024;
+
+    std::mutex m_mutex;
+    // Ordered from the most to the least recently used.
+    std::list<std::shared_ptr<const ColorSpectrumPlaneSet>> m_entries;
+    size_t m_sizeInBytes{ 0 };
+};
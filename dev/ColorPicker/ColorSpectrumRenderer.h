@@ -0,0 +1,760 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Generates the BGRA planes displayed by ColorSpectrum, and maps pixels back to the HSV
+// values they display for hit-testing.
+//
+// Pixels are produced one row at a time straight into preallocated planes. For every row we
+// first compute the two spectrum axes of each pixel (a scalar pass, since the ring shape needs
+// atan2), and then convert HSV to BGRA for all the planes using SIMD lanes when available:
+// AVX (4 doubles) or SSE2 (2 doubles) on x86/x64, with a scalar fallback everywhere else.
+// All lanes perform the exact same double operations as the scalar HsvToRgb conversion, so
+// every path produces identical bytes.
+//
+// Rows are split into tiles. The calling thread renders tiles itself and can hand out helper
+// work items to the caller's thread pool, which pull the remaining tiles from the same queue.
+// Cancellation is checked once per tile.
+
+#if defined(_MSC_VER) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define COLORSPECTRUMRENDERER_SSE2
+#define COLORSPECTRUMRENDERER_AVX
+#define COLORSPECTRUMRENDERER_AVX_RUNTIME_CHECK
+#include <intrin.h>
+#include <immintrin.h>
+#elif defined(__AVX__)
+#define COLORSPECTRUMRENDERER_SSE2
+#define COLORSPECTRUMRENDERER_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#define COLORSPECTRUMRENDERER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace ColorSpectrumRenderer
+{
+    // Mirrors winrt::ColorSpectrumShape.
+    enum class SpectrumShape
+    {
+        Box = 0,
+        Ring = 1,
+    };
+
+    // Mirrors winrt::ColorSpectrumComponents.
+    enum class SpectrumComponents
+    {
+        HueValue = 0,
+        ValueHue = 1,
+        HueSaturation = 2,
+        SaturationHue = 3,
+        SaturationValue = 4,
+        ValueSaturation = 5,
+    };
+
+    enum class SimdLevel
+    {
+        Scalar,
+        Sse2,
+        Avx,
+    };
+
+    struct SpectrumParameters
+    {
+        int size{};
+        SpectrumShape shape{ SpectrumShape::Box };
+        SpectrumComponents components{ SpectrumComponents::HueValue };
+        // Hue is in degrees, saturation and value in percents, as exposed by the ColorSpectrum properties.
+        double minHue{};
+        double maxHue{};
+        double minSaturation{};
+        double maxSaturation{};
+        double minValue{};
+        double maxValue{};
+
+        bool operator==(const SpectrumParameters& other) const
+        {
+            return size == other.size &&
+                shape == other.shape &&
+                components == other.components &&
+                minHue == other.minHue &&
+                maxHue == other.maxHue &&
+                minSaturation == other.minSaturation &&
+                maxSaturation == other.maxSaturation &&
+                minValue == other.minValue &&
+                maxValue == other.maxValue;
+        }
+
+        bool operator!=(const SpectrumParameters& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    // Each plane is size * size * 4 bytes. The middle planes are only used when hue is the
+    // third dimension (see ThirdDimensionIsHue) and can otherwise be null.
+    struct SpectrumPlanes
+    {
+        uint8_t* min{};
+        uint8_t* middle1{};
+        uint8_t* middle2{};
+        uint8_t* middle3{};
+        uint8_t* middle4{};
+        uint8_t* max{};
+    };
+
+    inline bool ThirdDimensionIsHue(SpectrumComponents components)
+    {
+        return components == SpectrumComponents::ValueSaturation ||
+            components == SpectrumComponents::SaturationValue;
+    }
+
+    inline int PlaneCount(SpectrumComponents components)
+    {
+        return ThirdDimensionIsHue(components) ? 6 : 2;
+    }
+
+    namespace details
+    {
+        enum Channel
+        {
+            Hue = 0,
+            Saturation = 1,
+            Value = 2,
+        };
+
+        // Describes which HSV channel each axis of the spectrum drives, which channel is
+        // the third dimension, and the value of the third dimension in each plane.
+        struct ChannelLayout
+        {
+            int primaryChannel;     // Driven by yPercent (box) or the angle (ring).
+            int secondaryChannel;   // Driven by xPercent (box) or the distance to the center (ring).
+            int thirdChannel;
+            int invertedChannel;    // Axis inverted so that it goes from max to min.
+            double lowerBounds[3];
+            double upperBounds[3];
+            double thirdValues[6];
+        };
+
+        inline ChannelLayout GetChannelLayout(const SpectrumParameters& parameters)
+        {
+            ChannelLayout layout{};
+
+            switch (parameters.components)
+            {
+            case SpectrumComponents::HueValue:
+                layout.primaryChannel = Hue; layout.secondaryChannel = Value; layout.thirdChannel = Saturation;
+                break;
+            case SpectrumComponents::HueSaturation:
+                layout.primaryChannel = Hue; layout.secondaryChannel = Saturation; layout.thirdChannel = Value;
+                break;
+            case SpectrumComponents::ValueHue:
+                layout.primaryChannel = Value; layout.secondaryChannel = Hue; layout.thirdChannel = Saturation;
+                break;
+            case SpectrumComponents::ValueSaturation:
+                layout.primaryChannel = Value; layout.secondaryChannel = Saturation; layout.thirdChannel = Hue;
+                break;
+            case SpectrumComponents::SaturationHue:
+                layout.primaryChannel = Saturation; layout.secondaryChannel = Hue; layout.thirdChannel = Value;
+                break;
+            case SpectrumComponents::SaturationValue:
+                layout.primaryChannel = Saturation; layout.secondaryChannel = Value; layout.thirdChannel = Hue;
+                break;
+            }
+
+            // If saturation is an axis in the spectrum with hue, or value is an axis, then we want
+            // that axis to go from maximum at the top to minimum at the bottom,
+            // or maximum at the outside to minimum at the inside in the case of the ring configuration.
+            layout.invertedChannel =
+                (parameters.components == SpectrumComponents::HueSaturation ||
+                 parameters.components == SpectrumComponents::SaturationHue) ? Saturation : Value;
+
+            layout.lowerBounds[Hue] = parameters.minHue;
+            layout.upperBounds[Hue] = parameters.maxHue;
+            layout.lowerBounds[Saturation] = parameters.minSaturation / 100.0;
+            layout.upperBounds[Saturation] = parameters.maxSaturation / 100.0;
+            layout.lowerBounds[Value] = parameters.minValue / 100.0;
+            layout.upperBounds[Value] = parameters.maxValue / 100.0;
+
+            if (layout.thirdChannel == Hue)
+            {
+                // Red, yellow, green, cyan, blue and purple.
+                for (int plane = 0; plane < 6; plane++)
+                {
+                    layout.thirdValues[plane] = plane * 60.0;
+                }
+            }
+            else
+            {
+                layout.thirdValues[0] = 0.0;
+                layout.thirdValues[1] = 1.0;
+            }
+
+            return layout;
+        }
+
+        // Computes the two axes percentages of the pixel at (row, column).
+        inline void ComputePixelAxes(
+            const SpectrumParameters& parameters,
+            int row,
+            int column,
+            double& primaryPercent,
+            double& secondaryPercent)
+        {
+            const int size = parameters.size;
+            const double minDimension = size;
+
+            if (parameters.shape == SpectrumShape::Box)
+            {
+                // The box spectrum is stored column-major, starting from the bottom-right corner:
+                // the pixel at (row, column) of the plane corresponds to x = size - 1 - row and y = size - 1 - column.
+                const double x = size - 1 - row;
+                const double y = size - 1 - column;
+                primaryPercent = (minDimension - 1 - y) / (minDimension - 1);
+                secondaryPercent = (minDimension - 1 - x) / (minDimension - 1);
+            }
+            else
+            {
+                constexpr double pi = 3.14159265358979323846;
+                const double radius = size / 2.0;
+                const double x = column;
+                const double y = row;
+                double distanceFromRadius = std::sqrt(std::pow(x - radius, 2) + std::pow(y - radius, 2));
+
+                double xToUse = x;
+                double yToUse = y;
+
+                // If we're outside the ring, then we want the pixel to appear as blank.
+                // However, to avoid issues with rounding errors, we'll act as though this point
+                // is on the edge of the ring for the purposes of returning an HSL value.
+                // That way, hittesting on the edges will always return the correct value.
+                if (distanceFromRadius > radius)
+                {
+                    xToUse = (radius / distanceFromRadius) * (x - radius) + radius;
+                    yToUse = (radius / distanceFromRadius) * (y - radius) + radius;
+                    distanceFromRadius = radius;
+                }
+
+                double theta = std::atan2((radius - yToUse), (radius - xToUse)) * 180.0 / pi;
+                theta += 180.0;
+                theta = std::floor(theta);
+
+                while (theta > 360)
+                {
+                    theta -= 360;
+                }
+
+                primaryPercent = theta / 360;
+                secondaryPercent = 1 - distanceFromRadius / radius;
+            }
+        }
+
+        // Fills the two axes percentages of every pixel in a row.
+        inline void ComputeRowAxes(
+            const SpectrumParameters& parameters,
+            int row,
+            double* primaryPercents,
+            double* secondaryPercents)
+        {
+            for (int column = 0; column < parameters.size; column++)
+            {
+                ComputePixelAxes(parameters, row, column, primaryPercents[column], secondaryPercents[column]);
+            }
+        }
+
+        struct ScalarLanes
+        {
+            static constexpr int Width = 1;
+            using Vector = double;
+            using Mask = bool;
+
+            static Vector Load(const double* source) { return *source; }
+            static void Store(double* destination, Vector value) { *destination = value; }
+            static Vector Set(double value) { return value; }
+            static Vector Add(Vector a, Vector b) { return a + b; }
+            static Vector Sub(Vector a, Vector b) { return a - b; }
+            static Vector Mul(Vector a, Vector b) { return a * b; }
+            static Vector Div(Vector a, Vector b) { return a / b; }
+            static Mask GreaterOrEqual(Vector a, Vector b) { return a >= b; }
+            static Mask Less(Vector a, Vector b) { return a < b; }
+            static Mask Equal(Vector a, Vector b) { return a == b; }
+            static Vector Select(Mask mask, Vector whenTrue, Vector whenFalse) { return mask ? whenTrue : whenFalse; }
+            static Vector Truncate(Vector value) { return static_cast<double>(static_cast<int>(value)); }
+        };
+
+#ifdef COLORSPECTRUMRENDERER_SSE2
+        struct Sse2Lanes
+        {
+            static constexpr int Width = 2;
+            using Vector = __m128d;
+            using Mask = __m128d;
+
+            static Vector Load(const double* source) { return _mm_loadu_pd(source); }
+            static void Store(double* destination, Vector value) { _mm_storeu_pd(destination, value); }
+            static Vector Set(double value) { return _mm_set1_pd(value); }
+            static Vector Add(Vector a, Vector b) { return _mm_add_pd(a, b); }
+            static Vector Sub(Vector a, Vector b) { return _mm_sub_pd(a, b); }
+            static Vector Mul(Vector a, Vector b) { return _mm_mul_pd(a, b); }
+            static Vector Div(Vector a, Vector b) { return _mm_div_pd(a, b); }
+            static Mask GreaterOrEqual(Vector a, Vector b) { return _mm_cmpge_pd(a, b); }
+            static Mask Less(Vector a, Vector b) { return _mm_cmplt_pd(a, b); }
+            static Mask Equal(Vector a, Vector b) { return _mm_cmpeq_pd(a, b); }
+            static Vector Select(Mask mask, Vector whenTrue, Vector whenFalse) { return _mm_or_pd(_mm_and_pd(mask, whenTrue), _mm_andnot_pd(mask, whenFalse)); }
+            static Vector Truncate(Vector value) { return _mm_cvtepi32_pd(_mm_cvttpd_epi32(value)); }
+        };
+#endif
+
+#ifdef COLORSPECTRUMRENDERER_AVX
+        struct AvxLanes
+        {
+            static constexpr int Width = 4;
+            using Vector = __m256d;
+            using Mask = __m256d;
+
+            static Vector Load(const double* source) { return _mm256_loadu_pd(source); }
+            static void Store(double* destination, Vector value) { _mm256_storeu_pd(destination, value); }
+            static Vector Set(double value) { return _mm256_set1_pd(value); }
+            static Vector Add(Vector a, Vector b) { return _mm256_add_pd(a, b); }
+            static Vector Sub(Vector a, Vector b) { return _mm256_sub_pd(a, b); }
+            static Vector Mul(Vector a, Vector b) { return _mm256_mul_pd(a, b); }
+            static Vector Div(Vector a, Vector b) { return _mm256_div_pd(a, b); }
+            static Mask GreaterOrEqual(Vector a, Vector b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+            static Mask Less(Vector a, Vector b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+            static Mask Equal(Vector a, Vector b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+            static Vector Select(Mask mask, Vector whenTrue, Vector whenFalse) { return _mm256_blendv_pd(whenFalse, whenTrue, mask); }
+            static Vector Truncate(Vector value) { return _mm256_cvtepi32_pd(_mm256_cvttpd_epi32(value)); }
+        };
+#endif
+
+        // Same operations, in the same order, as HsvToRgb followed by round(channel * 255).
+        template <typename Lanes>
+        inline void HsvToBgraScaled(
+            typename Lanes::Vector hue,
+            typename Lanes::Vector saturation,
+            typename Lanes::Vector value,
+            typename Lanes::Vector& b,
+            typename Lanes::Vector& g,
+            typename Lanes::Vector& r)
+        {
+            using L = Lanes;
+            const auto zero = L::Set(0.0);
+            const auto one = L::Set(1.0);
+            const auto full = L::Set(360.0);
+            const auto sixty = L::Set(60.0);
+
+            // We want the hue to be between 0 and 359. Values handed out by the spectrum are
+            // at most one turn away from that range, so a single correction suffices.
+            hue = L::Select(L::GreaterOrEqual(hue, full), L::Sub(hue, full), hue);
+            hue = L::Select(L::Less(hue, zero), L::Add(hue, full), hue);
+
+            saturation = L::Select(L::Less(saturation, zero), zero, saturation);
+            saturation = L::Select(L::Less(one, saturation), one, saturation);
+            value = L::Select(L::Less(value, zero), zero, value);
+            value = L::Select(L::Less(one, value), one, value);
+
+            const auto chroma = L::Mul(saturation, value);
+            const auto min = L::Sub(value, chroma);
+            const auto hueSextant = L::Div(hue, sixty);
+            const auto sextant = L::Truncate(hueSextant);
+            const auto intermediateColorPercentage = L::Sub(hueSextant, sextant);
+            const auto max = L::Add(chroma, min);
+            const auto rising = L::Add(min, L::Mul(chroma, intermediateColorPercentage));
+            const auto falling = L::Add(min, L::Mul(chroma, L::Sub(one, intermediateColorPercentage)));
+
+            const auto isSextant0 = L::Equal(sextant, zero);
+            const auto isSextant1 = L::Equal(sextant, one);
+            const auto isSextant2 = L::Equal(sextant, L::Set(2.0));
+            const auto isSextant3 = L::Equal(sextant, L::Set(3.0));
+            const auto isSextant4 = L::Equal(sextant, L::Set(4.0));
+
+            //             0        1        2        3        4        5
+            // r:        max  falling      min      min   rising      max
+            // g:     rising      max      max  falling      min      min
+            // b:        min      min   rising      max      max  falling
+            auto red = L::Select(isSextant0, max, L::Select(isSextant1, falling, L::Select(isSextant2, min, L::Select(isSextant3, min, L::Select(isSextant4, rising, max)))));
+            auto green = L::Select(isSextant0, rising, L::Select(isSextant1, max, L::Select(isSextant2, max, L::Select(isSextant3, falling, min))));
+            auto blue = L::Select(isSextant0, min, L::Select(isSextant1, min, L::Select(isSextant2, rising, L::Select(isSextant3, max, L::Select(isSextant4, max, falling)))));
+
+            // The chroma == 0 case of HsvToRgb returns min for all channels, which is what the
+            // formulas above already evaluate to.
+
+            // round() rounds half away from zero, and all values here are positive.
+            const auto half = L::Set(0.5);
+            const auto scale = L::Set(255.0);
+            const auto roundScaled = [&](typename L::Vector channel)
+            {
+                const auto scaled = L::Mul(channel, scale);
+                const auto truncated = L::Truncate(scaled);
+                return L::Select(L::GreaterOrEqual(L::Sub(scaled, truncated), half), L::Add(truncated, one), truncated);
+            };
+
+            r = roundScaled(red);
+            g = roundScaled(green);
+            b = roundScaled(blue);
+        }
+
+        template <typename Lanes>
+        inline void RenderRow(
+            const SpectrumParameters& parameters,
+            const ChannelLayout& layout,
+            const SpectrumPlanes& planes,
+            int row,
+            const double* primaryPercents,
+            const double* secondaryPercents)
+        {
+            using L = Lanes;
+            const int size = parameters.size;
+            const int planeCount = PlaneCount(parameters.components);
+            uint8_t* const planeRows[6] =
+            {
+                planes.min,
+                planeCount == 6 ? planes.middle1 : nullptr,
+                planeCount == 6 ? planes.middle2 : nullptr,
+                planeCount == 6 ? planes.middle3 : nullptr,
+                planeCount == 6 ? planes.middle4 : nullptr,
+                planes.max,
+            };
+            const size_t rowOffset = static_cast<size_t>(row) * size;
+
+            const auto primaryLower = L::Set(layout.lowerBounds[layout.primaryChannel]);
+            const auto primaryRange = L::Sub(L::Set(layout.upperBounds[layout.primaryChannel]), primaryLower);
+            const auto secondaryLower = L::Set(layout.lowerBounds[layout.secondaryChannel]);
+            const auto secondaryRange = L::Sub(L::Set(layout.upperBounds[layout.secondaryChannel]), secondaryLower);
+            const auto invertedLower = L::Set(layout.lowerBounds[layout.invertedChannel]);
+            const auto invertedUpper = L::Set(layout.upperBounds[layout.invertedChannel]);
+
+            alignas(32) double bgr[3][L::Width];
+
+            int column = 0;
+            const auto renderLanes = [&](int laneCount, typename L::Vector primary, typename L::Vector secondary)
+            {
+                typename L::Vector channels[3];
+                channels[layout.primaryChannel] = L::Add(primaryLower, L::Mul(primary, primaryRange));
+                channels[layout.secondaryChannel] = L::Add(secondaryLower, L::Mul(secondary, secondaryRange));
+
+                for (int plane = 0; plane < 6; plane++)
+                {
+                    uint8_t* planeData = planeRows[plane];
+                    if (!planeData)
+                    {
+                        continue;
+                    }
+
+                    const int thirdIndex = plane == 5 ? planeCount - 1 : plane;
+                    channels[layout.thirdChannel] = L::Set(layout.thirdValues[thirdIndex]);
+
+                    // The third dimension is never the inverted channel, so inverting here
+                    // matches inverting all the planes' HSV values.
+                    typename L::Vector hsv[3] = { channels[0], channels[1], channels[2] };
+                    hsv[layout.invertedChannel] = L::Add(L::Sub(invertedUpper, hsv[layout.invertedChannel]), invertedLower);
+
+                    typename L::Vector b, g, r;
+                    HsvToBgraScaled<L>(hsv[0], hsv[1], hsv[2], b, g, r);
+                    L::Store(bgr[0], b);
+                    L::Store(bgr[1], g);
+                    L::Store(bgr[2], r);
+
+                    uint8_t* pixel = planeData + (rowOffset + column) * 4;
+                    for (int lane = 0; lane < laneCount; lane++)
+                    {
+                        pixel[0] = static_cast<uint8_t>(bgr[0][lane]);
+                        pixel[1] = static_cast<uint8_t>(bgr[1][lane]);
+                        pixel[2] = static_cast<uint8_t>(bgr[2][lane]);
+                        pixel[3] = 255;
+                        pixel += 4;
+                    }
+                }
+            };
+
+            for (; column + L::Width <= size; column += L::Width)
+            {
+                renderLanes(L::Width, L::Load(primaryPercents + column), L::Load(secondaryPercents + column));
+            }
+
+            if (column < size)
+            {
+                // Pad the remaining pixels of the row so that we can still use full lanes.
+                alignas(32) double primaryTail[L::Width] = {};
+                alignas(32) double secondaryTail[L::Width] = {};
+                const int laneCount = size - column;
+                std::copy(primaryPercents + column, primaryPercents + size, primaryTail);
+                std::copy(secondaryPercents + column, secondaryPercents + size, secondaryTail);
+                renderLanes(laneCount, L::Load(primaryTail), L::Load(secondaryTail));
+            }
+        }
+    }
+
+    inline SimdLevel GetSupportedSimdLevel()
+    {
+#if defined(COLORSPECTRUMRENDERER_AVX_RUNTIME_CHECK)
+        static const SimdLevel s_level = []()
+        {
+            int cpuInfo[4]{};
+            __cpuid(cpuInfo, 1);
+            const bool osUsesXSave = (cpuInfo[2] & (1 << 27)) != 0;
+            const bool cpuSupportsAvx = (cpuInfo[2] & (1 << 28)) != 0;
+            if (osUsesXSave && cpuSupportsAvx && (_xgetbv(0) & 0x6) == 0x6)
+            {
+                return SimdLevel::Avx;
+            }
+            return SimdLevel::Sse2;
+        }();
+        return s_level;
+#elif defined(COLORSPECTRUMRENDERER_AVX)
+        return SimdLevel::Avx;
+#elif defined(COLORSPECTRUMRENDERER_SSE2)
+        return SimdLevel::Sse2;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    // Renders rows [rowBegin, rowEnd).
+    inline void RenderRows(
+        const SpectrumParameters& parameters,
+        const SpectrumPlanes& planes,
+        int rowBegin,
+        int rowEnd,
+        SimdLevel simdLevel,
+        std::vector<double>& primaryPercents,
+        std::vector<double>& secondaryPercents)
+    {
+        const details::ChannelLayout layout = details::GetChannelLayout(parameters);
+        primaryPercents.resize(parameters.size);
+        secondaryPercents.resize(parameters.size);
+
+        for (int row = rowBegin; row < rowEnd; row++)
+        {
+            details::ComputeRowAxes(parameters, row, primaryPercents.data(), secondaryPercents.data());
+
+            switch (simdLevel)
+            {
+#ifdef COLORSPECTRUMRENDERER_AVX
+            case SimdLevel::Avx:
+                details::RenderRow<details::AvxLanes>(parameters, layout, planes, row, primaryPercents.data(), secondaryPercents.data());
+                break;
+#endif
+#ifdef COLORSPECTRUMRENDERER_SSE2
+            case SimdLevel::Sse2:
+                details::RenderRow<details::Sse2Lanes>(parameters, layout, planes, row, primaryPercents.data(), secondaryPercents.data());
+                break;
+#endif
+            default:
+                details::RenderRow<details::ScalarLanes>(parameters, layout, planes, row, primaryPercents.data(), secondaryPercents.data());
+                break;
+            }
+        }
+    }
+
+    namespace details
+    {
+        // The tiles of one render, shared by the calling thread and its helpers. Helpers can start
+        // after the render is over, so they only ever reach the planes through tiles they claimed.
+        struct TileQueue
+        {
+            SpectrumParameters parameters{};
+            SpectrumPlanes planes{};
+            std::function<bool()> isCanceled;
+            SimdLevel simdLevel{ SimdLevel::Scalar };
+            int tileCount{ 0 };
+
+            std::atomic<int> nextTile{ 0 };
+            std::atomic<bool> canceled{ false };
+
+            std::mutex mutex;
+            std::condition_variable tilesDone;
+            int remainingTiles{ 0 };
+        };
+
+        constexpr int c_tileRowCount = 16;
+
+        inline void RenderTiles(TileQueue& queue)
+        {
+            std::vector<double> primaryPercents;
+            std::vector<double> secondaryPercents;
+
+            for (int tile = queue.nextTile++; tile < queue.tileCount; tile = queue.nextTile++)
+            {
+                // Canceled tiles still have to be accounted for so that the render can return.
+                if (!queue.canceled && queue.isCanceled && queue.isCanceled())
+                {
+                    queue.canceled = true;
+                }
+
+                if (!queue.canceled)
+                {
+                    const int rowBegin = tile * c_tileRowCount;
+                    const int rowEnd = std::min(queue.parameters.size, rowBegin + c_tileRowCount);
+                    RenderRows(queue.parameters, queue.planes, rowBegin, rowEnd, queue.simdLevel, primaryPercents, secondaryPercents);
+                }
+
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (--queue.remainingTiles == 0)
+                {
+                    queue.tilesDone.notify_all();
+                }
+            }
+        }
+    }
+
+    // Queues a function on another thread, e.g. as a thread pool work item.
+    using QueueWorkFunction = std::function<void(std::function<void()> const&)>;
+
+    // Renders the whole spectrum on the calling thread, with the help of up to helperCount work items
+    // queued through queueWork (by default one per additional hardware thread). isCanceled is polled
+    // before each tile; returns false if rendering was canceled before completion. Returns once every
+    // tile is done, whether or not the helpers got to run.
+    inline bool Render(
+        const SpectrumParameters& parameters,
+        const SpectrumPlanes& planes,
+        const std::function<bool()>& isCanceled,
+        const QueueWorkFunction& queueWork = nullptr,
+        int helperCount = -1,
+        SimdLevel simdLevel = GetSupportedSimdLevel())
+    {
+        const int size = parameters.size;
+        if (size <= 0)
+        {
+            return true;
+        }
+
+        auto queue = std::make_shared<details::TileQueue>();
+        queue->parameters = parameters;
+        queue->planes = planes;
+        queue->isCanceled = isCanceled;
+        queue->simdLevel = simdLevel;
+        queue->tileCount = (size + details::c_tileRowCount - 1) / details::c_tileRowCount;
+        queue->remainingTiles = queue->tileCount;
+
+        if (!queueWork)
+        {
+            helperCount = 0;
+        }
+        else if (helperCount < 0)
+        {
+            helperCount = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+        }
+        helperCount = std::max(0, std::min(helperCount, queue->tileCount - 1));
+
+        for (int helper = 0; helper < helperCount; helper++)
+        {
+            queueWork([queue]() { details::RenderTiles(*queue); });
+        }
+
+        // The calling thread takes its share of the tiles too, and then waits for the tiles
+        // that helpers are still rendering.
+        details::RenderTiles(*queue);
+
+        std::unique_lock<std::mutex> lock(queue->mutex);
+        queue->tilesDone.wait(lock, [&queue]() { return queue->remainingTiles == 0; });
+
+        return !queue->canceled;
+    }
+
+    // Returns the HSV value displayed at (row, column) by the minimum plane, which is what
+    // hit-testing needs, without having to keep a map of every pixel around. This performs the
+    // same operations as the renderer, so the result matches the rendered pixel exactly.
+    template <typename THsv>
+    THsv GetHsvAt(const SpectrumParameters& parameters, int row, int column)
+    {
+        const details::ChannelLayout layout = details::GetChannelLayout(parameters);
+
+        double primaryPercent = 0.0;
+        double secondaryPercent = 0.0;
+        details::ComputePixelAxes(parameters, row, column, primaryPercent, secondaryPercent);
+
+        const int primaryChannel = layout.primaryChannel;
+        const int secondaryChannel = layout.secondaryChannel;
+        const int invertedChannel = layout.invertedChannel;
+
+        double channels[3]{};
+        channels[primaryChannel] =
+            layout.lowerBounds[primaryChannel] + primaryPercent * (layout.upperBounds[primaryChannel] - layout.lowerBounds[primaryChannel]);
+        channels[secondaryChannel] =
+            layout.lowerBounds[secondaryChannel] + secondaryPercent * (layout.upperBounds[secondaryChannel] - layout.lowerBounds[secondaryChannel]);
+        channels[layout.thirdChannel] = layout.thirdValues[0];
+        channels[invertedChannel] = layout.upperBounds[invertedChannel] - channels[invertedChannel] + layout.lowerBounds[invertedChannel];
+
+        return THsv(channels[0], channels[1], channels[2]);
+    }
+
+    // Bilinearly resamples a plane rendered at sourceSize into a plane of destinationSize, mapping
+    // pixels the same way the spectrum geometry does: box pixels span [0, size - 1] end to end,
+    // while ring pixels are positioned relative to the center at size / 2.
+    inline void ResamplePlane(
+        const uint8_t* source,
+        int sourceSize,
+        uint8_t* destination,
+        int destinationSize,
+        SpectrumShape shape)
+    {
+        if (sourceSize <= 0 || destinationSize <= 0)
+        {
+            return;
+        }
+
+        double scale = 0.0;
+        if (shape == SpectrumShape::Box)
+        {
+            scale = destinationSize > 1 ? static_cast<double>(sourceSize - 1) / (destinationSize - 1) : 0.0;
+        }
+        else
+        {
+            scale = static_cast<double>(sourceSize) / destinationSize;
+        }
+
+        // The same source columns and weights are used by every row.
+        std::vector<int> firstColumns(destinationSize);
+        std::vector<double> columnWeights(destinationSize);
+        for (int column = 0; column < destinationSize; column++)
+        {
+            const double sourceColumn = column * scale;
+            firstColumns[column] = std::min(static_cast<int>(sourceColumn), sourceSize - 1);
+            columnWeights[column] = std::min(sourceColumn - firstColumns[column], 1.0);
+        }
+
+        for (int row = 0; row < destinationSize; row++)
+        {
+            const double sourceRow = row * scale;
+            const int firstRow = std::min(static_cast<int>(sourceRow), sourceSize - 1);
+            const int secondRow = std::min(firstRow + 1, sourceSize - 1);
+            const double rowWeight = std::min(sourceRow - firstRow, 1.0);
+
+            const uint8_t* firstSourceRow = source + static_cast<size_t>(firstRow) * sourceSize * 4;
+            const uint8_t* secondSourceRow = source + static_cast<size_t>(secondRow) * sourceSize * 4;
+            uint8_t* pixel = destination + static_cast<size_t>(row) * destinationSize * 4;
+
+            for (int column = 0; column < destinationSize; column++)
+            {
+                const int firstColumn = firstColumns[column];
+                const int secondColumn = std::min(firstColumn + 1, sourceSize - 1);
+                const double columnWeight = columnWeights[column];
+
+                for (int channel = 0; channel < 3; channel++)
+                {
+                    const double top =
+                        firstSourceRow[firstColumn * 4 + channel] * (1 - columnWeight) +
+                        firstSourceRow[secondColumn * 4 + channel] * columnWeight;
+                    const double bottom =
+                        secondSourceRow[firstColumn * 4 + channel] * (1 - columnWeight) +
+                        secondSourceRow[secondColumn * 4 + channel] * columnWeight;
+                    pixel[channel] = static_cast<uint8_t>(top * (1 - rowWeight) + bottom * rowWeight + 0.5);
+                }
+
+                pixel[3] = 255;
+                pixel += 4;
+            }
+        }
+    }
+}
@@ -0,0 +1,316 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "pch.h"
+#include "common.h"
+#include "ColorHelpers.h"
+#include "ColorSpectrumPlaneCache.h"
+#include "ColorSpectrumRenderer.h"
+#include "ColorSpectrumTestHooks.h"
+
+#include "ColorSpectrumTestHooks.properties.cpp"
+
+namespace
+{
+    ColorSpectrumRenderer::SpectrumParameters ToSpectrumParameters(winrt::ColorSpectrumTestParameters const& testParameters)
+    {
+        ColorSpectrumRenderer::SpectrumParameters parameters;
+        parameters.size = testParameters.Size;
+        parameters.shape = static_cast<ColorSpectrumRenderer::SpectrumShape>(testParameters.Shape);
+        parameters.components = static_cast<ColorSpectrumRenderer::SpectrumComponents>(testParameters.Components);
+        parameters.minHue = testParameters.MinHue;
+        parameters.maxHue = testParameters.MaxHue;
+        parameters.minSaturation = testParameters.MinSaturation;
+        parameters.maxSaturation = testParameters.MaxSaturation;
+        parameters.minValue = testParameters.MinValue;
+        parameters.maxValue = testParameters.MaxValue;
+        return parameters;
+    }
+
+    // What ColorSpectrum used to generate pixel by pixel: the six planes (the middle ones are
+    // only filled when hue is the third dimension) and the HSV value of every pixel, which
+    // hit-testing used to look up.
+    struct PerPixelSpectrum
+    {
+        std::vector<::byte> planes[6];
+        std::vector<Hsv> hsvValues;
+    };
+
+    // The HSV values of the six planes at one pixel, computed the way ColorSpectrum::FillPixelForBox
+    // and ColorSpectrum::FillPixelForRing did.
+    void ComputePerPixelHsvs(
+        const ColorSpectrumRenderer::SpectrumParameters& parameters,
+        double x,
+        double y,
+        Hsv (&hsvs)[6])
+    {
+        const double hMin = parameters.minHue;
+        const double hMax = parameters.maxHue;
+        const double sMin = parameters.minSaturation / 100.0;
+        const double sMax = parameters.maxSaturation / 100.0;
+        const double vMin = parameters.minValue / 100.0;
+        const double vMax = parameters.maxValue / 100.0;
+
+        // The box used (yPercent, xPercent) and the ring (thetaPercent, r) for the same two axes.
+        double primaryPercent = 0;
+        double secondaryPercent = 0;
+
+        if (parameters.shape == ColorSpectrumRenderer::SpectrumShape::Box)
+        {
+            const double minDimension = parameters.size;
+            secondaryPercent = (minDimension - 1 - x) / (minDimension - 1);
+            primaryPercent = (minDimension - 1 - y) / (minDimension - 1);
+        }
+        else
+        {
+            const double radius = parameters.size / 2.0;
+            double distanceFromRadius = sqrt(pow(x - radius, 2) + pow(y - radius, 2));
+
+            double xToUse = x;
+            double yToUse = y;
+
+            if (distanceFromRadius > radius)
+            {
+                xToUse = (radius / distanceFromRadius) * (x - radius) + radius;
+                yToUse = (radius / distanceFromRadius) * (y - radius) + radius;
+                distanceFromRadius = radius;
+            }
+
+            secondaryPercent = 1 - distanceFromRadius / radius;
+
+            double theta = atan2((radius - yToUse), (radius - xToUse)) * 180.0 / M_PI;
+            theta += 180.0;
+            theta = floor(theta);
+
+            while (theta > 360)
+            {
+                theta -= 360;
+            }
+
+            primaryPercent = theta / 360;
+        }
+
+        Hsv& hsvMin = hsvs[0];
+        Hsv& hsvMax = hsvs[5];
+        const auto setAll = [&hsvs](double Hsv::* channel, double value)
+        {
+            for (auto& hsv : hsvs)
+            {
+                hsv.*channel = value;
+            }
+        };
+        const auto setHues = [&hsvs]()
+        {
+            for (int plane = 0; plane < 6; plane++)
+            {
+                hsvs[plane].h = plane * 60.0;
+            }
+        };
+
+        switch (parameters.components)
+        {
+        case ColorSpectrumRenderer::SpectrumComponents::HueValue:
+            setAll(&Hsv::h, hMin + primaryPercent * (hMax - hMin));
+            setAll(&Hsv::v, vMin + secondaryPercent * (vMax - vMin));
+            hsvMin.s = 0;
+            hsvMax.s = 1;
+            break;
+
+        case ColorSpectrumRenderer::SpectrumComponents::HueSaturation:
+            setAll(&Hsv::h, hMin + primaryPercent * (hMax - hMin));
+            setAll(&Hsv::s, sMin + secondaryPercent * (sMax - sMin));
+            hsvMin.v = 0;
+            hsvMax.v = 1;
+            break;
+
+        case ColorSpectrumRenderer::SpectrumComponents::ValueHue:
+            setAll(&Hsv::v, vMin + primaryPercent * (vMax - vMin));
+            setAll(&Hsv::h, hMin + secondaryPercent * (hMax - hMin));
+            hsvMin.s = 0;
+            hsvMax.s = 1;
+            break;
+
+        case ColorSpectrumRenderer::SpectrumComponents::ValueSaturation:
+            setAll(&Hsv::v, vMin + primaryPercent * (vMax - vMin));
+            setAll(&Hsv::s, sMin + secondaryPercent * (sMax - sMin));
+            setHues();
+            break;
+
+        case ColorSpectrumRenderer::SpectrumComponents::SaturationHue:
+            setAll(&Hsv::s, sMin + primaryPercent * (sMax - sMin));
+            setAll(&Hsv::h, hMin + secondaryPercent * (hMax - hMin));
+            hsvMin.v = 0;
+            hsvMax.v = 1;
+            break;
+
+        case ColorSpectrumRenderer::SpectrumComponents::SaturationValue:
+            setAll(&Hsv::s, sMin + primaryPercent * (sMax - sMin));
+            setAll(&Hsv::v, vMin + secondaryPercent * (vMax - vMin));
+            setHues();
+            break;
+        }
+
+        for (auto& hsv : hsvs)
+        {
+            if (parameters.components == ColorSpectrumRenderer::SpectrumComponents::HueSaturation ||
+                parameters.components == ColorSpectrumRenderer::SpectrumComponents::SaturationHue)
+            {
+                hsv.s = sMax - hsv.s + sMin;
+            }
+            else
+            {
+                hsv.v = vMax - hsv.v + vMin;
+            }
+        }
+    }
+
+    void AppendPerPixel(const ColorSpectrumRenderer::SpectrumParameters& parameters, double x, double y, PerPixelSpectrum& spectrum)
+    {
+        Hsv hsvs[6];
+        ComputePerPixelHsvs(parameters, x, y, hsvs);
+
+        spectrum.hsvValues.push_back(hsvs[0]);
+
+        const bool thirdDimensionIsHue = ColorSpectrumRenderer::ThirdDimensionIsHue(parameters.components);
+        for (int plane = 0; plane < 6; plane++)
+        {
+            if (plane == 0 || plane == 5 || thirdDimensionIsHue)
+            {
+                const Rgb rgb = HsvToRgb(hsvs[plane]);
+                auto& pixelData = spectrum.planes[plane];
+                pixelData.push_back(static_cast<::byte>(round(rgb.b * 255)));
+                pixelData.push_back(static_cast<::byte>(round(rgb.g * 255)));
+                pixelData.push_back(static_cast<::byte>(round(rgb.r * 255)));
+                pixelData.push_back(255);
+            }
+        }
+    }
+
+    // Visits the pixels in the order ColorSpectrum::CreateBitmapsAndColorMap used to.
+    PerPixelSpectrum RenderPerPixel(const ColorSpectrumRenderer::SpectrumParameters& parameters)
+    {
+        PerPixelSpectrum spectrum;
+        const int size = parameters.size;
+
+        if (parameters.shape == ColorSpectrumRenderer::SpectrumShape::Box)
+        {
+            for (int x = size - 1; x >= 0; --x)
+            {
+                for (int y = size - 1; y >= 0; --y)
+                {
+                    AppendPerPixel(parameters, x, y, spectrum);
+                }
+            }
+        }
+        else
+        {
+            for (int y = 0; y < size; ++y)
+            {
+                for (int x = 0; x < size; ++x)
+                {
+                    AppendPerPixel(parameters, x, y, spectrum);
+                }
+            }
+        }
+
+        return spectrum;
+    }
+
+    int CountDifferentBytes(std::vector<::byte> const& expected, std::vector<::byte> const& actual)
+    {
+        if (expected.size() != actual.size())
+        {
+            return static_cast<int>(std::max(expected.size(), actual.size()));
+        }
+
+        int differentByteCount = 0;
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            if (expected[i] != actual[i])
+            {
+                differentByteCount++;
+            }
+        }
+        return differentByteCount;
+    }
+}
+
+int ColorSpectrumTestHooks::CountRenderedBytesDifferentFromPerPixelPath(winrt::ColorSpectrumTestParameters const& testParameters)
+{
+    const auto parameters = ToSpectrumParameters(testParameters);
+    const auto expected = RenderPerPixel(parameters);
+
+    const auto queueOnThreadPool = [](std::function<void()> const& work)
+    {
+        winrt::ThreadPool::RunAsync(winrt::WorkItemHandler([work](winrt::IAsyncAction const&) { work(); }));
+    };
+
+    int differentByteCount = 0;
+
+    // Every SIMD level this machine supports has to produce the same bytes.
+    const auto supportedSimdLevel = ColorSpectrumRenderer::GetSupportedSimdLevel();
+    for (int level = static_cast<int>(ColorSpectrumRenderer::SimdLevel::Scalar); level <= static_cast<int>(supportedSimdLevel); level++)
+    {
+        const size_t pixelDataSize = static_cast<size_t>(parameters.size) * parameters.size * 4;
+        std::vector<::byte> planes[6];
+        for (int plane = 0; plane < 6; plane++)
+        {
+            if (!expected.planes[plane].empty())
+            {
+                planes[plane].resize(pixelDataSize);
+            }
+        }
+
+        ColorSpectrumRenderer::SpectrumPlanes spectrumPlanes;
+        spectrumPlanes.min = planes[0].data();
+        spectrumPlanes.middle1 = planes[1].empty() ? nullptr : planes[1].data();
+        spectrumPlanes.middle2 = planes[2].empty() ? nullptr : planes[2].data();
+        spectrumPlanes.middle3 = planes[3].empty() ? nullptr : planes[3].data();
+        spectrumPlanes.middle4 = planes[4].empty() ? nullptr : planes[4].data();
+        spectrumPlanes.max = planes[5].data();
+
+        ColorSpectrumRenderer::Render(parameters, spectrumPlanes, nullptr, queueOnThreadPool, -1, static_cast<ColorSpectrumRenderer::SimdLevel>(level));
+
+        for (int plane = 0; plane < 6; plane++)
+        {
+            differentByteCount += CountDifferentBytes(expected.planes[plane], planes[plane]);
+        }
+    }
+
+    return differentByteCount;
+}
+
+int ColorSpectrumTestHooks::CountHitTestResultsDifferentFromPerPixelPath(winrt::ColorSpectrumTestParameters const& testParameters)
+{
+    const auto parameters = ToSpectrumParameters(testParameters);
+    const auto expected = RenderPerPixel(parameters);
+    const int size = parameters.size;
+
+    // ColorSpectrum used to look the point up as m_hsvValues[y * width + x], whatever order the pixels were visited in.
+    int differentResultCount = 0;
+    for (int y = 0; y < size; y++)
+    {
+        for (int x = 0; x < size; x++)
+        {
+            const Hsv& expectedHsv = expected.hsvValues[static_cast<size_t>(y) * size + x];
+            const Hsv actualHsv = ColorSpectrumRenderer::GetHsvAt<Hsv>(parameters, y, x);
+
+            if (expectedHsv.h != actualHsv.h || expectedHsv.s != actualHsv.s || expectedHsv.v != actualHsv.v)
+            {
+                differentResultCount++;
+            }
+        }
+    }
+
+    return differentResultCount;
+}
+
+int ColorSpectrumTestHooks::GetPlaneCacheEntryCount()
+{
+    return static_cast<int>(ColorSpectrumPlaneCache::Instance().EntryCount());
+}
+
+void ColorSpectrumTestHooks::ClearPlaneCache()
+{
+    ColorSpectrumPlaneCache::Instance().Clear();
+}
@@ -0,0 +1,16 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include "ColorSpectrumTestHooks.g.h"
+
+class ColorSpectrumTestHooks :
+    public winrt::implementation::ColorSpectrumTestHooksT<ColorSpectrumTestHooks>
+{
+public:
+    static int CountRenderedBytesDifferentFromPerPixelPath(winrt::ColorSpectrumTestParameters const& parameters);
+    static int CountHitTestResultsDifferentFromPerPixelPath(winrt::ColorSpectrumTestParameters const& parameters);
+    static int GetPlaneCacheEntryCount();
+    static void ClearPlaneCache();
+};
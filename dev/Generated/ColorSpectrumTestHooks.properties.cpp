@@ -0,0 +1,16 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+// DO NOT EDIT! This file was generated by CustomTasks.DependencyPropertyCodeGen
+#include "pch.h"
+#include "common.h"
+#include "ColorSpectrumTestHooks.h"
+
+namespace winrt::Microsoft::UI::Private::Controls
+{
+    CppWinRTActivatableClassWithBasicFactory(ColorSpectrumTestHooks)
+}
+
+#include "ColorSpectrumTestHooks.g.cpp"
+
+
@@ -186,13 +186,19 @@ NavigationView::NavigationView()
 
 void NavigationView::OnSelectionModelChildrenRequested(const winrt::SelectionModel& selectionModel, const winrt::SelectionModelChildrenRequestedEventArgs& e)
 {
-    if (auto nvi = e.Source().try_as<winrt::NavigationViewItem>())
+    auto const children = [this, &e]()
     {
-        e.Children(GetChildren(nvi));
-    }
-    else if (auto const children = GetChildrenForItemInIndexPath(e.SourceIndex(), true /*forceRealize*/))
+        if (auto nvi = e.Source().try_as<winrt::NavigationViewItem>())
+        {
+            return GetChildren(nvi);
+        }
+        return GetChildrenForItemInIndexPath(e.SourceIndex(), true /*forceRealize*/);
+    }();
+
+    if (children)
     {
         e.Children(children);
+        m_dataIndex.RegisterChildrenSource(e.Source(), children);
     }
 }
 
@@ -576,6 +582,7 @@ void NavigationView::UpdateRepeaterItemsSource(bool forceSelectionModelUpdate)
     if (forceSelectionModelUpdate)
     {
         m_selectionModel.Source(itemsSource);
+        m_dataIndex.SetRootSource(itemsSource);
     }
 
     if (IsTopNavigationView())
@@ -948,6 +955,15 @@ void NavigationView::OnRepeaterElementPrepared(const winrt::ItemsRepeater& ir, c
             nviRevokers->isSelectedRevoker = RegisterPropertyChanged(nvi, winrt::NavigationViewItemBase::IsSelectedProperty(), { this, &NavigationView::OnNavigationViewItemIsSelectedPropertyChanged });
             nviRevokers->isExpandedRevoker = RegisterPropertyChanged(nvi, winrt::NavigationViewItem::IsExpandedProperty(), { this, &NavigationView::OnNavigationViewItemExpandedPropertyChanged });
             nvi.SetValue(s_NavigationViewItemRevokersProperty, nviRevokers.as<winrt::IInspectable>());
+
+            // Bindings have been processed by now, so this is where the children of a data item become known.
+            if (auto const children = GetChildren(nvi))
+            {
+                if (auto const itemsSourceView = ir.ItemsSourceView())
+                {
+                    m_dataIndex.RegisterChildrenSource(itemsSourceView.GetAt(args.Index()), children);
+                }
+            }
         }
     }
 }
@@ -3200,6 +3216,26 @@ void NavigationView::ShrinkTopNavigationSize(float desiredWidth, winrt::Size con
     }
 }
 
+// Returns the first index in [begin, end) for which predicate is true, or end if there is none.
+// The predicate has to be false for all indexes before that one and true for all indexes after it.
+template <typename Predicate>
+static int FindFirstIndex(int begin, int end, Predicate const& predicate)
+{
+    while (begin < end)
+    {
+        const int middle = begin + (end - begin) / 2;
+        if (predicate(middle))
+        {
+            end = middle;
+        }
+        else
+        {
+            begin = middle + 1;
+        }
+    }
+    return begin;
+}
+
 std::vector<int> NavigationView::FindMovableItemsRecoverToPrimaryList(float availableWidth, std::vector<int> const& includeItems)
 {
     std::vector<int> toBeMoved;
@@ -3214,28 +3250,40 @@ std::vector<int> NavigationView::FindMovableItemsRecoverToPrimaryList(float avai
         availableWidth -= width;
     }
 
-    int i = 0;
-    while (i < size && availableWidth > 0)
+    // Items not in the primary list are recovered in order while they fit. The width needed to recover
+    // every such item before index only grows with index, so where that stops is a binary search.
+    const auto widthToRecoverItemsBefore = [this, &includeItems](int index)
     {
-        if (!m_topDataProvider.IsItemInPrimaryList(i) && !CollectionHelper::contains(includeItems, i))
+        auto width = m_topDataProvider.OverflowItemsWidthBefore(index);
+        for (const auto includedIndex : includeItems)
         {
-            const auto width = m_topDataProvider.GetWidthForItem(i);
-            if (availableWidth >= width)
+            if (includedIndex < index && !m_topDataProvider.IsItemInPrimaryList(includedIndex))
             {
-                toBeMoved.push_back(i);
-                availableWidth -= width;
-            }
-            else
-            {
-                break;
+                width -= m_topDataProvider.GetWidthForItem(includedIndex);
             }
         }
-        i++;
+        return width;
+    };
+
+    // Stop at the first index where no width is left, or at the first item that doesn't fit.
+    const auto noWidthLeftIndex = FindFirstIndex(0, size, [&](int index) { return widthToRecoverItemsBefore(index) >= availableWidth; });
+    const auto notFittingIndex = FindFirstIndex(1, size + 1, [&](int index) { return widthToRecoverItemsBefore(index) > availableWidth; }) - 1;
+    const auto end = std::min(noWidthLeftIndex, notFittingIndex);
+
+    // Walk the same items the widths above were summed over: every item not in the primary list,
+    // including the ones that are not initialized yet.
+    for (int index = 0; index < end; index++)
+    {
+        if (!m_topDataProvider.IsItemInPrimaryList(index) && !CollectionHelper::contains(includeItems, index))
+        {
+            toBeMoved.push_back(index);
+        }
     }
+
     // Keep at one item is not in primary list. Two possible reason: 
     //  1, Most likely it's caused by m_topNavigationRecoveryGracePeriod
     //  2, virtualization and it doesn't have cached width
-    if (i == size && !toBeMoved.empty())
+    if (end == size && !toBeMoved.empty())
     {
         toBeMoved.pop_back();
     }
@@ -3246,19 +3294,32 @@ std::vector<int> NavigationView::FindMovableItemsToBeRemovedFromPrimaryList(floa
 {
     std::vector<int> toBeMoved;
 
-    int i = m_topDataProvider.Size() - 1;
-    while (i >= 0 && widthAtLeastToBeRemoved > 0)
+    const auto size = m_topDataProvider.Size();
+
+    // Items of the primary list are removed from the end until enough width is removed. The width removed by
+    // removing every such item from index on only shrinks as index grows, so where to start is a binary search.
+    const auto widthRemovedByItemsFrom = [this, &excludeItems, size](int index)
     {
-        if (m_topDataProvider.IsItemInPrimaryList(i))
+        auto width = m_topDataProvider.PrimaryItemsWidthBefore(size) - m_topDataProvider.PrimaryItemsWidthBefore(index);
+        for (const auto excludedIndex : excludeItems)
         {
-            if (!CollectionHelper::contains(excludeItems, i))
+            if (excludedIndex >= index && excludedIndex < size && m_topDataProvider.IsItemInPrimaryList(excludedIndex))
             {
-                const auto width = m_topDataProvider.GetWidthForItem(i);
-                toBeMoved.push_back(i);
-                widthAtLeastToBeRemoved -= width;
+                width -= m_topDataProvider.GetWidthForItem(excludedIndex);
             }
         }
-        i--;
+        return width;
+    };
+
+    const auto begin = std::max(0, FindFirstIndex(0, size + 1, [&](int index) { return widthRemovedByItemsFrom(index) < widthAtLeastToBeRemoved; }) - 1);
+
+    const auto primaryItems = m_topDataProvider.IndexesInListInRange(NavigationViewSplitVectorID::PrimaryList, begin, size);
+    for (auto it = primaryItems.rbegin(); it != primaryItems.rend(); ++it)
+    {
+        if (!CollectionHelper::contains(excludeItems, *it))
+        {
+            toBeMoved.push_back(*it);
+        }
     }
 
     return toBeMoved;
@@ -4442,6 +4503,11 @@ winrt::IndexPath NavigationView::SearchEntireTreeForIndexPath(const winrt::Navig
                                 // TODO: If nextPhase is not -1, ProcessBinding for all the phases
                             }
 
+                            if (auto const children = GetChildren(nvi))
+                            {
+                                m_dataIndex.RegisterChildrenSource(childData, children);
+                            }
+
                             if (auto const foundIndexPath = SearchEntireTreeForIndexPath(nvi, data, newIndexPath))
                             {
                                 return foundIndexPath;
@@ -4536,7 +4602,14 @@ winrt::IndexPath NavigationView::GetIndexPathOfItem(const winrt::IInspectable& d
         return GetIndexPathForContainer(nvib);
     }
 
-    // In the databinding scenario, we need to conduct a search where we go through every item,
+    // In the databinding scenario, first try the data index which walks up through the parent items
+    // of the data and doesn't need any containers.
+    if (auto const ip = m_dataIndex.TryGetIndexPath(data))
+    {
+        return ip;
+    }
+
+    // Otherwise we need to conduct a search where we go through every item,
     // realizing it if necessary.
     if (IsTopNavigationView())
     {
@@ -10,6 +10,7 @@ struct bringintoview_event_revoker;
 #include "NavigationViewItem.h"
 #include "NavigationView.g.h"
 #include "TopNavigationViewDataProvider.h"
+#include "NavigationViewDataIndex.h"
 #include "NavigationViewHelper.h"
 #include "NavigationView.properties.h"
 #include "NavigationViewItemsFactory.h"
@@ -413,6 +414,9 @@ private:
 
     TopNavigationViewDataProvider m_topDataProvider{ this };
 
+    // Resolves data items to their IndexPath without realizing containers.
+    NavigationViewDataIndex m_dataIndex{ this };
+
     winrt::SelectionModel m_selectionModel{};
 
     bool m_appliedTemplate{ false };
@@ -0,0 +1,265 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include "pch.h"
+#include "common.h"
+#include "IndexPath.h"
+#include "NavigationViewDataIndex.h"
+
+NavigationViewDataIndex::NavigationViewDataIndex(const ITrackerHandleManager* owner)
+    : m_owner(owner)
+{
+}
+
+void NavigationViewDataIndex::SetRootSource(const winrt::IInspectable& source)
+{
+    m_sources.clear();
+    m_sourceForItem.clear();
+    m_childrenSourceForItem.clear();
+    m_hasDirtySources = false;
+    m_mayHaveOrphanedSources = false;
+
+    if (source)
+    {
+        AddSource(source, nullptr);
+    }
+}
+
+void NavigationViewDataIndex::RegisterChildrenSource(const winrt::IInspectable& parentItem, const winrt::IInspectable& childrenSource)
+{
+    // Children are only meaningful relative to a root.
+    if (!parentItem || !childrenSource || m_sources.empty())
+    {
+        return;
+    }
+
+    auto const parentIdentity = GetIdentity(parentItem);
+    if (auto const it = m_childrenSourceForItem.find(parentIdentity); it != m_childrenSourceForItem.end())
+    {
+        if (it->second->m_rawSourceIdentity == GetIdentity(childrenSource))
+        {
+            return;
+        }
+
+        // The item got a different children collection, forget the old one.
+        RemoveSource(it->second);
+    }
+
+    if (auto const entry = AddSource(childrenSource, parentItem))
+    {
+        m_childrenSourceForItem[parentIdentity] = entry;
+    }
+}
+
+winrt::IndexPath NavigationViewDataIndex::TryGetIndexPath(const winrt::IInspectable& item)
+{
+    if (!item || m_sources.empty())
+    {
+        return nullptr;
+    }
+
+    RebuildDirtySources();
+
+    auto const root = m_sources.front().get();
+    std::vector<int> path;
+    auto current = item;
+
+    // Walk up through the parent items. Every step moves to a different collection, so the number
+    // of known collections bounds the depth and protects against cycles in the data.
+    for (size_t depth = 0; depth < m_sources.size(); depth++)
+    {
+        int index = -1;
+        auto const entry = FindSourceContainingItem(GetIdentity(current), index);
+        if (!entry)
+        {
+            return nullptr;
+        }
+
+        path.push_back(index);
+        if (entry == root)
+        {
+            std::reverse(path.begin(), path.end());
+            return IndexPath::CreateFromIndices(path);
+        }
+
+        current = entry->m_parentItem.get();
+        if (!current)
+        {
+            return nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
+NavigationViewDataIndex::SourceEntry* NavigationViewDataIndex::AddSource(const winrt::IInspectable& rawSource, const winrt::IInspectable& parentItem)
+{
+    auto source = rawSource.try_as<winrt::ItemsSourceView>();
+    if (!source)
+    {
+        source = winrt::ItemsSourceView(rawSource);
+    }
+
+    auto entry = std::make_unique<SourceEntry>(m_owner);
+    entry->m_source.set(source);
+    entry->m_parentItem.set(parentItem);
+    entry->m_rawSourceIdentity = GetIdentity(rawSource);
+
+    auto const entryPtr = entry.get();
+    entry->m_collectionChangedRevoker = source.CollectionChanged(winrt::auto_revoke,
+        [this, entryPtr](auto const&, auto const&)
+        {
+            entryPtr->m_isDirty = true;
+            m_hasDirtySources = true;
+        });
+
+    m_sources.push_back(std::move(entry));
+    m_hasDirtySources = true;
+    return entryPtr;
+}
+
+void NavigationViewDataIndex::RemoveSource(SourceEntry* entry)
+{
+    MUX_ASSERT(entry != m_sources.front().get());
+
+    for (auto const& [itemIdentity, index] : entry->m_indices)
+    {
+        if (auto const it = m_sourceForItem.find(itemIdentity); it != m_sourceForItem.end() && it->second == entry)
+        {
+            m_sourceForItem.erase(it);
+            m_mayHaveOrphanedSources = true;
+        }
+    }
+
+    // The collections nested under the removed one are removed by the next RemoveOrphanedSources.
+    m_sources.erase(std::find_if(m_sources.begin(), m_sources.end(),
+        [entry](auto const& source) { return source.get() == entry; }));
+}
+
+// Removes the children collections of items that are no longer in any known collection, so that
+// they don't keep the collections (and their CollectionChanged subscriptions) alive. Removing one
+// can orphan the collections nested under its own items, so repeat until nothing is removed.
+void NavigationViewDataIndex::RemoveOrphanedSources()
+{
+    bool removedSource = true;
+    while (removedSource)
+    {
+        removedSource = false;
+        for (auto it = m_childrenSourceForItem.begin(); it != m_childrenSourceForItem.end();)
+        {
+            if (m_sourceForItem.find(it->first) == m_sourceForItem.end())
+            {
+                RemoveSource(it->second);
+                it = m_childrenSourceForItem.erase(it);
+                removedSource = true;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+    m_mayHaveOrphanedSources = false;
+}
+
+void NavigationViewDataIndex::RebuildDirtySources()
+{
+    if (m_hasDirtySources)
+    {
+        for (auto const& entry : m_sources)
+        {
+            if (entry->m_isDirty)
+            {
+                RebuildSource(*entry);
+            }
+        }
+        m_hasDirtySources = false;
+    }
+
+    // Only safe once every source is rebuilt, otherwise items of dirty sources look orphaned.
+    if (m_mayHaveOrphanedSources)
+    {
+        RemoveOrphanedSources();
+    }
+}
+
+void NavigationViewDataIndex::RebuildSource(SourceEntry& entry)
+{
+    std::unordered_map<void*, int> previousIndices;
+    previousIndices.swap(entry.m_indices);
+    for (auto const& [itemIdentity, index] : previousIndices)
+    {
+        if (auto const it = m_sourceForItem.find(itemIdentity); it != m_sourceForItem.end() && it->second == &entry)
+        {
+            m_sourceForItem.erase(it);
+        }
+    }
+
+    auto const source = entry.m_source.get();
+    auto const count = source.Count();
+    entry.m_indices.reserve(count);
+    for (int i = 0; i < count; i++)
+    {
+        if (auto const itemIdentity = GetIdentity(source.GetAt(i)))
+        {
+            // Keep the first occurrence, which is what a linear search would find. An item that is
+            // in several collections stays with the one that registered it first.
+            if (entry.m_indices.emplace(itemIdentity, i).second)
+            {
+                m_sourceForItem.emplace(itemIdentity, &entry);
+            }
+        }
+    }
+    entry.m_isDirty = false;
+
+    for (auto const& [itemIdentity, index] : previousIndices)
+    {
+        if (m_childrenSourceForItem.find(itemIdentity) != m_childrenSourceForItem.end() &&
+            m_sourceForItem.find(itemIdentity) == m_sourceForItem.end())
+        {
+            m_mayHaveOrphanedSources = true;
+            break;
+        }
+    }
+}
+
+NavigationViewDataIndex::SourceEntry* NavigationViewDataIndex::FindSourceContainingItem(void* itemIdentity, int& index)
+{
+    if (!itemIdentity)
+    {
+        return nullptr;
+    }
+
+    auto const it = m_sourceForItem.find(itemIdentity);
+    if (it == m_sourceForItem.end())
+    {
+        return nullptr;
+    }
+
+    auto const entry = it->second;
+    auto const indexIt = entry->m_indices.find(itemIdentity);
+    MUX_ASSERT(indexIt != entry->m_indices.end());
+    index = indexIt->second;
+
+    // Sources that don't raise CollectionChanged can change under us, so confirm the entry
+    // before trusting it and rebuild that source once if it has gone stale.
+    auto const source = entry->m_source.get();
+    if (index >= source.Count() || GetIdentity(source.GetAt(index)) != itemIdentity)
+    {
+        RebuildSource(*entry);
+        if (auto const rebuiltIt = entry->m_indices.find(itemIdentity); rebuiltIt != entry->m_indices.end())
+        {
+            index = rebuiltIt->second;
+            return entry;
+        }
+        return nullptr;
+    }
+
+    return entry;
+}
+
+/* static */
+void* NavigationViewDataIndex::GetIdentity(const winrt::IInspectable& item)
+{
+    return item ? winrt::get_abi(item.as<winrt::IUnknown>()) : nullptr;
+}
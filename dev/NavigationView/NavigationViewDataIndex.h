@@ -0,0 +1,61 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <unordered_map>
+
+// Maps data items of a (possibly hierarchical) MenuItemsSource to their IndexPath without going
+// through containers. Each known collection keeps an item -> index map that is built lazily on the
+// first lookup and rebuilt after the collection raises CollectionChanged. The root collection is
+// known upfront; child collections are learned as they are discovered (e.g. when a container is
+// prepared or when SelectionModel requests children), so a miss only means the caller has to fall
+// back to searching the tree. The children collection of an item that leaves every known
+// collection is dropped, together with the collections nested under it.
+class NavigationViewDataIndex
+{
+public:
+    NavigationViewDataIndex(const ITrackerHandleManager* owner);
+
+    // Drops everything that is known and starts over with the given MenuItems/MenuItemsSource.
+    void SetRootSource(const winrt::IInspectable& source);
+
+    // Records that the children of parentItem come from childrenSource.
+    void RegisterChildrenSource(const winrt::IInspectable& parentItem, const winrt::IInspectable& childrenSource);
+
+    // Returns the IndexPath of item in the root source, or null if the item is not (yet) known.
+    winrt::IndexPath TryGetIndexPath(const winrt::IInspectable& item);
+
+private:
+    struct SourceEntry
+    {
+        SourceEntry(const ITrackerHandleManager* owner) : m_source(owner), m_parentItem(owner) {}
+
+        tracker_ref<winrt::ItemsSourceView> m_source;
+        // Null for the root source.
+        tracker_ref<winrt::IInspectable> m_parentItem;
+        void* m_rawSourceIdentity{ nullptr };
+        std::unordered_map<void*, int> m_indices;
+        bool m_isDirty{ true };
+        winrt::ItemsSourceView::CollectionChanged_revoker m_collectionChangedRevoker{};
+    };
+
+    SourceEntry* AddSource(const winrt::IInspectable& rawSource, const winrt::IInspectable& parentItem);
+    void RemoveSource(SourceEntry* entry);
+    void RemoveOrphanedSources();
+    void RebuildDirtySources();
+    void RebuildSource(SourceEntry& entry);
+    SourceEntry* FindSourceContainingItem(void* itemIdentity, int& index);
+
+    static void* GetIdentity(const winrt::IInspectable& item);
+
+    const ITrackerHandleManager* m_owner{ nullptr };
+
+    // m_sources[0] is the root source when one has been set.
+    std::vector<std::unique_ptr<SourceEntry>> m_sources;
+    std::unordered_map<void*, SourceEntry*> m_sourceForItem;
+    std::unordered_map<void*, SourceEntry*> m_childrenSourceForItem;
+    bool m_hasDirtySources{ false };
+    // Set when an item with registered children may have left every known collection.
+    bool m_mayHaveOrphanedSources{ false };
+};
@@ -7,6 +7,7 @@ using Common;
 using System;
 using Windows.Foundation.Metadata;
 using Windows.UI.Xaml.Controls;
+using Windows.UI.Xaml.Markup;
 using Windows.UI.Xaml.Media;
 using Windows.UI.Xaml.Shapes;
 
@@ -852,5 +853,254 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
             });
         }
 
+        [TestMethod]
+        public void VerifyTopNavOverflowKeepsItemsInOrderWhenResized()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                const int itemCount = 300;
+                var menuItems = new ObservableCollection<string>();
+                for (int i = 0; i < itemCount; i++)
+                {
+                    menuItems.Add("Item " + i);
+                }
+
+                var navView = new NavigationView();
+                navView.PaneDisplayMode = NavigationViewPaneDisplayMode.Top;
+                navView.MenuItemsSource = menuItems;
+                navView.Width = 1200;
+                Content = navView;
+                Content.UpdateLayout();
+
+                var primaryRepeater = (Microsoft.UI.Xaml.Controls.ItemsRepeater)VisualTreeUtils.FindVisualChildByName(navView, "TopNavMenuItemsHost");
+                var overflowButton = (Button)VisualTreeUtils.FindVisualChildByName(navView, "TopNavOverflowButton");
+                var overflowScrollHost = (Microsoft.UI.Xaml.Controls.ItemsRepeaterScrollHost)((Flyout)overflowButton.Flyout).Content;
+                var overflowRepeater = (Microsoft.UI.Xaml.Controls.ItemsRepeater)overflowScrollHost.ScrollViewer.Content;
+                Action verifyPrimaryItemsArePrefix = () =>
+                {
+                    var primaryItems = primaryRepeater.ItemsSourceView;
+                    var overflowItems = overflowRepeater.ItemsSourceView;
+                    Verify.IsTrue(primaryItems.Count > 0);
+                    Verify.IsTrue(primaryItems.Count < menuItems.Count);
+                    Verify.AreEqual(menuItems.Count, primaryItems.Count + overflowItems.Count);
+                    for (int i = 0; i < primaryItems.Count; i++)
+                    {
+                        Verify.AreEqual(menuItems[i], (string)primaryItems.GetAt(i));
+                    }
+                    for (int i = 0; i < overflowItems.Count; i++)
+                    {
+                        Verify.AreEqual(menuItems[primaryItems.Count + i], (string)overflowItems.GetAt(i));
+                    }
+                };
+
+                verifyPrimaryItemsArePrefix();
+                var primaryCountAtFullWidth = primaryRepeater.ItemsSourceView.Count;
+
+                foreach (var width in new double[] { 600, 900, 400, 1200 })
+                {
+                    navView.Width = width;
+                    Content.UpdateLayout();
+                    verifyPrimaryItemsArePrefix();
+                }
+
+                Verify.AreEqual(primaryCountAtFullWidth, primaryRepeater.ItemsSourceView.Count);
+
+                // Items inserted into the raw data, in either list or on the boundary between them, keep raw order.
+                var primaryCount = primaryRepeater.ItemsSourceView.Count;
+                foreach (var index in new int[] { 0, primaryCount / 2, primaryCount, primaryCount + 1, primaryCount + 10, menuItems.Count })
+                {
+                    menuItems.Insert(index, "Inserted at " + index);
+                    Content.UpdateLayout();
+                    verifyPrimaryItemsArePrefix();
+                }
+            });
+        }
+
+        [TestMethod]
+        public void VerifySelectingUnrealizedMenuItemsSourceItemsAfterCollectionChanges()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                const int itemCount = 500;
+                var menuItems = new ObservableCollection<MenuDataItem>();
+                for (int i = 0; i < itemCount; i++)
+                {
+                    menuItems.Add(new MenuDataItem("Item " + i));
+                }
+
+                var navView = new NavigationView();
+                navView.PaneDisplayMode = NavigationViewPaneDisplayMode.Left;
+                navView.MenuItemsSource = menuItems;
+                navView.Width = 1008;
+                navView.Height = 200;
+                Content = navView;
+                Content.UpdateLayout();
+
+                int selectionChangedCount = 0;
+                object lastSelectedItem = null;
+                navView.SelectionChanged += (sender, args) =>
+                {
+                    selectionChangedCount++;
+                    lastSelectedItem = args.SelectedItem;
+                };
+
+                Action<MenuDataItem> selectAndVerify = (item) =>
+                {
+                    var expectedCount = selectionChangedCount + 1;
+                    navView.SelectedItem = item;
+                    Content.UpdateLayout();
+                    Verify.AreEqual(item, navView.SelectedItem);
+                    Verify.AreEqual(expectedCount, selectionChangedCount);
+                    Verify.AreEqual(item, lastSelectedItem);
+                };
+
+                // None of these items have containers with this height.
+                selectAndVerify(menuItems[itemCount - 1]);
+                selectAndVerify(menuItems[itemCount / 2]);
+
+                // The index has to follow the collection as it changes.
+                var movedItem = menuItems[itemCount - 2];
+                menuItems.Insert(0, new MenuDataItem("Inserted"));
+                menuItems.RemoveAt(itemCount / 4);
+                selectAndVerify(movedItem);
+                Verify.AreEqual(movedItem, menuItems[itemCount - 2]);
+
+                menuItems.Move(itemCount - 2, itemCount / 3);
+                selectAndVerify(menuItems[itemCount / 3]);
+                selectAndVerify(menuItems[0]);
+            });
+        }
+
+        [TestMethod]
+        public void VerifySelectingUnrealizedNestedMenuItemsSourceItemsAfterCollectionChanges()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                Func<string, int, int, ObservableCollection<MenuDataItem>> createItems = null;
+                createItems = (name, count, depth) =>
+                {
+                    var items = new ObservableCollection<MenuDataItem>();
+                    for (int i = 0; i < count; i++)
+                    {
+                        var itemName = name + "." + i;
+                        items.Add(new MenuDataItem(itemName, depth > 1 ? createItems(itemName, count, depth - 1) : null));
+                    }
+                    return items;
+                };
+
+                var menuItems = createItems("Item", 3, 3);
+
+                // Counts the containers created for the menu items. Searching the tree for an item
+                // creates containers for the items it goes through, the data index does not.
+                var templateSelector = new CountingTemplateSelector()
+                {
+                    Template = (DataTemplate)XamlReader.Load(
+                        @"<DataTemplate xmlns='http://schemas.microsoft.com/winfx/2006/xaml/presentation'
+                                xmlns:controls='using:Microsoft.UI.Xaml.Controls'>
+                            <controls:NavigationViewItem Content='{Binding Name}' MenuItemsSource='{Binding Children}' />
+                        </DataTemplate>")
+                };
+
+                var navView = new NavigationView();
+                navView.PaneDisplayMode = NavigationViewPaneDisplayMode.Left;
+                navView.MenuItemTemplateSelector = templateSelector;
+                navView.MenuItemsSource = menuItems;
+                navView.Width = 1008;
+                Content = navView;
+                Content.UpdateLayout();
+
+                Action<MenuDataItem, bool> setIsExpanded = (item, isExpanded) =>
+                {
+                    var container = (NavigationViewItem)navView.ContainerFromMenuItem(item);
+                    container.IsExpanded = isExpanded;
+                    Content.UpdateLayout();
+                };
+
+                // Selects item while its ancestors are collapsed, then expands them to check that the
+                // container of item is the one that got selected.
+                Action<MenuDataItem, MenuDataItem[]> selectAndVerify = (item, ancestors) =>
+                {
+                    var selectCount = templateSelector.SelectCount;
+                    navView.SelectedItem = item;
+                    Content.UpdateLayout();
+                    Verify.AreEqual(item, navView.SelectedItem);
+                    Verify.AreEqual(selectCount, templateSelector.SelectCount, "Selecting " + item.Name + " should not create containers");
+
+                    foreach (var ancestor in ancestors)
+                    {
+                        setIsExpanded(ancestor, true);
+                    }
+
+                    var container = (NavigationViewItem)navView.ContainerFromMenuItem(item);
+                    Verify.IsNotNull(container);
+                    Verify.IsTrue(container.IsSelected, item.Name + " should be selected");
+
+                    for (int i = ancestors.Length - 1; i >= 0; i--)
+                    {
+                        setIsExpanded(ancestors[i], false);
+                    }
+                };
+
+                Log.Comment("Realize the children of Item.1, then collapse it again");
+                var parent = menuItems[1];
+                setIsExpanded(parent, true);
+                setIsExpanded(parent, false);
+
+                Log.Comment("Select a grandchild of the collapsed Item.1 by its data");
+                var child = parent.Children[2];
+                selectAndVerify(child.Children[1], new MenuDataItem[] { parent, child });
+
+                Log.Comment("Replace the child, and with it its children collection");
+                var replacingChild = new MenuDataItem("Replacing", createItems("Replacing", 2, 1));
+                parent.Children[2] = replacingChild;
+                Content.UpdateLayout();
+                // The index learns the children collection of the replacing child once its container is realized.
+                setIsExpanded(parent, true);
+                setIsExpanded(parent, false);
+                selectAndVerify(replacingChild.Children[1], new MenuDataItem[] { parent, replacingChild });
+
+                Log.Comment("Move the parent and select a grandchild of it again");
+                menuItems.Move(1, 0);
+                Content.UpdateLayout();
+                selectAndVerify(parent.Children[0].Children[2], new MenuDataItem[] { parent, parent.Children[0] });
+            });
+        }
+
+        public class CountingTemplateSelector : DataTemplateSelector
+        {
+            public DataTemplate Template { get; set; }
+
+            public int SelectCount { get; private set; }
+
+            protected override DataTemplate SelectTemplateCore(object item)
+            {
+                SelectCount++;
+                return Template;
+            }
+
+            protected override DataTemplate SelectTemplateCore(object item, DependencyObject container)
+            {
+                SelectCount++;
+                return Template;
+            }
+        }
+
+        public class MenuDataItem
+        {
+            public MenuDataItem(string name, ObservableCollection<MenuDataItem> children = null)
+            {
+                Name = name;
+                Children = children;
+            }
+
+            public string Name { get; private set; }
+
+            public ObservableCollection<MenuDataItem> Children { get; private set; }
+
+            public override string ToString()
+            {
+                return Name;
+            }
+        }
     }
 }
\ No newline at end of file
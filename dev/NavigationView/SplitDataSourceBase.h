@@ -17,6 +17,8 @@
 //  We never Add/Delete A,B and C Vector directly, but change the flag.
 //  If flag for Homes is changed from A to B, it asks A to remove it by indexInRawData first, then insert the new data to B vector with indexInRawData
 // SplitVector itself maintained the mapping between indexInRawData and indexInSplitVector.
+// Items keep the order of the raw data in every SplitVector, so the indexes in raw data of a SplitVector are sorted
+// and the mapping from indexInRawData to indexInSplitVector is a binary search.
 template<typename T, typename SplitVectorID>
 class SplitVector
 {
@@ -59,7 +61,7 @@ public:
     {
         for (auto& v : m_indexesInOriginalVector)
         {
-            if (v > indexInOriginalVector)
+            if (v >= indexInOriginalVector)
             {
                 v++;
             }
@@ -118,13 +120,29 @@ public:
 
     int IndexFromIndexInOriginalVector(int indexInOriginalVector)
     {
-        auto pos = std::find(m_indexesInOriginalVector.begin(), m_indexesInOriginalVector.end(), indexInOriginalVector);
-        if (pos != m_indexesInOriginalVector.end())
+        auto pos = std::lower_bound(m_indexesInOriginalVector.begin(), m_indexesInOriginalVector.end(), indexInOriginalVector);
+        if (pos != m_indexesInOriginalVector.end() && *pos == indexInOriginalVector)
         {
             return static_cast<int>(std::distance(m_indexesInOriginalVector.begin(), pos));
         }
         return -1;
     }
+
+    // Number of items in this vector that come before indexInOriginalVector in the raw data, which is also
+    // the index an item at indexInOriginalVector goes to when it's moved to this vector.
+    int CountBeforeIndexInOriginalVector(int indexInOriginalVector)
+    {
+        auto pos = std::lower_bound(m_indexesInOriginalVector.begin(), m_indexesInOriginalVector.end(), indexInOriginalVector);
+        return static_cast<int>(std::distance(m_indexesInOriginalVector.begin(), pos));
+    }
+
+    // Indexes in raw data of the items in this vector that are in [begin, end) in the raw data.
+    std::vector<int> IndexesInOriginalVectorInRange(int begin, int end)
+    {
+        auto first = std::lower_bound(m_indexesInOriginalVector.begin(), m_indexesInOriginalVector.end(), begin);
+        auto last = std::lower_bound(first, m_indexesInOriginalVector.end(), end);
+        return std::vector<int>(first, last);
+    }
 private:
     int Size() { return  static_cast<int>(m_indexesInOriginalVector.size()); }
 
@@ -156,6 +174,7 @@ public:
     {
         MUX_ASSERT(index >= 0 && index < RawDataSize());
         m_attachedData[index] = attachedData;
+        m_generation++;
     }
 
     void ResetAttachedData()
@@ -169,6 +188,7 @@ public:
         {
             m_attachedData[i] = attachedData;
         }
+        m_generation++;
     }
 
     std::shared_ptr<SplitVectorType> GetVectorForItem(int index)
@@ -208,6 +228,7 @@ public:
 
             // change flag
             m_flags[index] = newVectorID;
+            m_generation++;
 
             // insert item to vector which matches with the newVectorID
             if (auto &toVector = m_splitVectors[static_cast<int>(newVectorID)])
@@ -255,6 +276,13 @@ protected:
         return m_splitVectors[static_cast<int>(vectorID)];
     }
 
+    // Changes whenever the raw data, the vector an item belongs to or the attached data changes, so that
+    // derived classes can tell when data they computed from those is stale.
+    uint64_t Generation()
+    {
+        return m_generation;
+    }
+
 
     void OnClear()
     {
@@ -269,6 +297,7 @@ protected:
 
         m_flags.clear();
         m_attachedData.clear();
+        m_generation++;
     }
 
     void OnRemoveAt(int startIndex, int count)
@@ -300,6 +329,7 @@ protected:
             m_flags.push_back(defaultID);
             m_attachedData.push_back(defaultAttachedData);
         }
+        m_generation++;
     }
 
     void Clear()
@@ -323,6 +353,7 @@ private:
         
         m_flags.erase(m_flags.begin() + index);
         m_attachedData.erase(m_attachedData.begin() + index);
+        m_generation++;
     }
 
     void OnReplace(int index)
@@ -352,10 +383,15 @@ private:
 
         m_flags.insert(m_flags.begin() + index, vectorID);
         m_attachedData.insert(m_attachedData.begin() + index, defaultAttachedData);
+        m_generation++;
     }
 
     int GetPreferIndex(int index, SplitVectorID vectorID)
     {
+        if (auto& vector = m_splitVectors[static_cast<int>(vectorID)])
+        {
+            return vector->CountBeforeIndexInOriginalVector(index);
+        }
         return RangeCount(0, index, vectorID);
     }
 
@@ -376,4 +412,5 @@ private:
     std::vector<typename SplitVectorID> m_flags{ };
     std::vector<typename AttachedDataType> m_attachedData{ };
     std::array<std::shared_ptr<SplitVectorType>, SplitVectorSize> m_splitVectors{};
+    uint64_t m_generation{ 0 };
 };
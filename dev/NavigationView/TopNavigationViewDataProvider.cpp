@@ -195,16 +195,50 @@ void TopNavigationViewDataProvider::UpdateWidthForPrimaryItem(int indexInPrimary
 
 float TopNavigationViewDataProvider::WidthRequiredToRecoveryAllItemsToPrimary()
 {
-    auto width = 0.f;
-    for (int i=0; i<Size(); i++)
+    auto width = OverflowItemsWidthBefore(Size());
+    width -= m_overflowButtonCachedWidth;
+    return std::max(0.f, width);
+}
+
+float TopNavigationViewDataProvider::PrimaryItemsWidthBefore(int index)
+{
+    EnsureWidthPrefixSums();
+    return m_primaryWidthPrefixSums[std::clamp(index, 0, static_cast<int>(m_primaryWidthPrefixSums.size()) - 1)];
+}
+
+float TopNavigationViewDataProvider::OverflowItemsWidthBefore(int index)
+{
+    EnsureWidthPrefixSums();
+    return m_overflowWidthPrefixSums[std::clamp(index, 0, static_cast<int>(m_overflowWidthPrefixSums.size()) - 1)];
+}
+
+std::vector<int> TopNavigationViewDataProvider::IndexesInListInRange(NavigationViewSplitVectorID vectorID, int begin, int end)
+{
+    if (auto vector = GetVector(vectorID))
     {
-        if (!IsItemInPrimaryList(i))
+        return vector->IndexesInOriginalVectorInRange(begin, end);
+    }
+    return {};
+}
+
+void TopNavigationViewDataProvider::EnsureWidthPrefixSums()
+{
+    if (m_widthPrefixSumsGeneration != Generation())
+    {
+        const auto size = RawDataSize();
+        m_primaryWidthPrefixSums.resize(size + 1);
+        m_overflowWidthPrefixSums.resize(size + 1);
+        m_primaryWidthPrefixSums[0] = 0.f;
+        m_overflowWidthPrefixSums[0] = 0.f;
+        for (int i = 0; i < size; i++)
         {
-            width += GetWidthForItem(i);
+            const auto vectorID = GetVectorIDForItem(i);
+            const auto width = GetWidthForItem(i);
+            m_primaryWidthPrefixSums[i + 1] = m_primaryWidthPrefixSums[i] + (vectorID == NavigationViewSplitVectorID::PrimaryList ? width : 0.f);
+            m_overflowWidthPrefixSums[i + 1] = m_overflowWidthPrefixSums[i] + (vectorID == NavigationViewSplitVectorID::PrimaryList ? 0.f : width);
         }
+        m_widthPrefixSumsGeneration = Generation();
     }
-    width -= m_overflowButtonCachedWidth;
-    return std::max(0.f, width);
 }
 
 bool TopNavigationViewDataProvider::HasInvalidWidth(std::vector<int> & items)
@@ -60,6 +60,12 @@ public:
     void OverflowButtonWidth(float width);
     bool IsItemInPrimaryList(int index);
     bool HasInvalidWidth(std::vector<int> & items);
+
+    // Sum of the widths of the items in, or not in, the primary list that come before index in the raw data.
+    float PrimaryItemsWidthBefore(int index);
+    float OverflowItemsWidthBefore(int index);
+    // Indexes of the items of the vectorID list that are in [begin, end) in the raw data, in raw data order.
+    std::vector<int> IndexesInListInRange(NavigationViewSplitVectorID vectorID, int begin, int end);
     bool IsValidWidthForItem(int index);
 
     // If value is not in the raw data set or can't be move to primarylist, then return false
@@ -73,6 +79,7 @@ private:
     void ChangeDataSource(winrt::ItemsSourceView dataSource);
     bool IsContainerNavigationViewItem(int index);
     bool IsContainerNavigationViewHeader(int index);
+    void EnsureWidthPrefixSums();
 
     tracker_ref<winrt::ItemsSourceView> m_dataSource;
     // If the raw datasource is the same, we don't need to create new winrt::ItemsSourceView object.
@@ -81,5 +88,11 @@ private:
     winrt::event_token m_dataSourceChanged{};
     std::function<void(const winrt::NotifyCollectionChangedEventArgs& args)> m_dataChangeCallback;
     float m_overflowButtonCachedWidth{};
+
+    // Prefix sums of the cached item widths in raw data order, one per list: element i is the width of the items
+    // of that list in [0, i). They are rebuilt when the generation of the split data source changes.
+    std::vector<float> m_primaryWidthPrefixSums{};
+    std::vector<float> m_overflowWidthPrefixSums{};
+    uint64_t m_widthPrefixSumsGeneration{ std::numeric_limits<uint64_t>::max() };
 };
 
@@ -137,6 +137,12 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests.Common
             OnItemsSourceChanged(CollectionChangeEventArgsConverters.CreateNotifyArgs(NotifyCollectionChangedAction.Reset, -1, -1, -1, -1));
         }
 
+        public void Reverse(int index, int count)
+        {
+            Inner.Reverse(index, count);
+            OnItemsSourceChanged(CollectionChangeEventArgsConverters.CreateNotifyArgs(NotifyCollectionChangedAction.Reset, -1, -1, -1, -1));
+        }
+
         public new void Clear()
         {
             Inner.Clear();
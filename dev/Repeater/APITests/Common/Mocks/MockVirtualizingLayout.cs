@@ -3,6 +3,7 @@
 
 using System;
 using System.Collections.Generic;
+using System.Collections.Specialized;
 using Windows.Foundation;
 using Windows.UI.Xaml.Controls;
 
@@ -17,6 +18,7 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests.Common.Mocks
     {
         public Func<Size, VirtualizingLayoutContext, Size> MeasureLayoutFunc { get; set; }
         public Func<Size, VirtualizingLayoutContext, Size> ArrangeLayoutFunc { get; set; }
+        public Action<VirtualizingLayoutContext, object, NotifyCollectionChangedEventArgs> ItemsChangedFunc { get; set; }
 
         public new void InvalidateMeasure()
         {
@@ -32,5 +34,11 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests.Common.Mocks
         {
             return ArrangeLayoutFunc != null ? ArrangeLayoutFunc(finalSize, context) : default(Size);
         }
+
+        protected override void OnItemsChangedCore(VirtualizingLayoutContext context, object source, NotifyCollectionChangedEventArgs args)
+        {
+            ItemsChangedFunc?.Invoke(context, source, args);
+            base.OnItemsChangedCore(context, source, args);
+        }
     }
 }
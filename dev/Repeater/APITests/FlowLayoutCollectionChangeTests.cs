@@ -2,9 +2,11 @@
 // Licensed under the MIT License. See LICENSE in the project root for license information.
 
 using Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests.Common;
+using Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests.Common.Mocks;
 using MUXControlsTestApp.Utilities;
 using System;
 using System.Linq;
+using System.Collections.Specialized;
 using Windows.UI.Xaml;
 using Windows.UI.Xaml.Controls;
 using Windows.UI.Xaml.Input;
@@ -359,6 +361,62 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void CanMoveItemWithinRealizedRangeWithoutRecreatingContainers()
+        {
+            CustomItemsSource dataSource = null;
+            RunOnUIThread.Execute(() => dataSource = new CustomItemsSource(Enumerable.Range(0, 10).ToList()));
+            ItemsRepeater repeater = null;
+            int elementsCleared = 0;
+            int elementsPrepared = 0;
+
+            RunOnUIThread.Execute(() =>
+            {
+                repeater = SetupRepeater(dataSource);
+                repeater.ElementPrepared += (sender, args) => { elementsPrepared++; };
+                repeater.ElementClearing += (sender, args) => { elementsCleared++; };
+            });
+
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                var realized = VerifyRealizedRange(repeater, dataSource);
+                Verify.AreEqual(3, realized);
+
+                var first = repeater.TryGetElement(0);
+                var last = repeater.TryGetElement(2);
+
+                Log.Comment("Move forward in realized range.");
+                elementsPrepared = 0;
+                elementsCleared = 0;
+                dataSource.Move(oldIndex: 0, newIndex: 2, count: 1, reset: false);
+                repeater.UpdateLayout();
+
+                Verify.AreEqual(0, elementsPrepared);
+                Verify.AreEqual(0, elementsCleared);
+                Verify.AreSame(first, repeater.TryGetElement(2));
+                Verify.AreEqual(2, repeater.GetElementIndex(first));
+                Verify.AreSame(last, repeater.TryGetElement(1));
+                Verify.AreEqual(1, repeater.GetElementIndex(last));
+
+                realized = VerifyRealizedRange(repeater, dataSource);
+                Verify.AreEqual(3, realized);
+
+                Log.Comment("Move backward in realized range.");
+                dataSource.Move(oldIndex: 2, newIndex: 0, count: 1, reset: false);
+                repeater.UpdateLayout();
+
+                Verify.AreEqual(0, elementsPrepared);
+                Verify.AreEqual(0, elementsCleared);
+                Verify.AreSame(first, repeater.TryGetElement(0));
+                Verify.AreEqual(0, repeater.GetElementIndex(first));
+
+                realized = VerifyRealizedRange(repeater, dataSource);
+                Verify.AreEqual(3, realized);
+            });
+        }
+
         [TestMethod]
         public void VerifyElement0OwnershipInUniformGridLayout()
         {
@@ -469,6 +527,151 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void ValidateStableResetsKeepContainersOfKeptItems()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var dataSource = new CustomItemsSourceWithUniqueId(Enumerable.Range(0, 10).ToList());
+                var repeater = SetupRepeater(dataSource);
+                int elementsCleared = 0;
+                int elementsPrepared = 0;
+                repeater.ElementPrepared += (sender, args) => { elementsPrepared++; };
+                repeater.ElementClearing += (sender, args) => { elementsCleared++; };
+
+                var realized = VerifyRealizedRange(repeater, dataSource);
+                Verify.AreEqual(3, realized);
+                var first = repeater.TryGetElement(0);
+                var second = repeater.TryGetElement(1);
+
+                Log.Comment("Remove item 2 and reset");
+                dataSource.GetAtCallCount = 0;
+                dataSource.Remove(index: 2, count: 1, reset: true);
+                repeater.UpdateLayout();
+
+                // Only the item that moved into the realized range needs a new container.
+                Verify.AreEqual(1, dataSource.GetAtCallCount);
+                Verify.AreEqual(1, elementsPrepared);
+                Verify.AreEqual(1, elementsCleared);
+                Verify.AreSame(first, repeater.TryGetElement(0));
+                Verify.AreSame(second, repeater.TryGetElement(1));
+                realized = VerifyRealizedRange(repeater, dataSource);
+                Verify.AreEqual(3, realized);
+
+                Log.Comment("Insert an item at 0 and reset");
+                dataSource.Insert(index: 0, count: 1, reset: true, valueStart: 100);
+                repeater.UpdateLayout();
+
+                Verify.AreSame(first, repeater.TryGetElement(1));
+                Verify.AreEqual(1, repeater.GetElementIndex(first));
+                Verify.AreSame(second, repeater.TryGetElement(2));
+                Verify.AreEqual(2, repeater.GetElementIndex(second));
+                realized = VerifyRealizedRange(repeater, dataSource);
+                Verify.AreEqual(3, realized);
+            });
+        }
+
+        [TestMethod]
+        public void ValidateStableResetsReplayChangesWithTheirItems()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var dataSource = new CustomItemsSourceWithUniqueId(Enumerable.Range(0, 10).ToList());
+                var changes = new List<NotifyCollectionChangedEventArgs>();
+                var layout = new MockVirtualizingLayout()
+                {
+                    ItemsChangedFunc = (context, source, args) => changes.Add(args)
+                };
+                Content = new ItemsRepeater()
+                {
+                    ItemsSource = dataSource,
+                    Layout = layout
+                };
+                Content.UpdateLayout();
+                changes.Clear();
+
+                Log.Comment("Remove items 2 and 3 and reset");
+                dataSource.Remove(index: 2, count: 2, reset: true);
+                Verify.AreEqual(1, changes.Count);
+                Verify.AreEqual(NotifyCollectionChangedAction.Remove, changes[0].Action);
+                Verify.AreEqual(2, changes[0].OldStartingIndex);
+                Verify.AreEqual(2, changes[0].OldItems.Count);
+                // The removed items are no longer in the source, only how many there were is known.
+                Verify.IsNull(changes[0].OldItems[0]);
+                Verify.IsNull(changes[0].OldItems[1]);
+                changes.Clear();
+
+                Log.Comment("Insert two items at 1 and reset");
+                dataSource.Insert(index: 1, count: 2, reset: true, valueStart: 100);
+                Verify.AreEqual(1, changes.Count);
+                Verify.AreEqual(NotifyCollectionChangedAction.Add, changes[0].Action);
+                Verify.AreEqual(1, changes[0].NewStartingIndex);
+                Verify.AreEqual(2, changes[0].NewItems.Count);
+                Verify.AreEqual(100, (int)changes[0].NewItems[0]);
+                Verify.AreEqual(101, (int)changes[0].NewItems[1]);
+                changes.Clear();
+
+                Log.Comment("Move the first item to the end and reset");
+                dataSource.Move(oldIndex: 0, newIndex: 9, count: 1, reset: true);
+                Verify.AreEqual(1, changes.Count);
+                Verify.AreEqual(NotifyCollectionChangedAction.Move, changes[0].Action);
+                Verify.AreEqual(0, changes[0].OldStartingIndex);
+                Verify.AreEqual(9, changes[0].NewStartingIndex);
+                Verify.AreEqual(0, (int)changes[0].NewItems[0]);
+                Verify.AreEqual(0, (int)changes[0].OldItems[0]);
+
+                Log.Comment("Resets of a source too big to keep the keys of are passed on as such");
+                var bigDataSource = new CustomItemsSourceWithUniqueId(Enumerable.Range(0, 100001).ToList());
+                ((ItemsRepeater)Content).ItemsSource = bigDataSource;
+                Content.UpdateLayout();
+                changes.Clear();
+                bigDataSource.Remove(index: 2, count: 1, reset: true);
+                Verify.AreEqual(1, changes.Count);
+                Verify.AreEqual(NotifyCollectionChangedAction.Reset, changes[0].Action);
+            });
+        }
+
+        [TestMethod]
+        public void ValidateStableResetsOfBigSourcesKeepRealizedContainers()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var dataSource = new CustomItemsSourceWithUniqueId(Enumerable.Range(0, 12000).ToList());
+                var repeater = new ItemsRepeater()
+                {
+                    ItemsSource = dataSource,
+                    ItemTemplate = GetElementFactory(),
+                    Layout = new StackLayout(),
+                    VerticalCacheLength = 0,
+                    HorizontalCacheLength = 0
+                };
+                Content = new ItemsRepeaterScrollHost()
+                {
+                    Width = 200,
+                    Height = 200,
+                    ScrollViewer = new ScrollViewer { Content = repeater }
+                };
+                Content.UpdateLayout();
+
+                var first = repeater.TryGetElement(0);
+                var second = repeater.TryGetElement(1);
+                Verify.IsNotNull(first);
+                Verify.IsNotNull(second);
+
+                // Replaying this reset item by item would take thousands of moves.
+                Log.Comment("Reverse the items after the realized range and reset");
+                dataSource.Reverse(index: 100, count: 11900);
+                repeater.UpdateLayout();
+
+                Verify.AreSame(first, repeater.TryGetElement(0));
+                Verify.AreEqual(0, repeater.GetElementIndex(first));
+                Verify.AreSame(second, repeater.TryGetElement(1));
+                Verify.AreEqual(1, repeater.GetElementIndex(second));
+                Verify.AreEqual("0", ((TextBlock)first).Text);
+                Verify.AreEqual("1", ((TextBlock)second).Text);
+            });
+        }
+
         [TestMethod]
         public void ValidateRegularResets()
         {
@@ -482,6 +482,54 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void ValidateGridLayoutJustificationAcrossLines()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                foreach (ScrollOrientation scrollOrientation in Enum.GetValues(typeof(ScrollOrientation)))
+                {
+                    Log.Comment(string.Format("ScrollOrientation: {0}", scrollOrientation));
+                    var om = new OrientationBasedMeasures(scrollOrientation, useLayoutRounding: true);
+                    const int panelMinorSize = 500;
+                    const int numItems = 5;
+                    const int itemMinorSize = 200;
+                    const int itemMajorSize = 100;
+                    LayoutPanel panel = new LayoutPanel()
+                    {
+                        Layout = new UniformGridLayout()
+                        {
+                            Orientation = scrollOrientation.ToOrthogonalLayoutOrientation(),
+                            ItemsJustification = UniformGridLayoutItemsJustification.SpaceBetween,
+                            MinItemWidth = om.IsVerical ? itemMinorSize : itemMajorSize,
+                            MinItemHeight = om.IsVerical ? itemMajorSize : itemMinorSize
+                        }
+                    };
+
+                    SetPanelMinorSize(panel, om, panelMinorSize);
+                    for (int i = 0; i < numItems; i++)
+                    {
+                        panel.Children.Add(new Button() { Content = i });
+                    }
+
+                    Content = panel;
+                    Content.UpdateLayout();
+
+                    // Two items fit in a line, the last line only has one.
+                    ValidateChildBounds(
+                        panel,
+                        new List<Rect>()
+                        {
+                            om.MinorMajorRect(0, 0, itemMinorSize, itemMajorSize),
+                            om.MinorMajorRect(300, 0, itemMinorSize, itemMajorSize),
+                            om.MinorMajorRect(0, 100, itemMinorSize, itemMajorSize),
+                            om.MinorMajorRect(300, 100, itemMinorSize, itemMajorSize),
+                            om.MinorMajorRect(0, 200, itemMinorSize, itemMajorSize)
+                        });
+                }
+            });
+        }
+
         [TestMethod]
         public void ValidateGridLayoutMaximumRowsOrColumns()
         {
@@ -1436,6 +1484,151 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             Size
         }
 
+        [TestMethod]
+        public void ValidateStackLayoutExtentUsesMeasuredItemSizes()
+        {
+            // The first half of the items are much smaller than the second half. Once every item
+            // has been measured, the extent should be exact regardless of which items are realized.
+            const int numItems = 40;
+            const double smallItemSize = 20;
+            const double largeItemSize = 80;
+            const double expectedExtent = (numItems / 2) * (smallItemSize + largeItemSize);
+
+            ScrollViewer scrollViewer = null;
+            ItemsRepeater repeater = null;
+            var viewChangedEvent = new AutoResetEvent(false);
+
+            RunOnUIThread.Execute(() =>
+            {
+                var mapping = Enumerable.Range(0, numItems)
+                    .Select(i => new Border { Width = 100, Height = i < numItems / 2 ? smallItemSize : largeItemSize })
+                    .ToList();
+
+                repeater = new ItemsRepeater()
+                {
+                    ItemsSource = Enumerable.Range(0, numItems),
+                    ItemTemplate = MockElementFactory.CreateElementFactory(mapping),
+                    Layout = new StackLayout(),
+                    HorizontalCacheLength = 0,
+                    VerticalCacheLength = 0,
+                };
+
+                scrollViewer = new ScrollViewer()
+                {
+                    Content = repeater,
+                    Height = 200,
+                };
+
+                scrollViewer.ViewChanged += (sender, args) =>
+                {
+                    if (!args.IsIntermediate)
+                    {
+                        viewChangedEvent.Set();
+                    }
+                };
+
+                Content = new ItemsRepeaterScrollHost() { ScrollViewer = scrollViewer };
+                Content.UpdateLayout();
+            });
+
+            IdleSynchronizer.Wait();
+
+            // Walk through the whole list so that every item gets measured once, then go back to the top.
+            var offsets = Enumerable.Range(1, (int)(expectedExtent / 200)).Select(i => i * 200.0).Concat(new[] { 0.0 });
+            foreach (var offset in offsets)
+            {
+                RunOnUIThread.Execute(() =>
+                {
+                    scrollViewer.ChangeView(null, offset, null, true);
+                });
+
+                Verify.IsTrue(viewChangedEvent.WaitOne(DefaultWaitTime), "Waiting for ViewChanged.");
+                IdleSynchronizer.Wait();
+            }
+
+            RunOnUIThread.Execute(() =>
+            {
+                Verify.AreEqual(0, scrollViewer.VerticalOffset);
+                Verify.AreEqual(expectedExtent, repeater.DesiredSize.Height);
+            });
+        }
+
+        [TestMethod]
+        public void ValidateGridLayoutFarJumpRealizesOnlyTargetWindow()
+        {
+            const int numItems = 100000;
+            const int itemsPerRow = 4;
+            const double itemSize = 100;
+            const double targetOffset = 1000000;
+            var om = new OrientationBasedMeasures(ScrollOrientation.Vertical);
+
+            ItemsRepeater repeater = null;
+            ScrollViewer scrollViewer = null;
+            RecyclingElementFactoryDerived elementFactory = null;
+            int getElementCount = 0;
+            var viewChangedEvent = new AutoResetEvent(false);
+
+            RunOnUIThread.Execute(() =>
+            {
+                elementFactory = new RecyclingElementFactoryDerived()
+                {
+                    Templates = { { "key", GetDataTemplate(@"<Button Content='{Binding}' Width='100' Height='100'/>") } },
+                    RecyclePool = new RecyclePool(),
+                    GetElementFunc = (int index, UIElement owner, UIElement element) =>
+                    {
+                        getElementCount++;
+                        return element;
+                    }
+                };
+
+                Content = CreateAndInitializeRepeater
+                (
+                   om,
+                   itemsSource: Enumerable.Range(0, numItems),
+                   elementFactory: elementFactory,
+                   layout: new UniformGridLayout() { MinItemWidth = itemSize, MinItemHeight = itemSize },
+                   repeater: ref repeater,
+                   scrollViewer: ref scrollViewer
+                );
+
+                scrollViewer.ViewChanged += (sender, args) =>
+                {
+                    if (!args.IsIntermediate)
+                    {
+                        viewChangedEvent.Set();
+                    }
+                };
+
+                Content.UpdateLayout();
+            });
+
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                getElementCount = 0;
+                scrollViewer.ChangeView(null, targetOffset, null, true);
+            });
+
+            Verify.IsTrue(viewChangedEvent.WaitOne(DefaultWaitTime), "Waiting for ViewChanged.");
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                // The anchor row for the new window is computed directly, so only the rows around the
+                // new viewport get realized instead of every row between the old and the new viewport.
+                Log.Comment("Elements requested during the jump: " + getElementCount);
+                Verify.IsLessThan(getElementCount, 40);
+
+                var firstExpectedIndex = (int)(targetOffset / itemSize) * itemsPerRow;
+                var observedIndices = new List<int>(elementFactory.RealizedElementIndices);
+                observedIndices.Remove(0);
+                Verify.IsGreaterThan(observedIndices.Count, 0);
+                Verify.IsTrue(observedIndices.All(index => index >= firstExpectedIndex - itemsPerRow));
+                Verify.AreEqual(numItems / itemsPerRow * itemSize, repeater.DesiredSize.Height);
+            });
+        }
+
         private void ValidateStackLayoutChildrenLayoutBounds(
             OrientationBasedMeasures om,
             Func<int, UIElement> elementAtIndexFunc,
@@ -7,6 +7,7 @@ using System.Collections;
 using System.Collections.Generic;
 using System.Collections.ObjectModel;
 using System.Collections.Specialized;
+using System.Diagnostics;
 using System.Linq;
 using Windows.Foundation.Collections;
 using Windows.UI.Xaml.Controls;
@@ -153,6 +154,57 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void VerifyIterableIsEnumeratedOnce()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                const int numItems = 100000;
+                int enumeratedCount = 0;
+                var data = Enumerable.Range(0, numItems).Select(i =>
+                {
+                    enumeratedCount++;
+                    return (object)new DataItem(i);
+                });
+
+                // The size of an iterable is only known once it has been enumerated to its end,
+                // which happens in a single pass when the data source is created.
+                var dataSource = new ItemsSourceView(data);
+                Verify.AreEqual(numItems, enumeratedCount);
+
+                Verify.AreEqual(numItems, dataSource.Count);
+                Verify.AreEqual(10, ((DataItem)dataSource.GetAt(10)).Index);
+
+                var item = dataSource.GetAt(numItems / 2);
+                Verify.AreEqual(numItems / 2, dataSource.IndexOf(item));
+                Verify.AreEqual(-1, dataSource.IndexOf(new DataItem(1)));
+                Verify.AreEqual(numItems, enumeratedCount);
+            });
+        }
+
+        [TestMethod]
+        public void VerifyReadOnlyListIsSnapshotted()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var items = Enumerable.Range(0, 10).Select(i => (object)new DataItem(i)).ToList();
+                var dataSource = new ItemsSourceView(new ReadOnlyListWithoutNotifications(items));
+                Verify.AreEqual(10, dataSource.Count);
+
+                // The list does not tell anyone that it changed, so the data source has to
+                // keep showing what it had when it was created.
+                var removedItem = items[0];
+                items.RemoveAt(0);
+                items.Add(new DataItem(100));
+
+                Verify.AreEqual(10, dataSource.Count);
+                Verify.AreSame(removedItem, dataSource.GetAt(0));
+                Verify.AreEqual(9, ((DataItem)dataSource.GetAt(9)).Index);
+                Verify.AreEqual(0, dataSource.IndexOf(removedItem));
+                Verify.AreEqual(-1, dataSource.IndexOf(items[9]));
+            });
+        }
+
         // Calling Reset multiple times before layout runs causes a crash
         // in unique ids. We end up thinking we have multiple elements with the same id.
         [TestMethod]
@@ -419,6 +471,38 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             }
         }
 
+        class DataItem
+        {
+            public DataItem(int index) { Index = index; }
+
+            public int Index { get; private set; }
+        }
+
+        // Only IReadOnlyList, so that it is seen as an IVectorView rather than as an IBindableVector.
+        class ReadOnlyListWithoutNotifications : IReadOnlyList<object>
+        {
+            private List<object> items;
+
+            public ReadOnlyListWithoutNotifications(List<object> items)
+            {
+                this.items = items;
+            }
+
+            public object this[int index] => items[index];
+
+            public int Count => items.Count;
+
+            public IEnumerator<object> GetEnumerator()
+            {
+                return items.GetEnumerator();
+            }
+
+            IEnumerator IEnumerable.GetEnumerator()
+            {
+                return items.GetEnumerator();
+            }
+        }
+
         class CustomEnumerable : IEnumerable<object>
         {
             private List<string> myList = new List<string>();
@@ -6,6 +6,7 @@ using MUXControlsTestApp.Utilities;
 using System.Collections.Generic;
 using System.Linq;
 using System.Runtime.InteropServices;
+using System.Threading;
 using Windows.UI.Xaml;
 using Windows.UI.Xaml.Controls;
 using Windows.UI.Xaml.Markup;
@@ -107,6 +108,143 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void ValidatePrewarmingCounters()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var elementFactory = new RecyclingElementFactory()
+                {
+                    RecyclePool = new RecyclePool(),
+                };
+                elementFactory.Templates["key"] = (DataTemplate)XamlReader.Load(
+                    @"<DataTemplate  xmlns='http://schemas.microsoft.com/winfx/2006/xaml/presentation'>
+                        <TextBlock />
+                    </DataTemplate>");
+
+                Verify.IsFalse(elementFactory.IsPrewarmingEnabled);
+                Verify.AreEqual(20u, elementFactory.MaxPrewarmedElements);
+                elementFactory.IsPrewarmingEnabled = true;
+                elementFactory.MaxPrewarmedElements = 5;
+                Verify.AreEqual(5u, elementFactory.MaxPrewarmedElements);
+
+                ItemsRepeater repeater = new ItemsRepeater()
+                {
+                    ItemsSource = Enumerable.Range(0, 10),
+                    ItemTemplate = elementFactory,
+                };
+
+                var context = (ElementFactoryGetArgs)RepeaterTestHooks.CreateRepeaterElementFactoryGetArgs();
+                context.Parent = repeater;
+                var clearContext = (ElementFactoryRecycleArgs)RepeaterTestHooks.CreateRepeaterElementFactoryRecycleArgs();
+                clearContext.Parent = repeater;
+
+                context.Data = 0;
+                var element0 = elementFactory.GetElement(context);
+                context.Data = 1;
+                var element1 = elementFactory.GetElement(context);
+                clearContext.Element = element0;
+                elementFactory.RecycleElement(clearContext);
+                context.Data = 2;
+                Verify.AreSame(element0, elementFactory.GetElement(context));
+
+                // The repeater is not scrolling, so nothing is prewarmed and recycling is not an avoided cold creation.
+                var counters = RepeaterTestHooks.GetRecyclingElementFactoryPrewarmCounters(elementFactory);
+                Verify.AreEqual(2L, counters.ColdCreations);
+                Verify.AreEqual(0L, counters.PrewarmedElements);
+                Verify.AreEqual(0L, counters.AvoidedColdCreations);
+                Verify.AreEqual(0.0, counters.AvoidedColdCreationsPerSecond);
+
+                RepeaterTestHooks.ResetRecyclingElementFactoryPrewarmCounters(elementFactory);
+                counters = RepeaterTestHooks.GetRecyclingElementFactoryPrewarmCounters(elementFactory);
+                Verify.AreEqual(0L, counters.ColdCreations);
+            });
+        }
+
+        [TestMethod]
+        public void ValidatePrewarmingWhileScrolling()
+        {
+            RecyclingElementFactory elementFactory = null;
+            Windows.UI.Xaml.Controls.ScrollViewer scrollViewer = null;
+            EventHandler<object> renderingHandler = null;
+            var scrolledToEndEvent = new ManualResetEvent(false);
+
+            RunOnUIThread.Execute(() =>
+            {
+                elementFactory = new RecyclingElementFactory()
+                {
+                    RecyclePool = new RecyclePool(),
+                    IsPrewarmingEnabled = true,
+                };
+                elementFactory.Templates["visible"] = (DataTemplate)XamlReader.Load(
+                    @"<DataTemplate  xmlns='http://schemas.microsoft.com/winfx/2006/xaml/presentation'>
+                        <TextBlock Height='50' />
+                    </DataTemplate>");
+                elementFactory.Templates["offscreen"] = (DataTemplate)XamlReader.Load(
+                    @"<DataTemplate  xmlns='http://schemas.microsoft.com/winfx/2006/xaml/presentation'>
+                        <TextBlock Height='50' />
+                    </DataTemplate>");
+
+                // Only the items past the first viewport use the offscreen template, so none of
+                // its elements exist until the repeater scrolls to them.
+                elementFactory.SelectTemplateKey +=
+                delegate (RecyclingElementFactory sender, SelectTemplateEventArgs args)
+                {
+                    args.TemplateKey = (int)args.DataContext < 10 ? "visible" : "offscreen";
+                };
+
+                ItemsRepeater repeater = null;
+                var host = CreateAndInitializeRepeater
+                (
+                    itemsSource: Enumerable.Range(0, 100),
+                    elementFactory: elementFactory,
+                    layout: new StackLayout(),
+                    repeater: ref repeater
+                );
+                repeater.VerticalCacheLength = 0;
+                scrollViewer = host.ScrollViewer;
+                Content = host;
+                Content.UpdateLayout();
+
+                var counters = RepeaterTestHooks.GetRecyclingElementFactoryPrewarmCounters(elementFactory);
+                Verify.AreEqual(0L, counters.PrewarmedElements);
+                Verify.AreEqual(0L, counters.AvoidedColdCreations);
+            });
+
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                // Scroll by one item per frame so that the repeater reports a scroll velocity.
+                renderingHandler = (sender, args) =>
+                {
+                    if (scrollViewer.VerticalOffset >= scrollViewer.ScrollableHeight)
+                    {
+                        CompositionTarget.Rendering -= renderingHandler;
+                        scrolledToEndEvent.Set();
+                    }
+                    else
+                    {
+                        scrollViewer.ChangeView(null, scrollViewer.VerticalOffset + 50, null, disableAnimation: true);
+                    }
+                };
+                CompositionTarget.Rendering += renderingHandler;
+            });
+
+            Verify.IsTrue(scrolledToEndEvent.WaitOne(DefaultWaitTimeInMS), "Waiting for the scroll to reach the end");
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                var counters = RepeaterTestHooks.GetRecyclingElementFactoryPrewarmCounters(elementFactory);
+                Log.Comment("ColdCreations: " + counters.ColdCreations +
+                    ", PrewarmedElements: " + counters.PrewarmedElements +
+                    ", AvoidedColdCreations: " + counters.AvoidedColdCreations);
+                Verify.IsGreaterThan(counters.PrewarmedElements, 0L);
+                Verify.IsGreaterThan(counters.AvoidedColdCreations, 0L);
+            });
+        }
+
         // Validate data context propagation and template selection
         [TestMethod]
         public void ValidateBindingAndTemplateSelection()
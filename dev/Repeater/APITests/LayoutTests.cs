@@ -7,6 +7,7 @@ using MUXControlsTestApp.Utilities;
 using System;
 using System.Collections.Generic;
 using System.Collections.ObjectModel;
+using System.Diagnostics;
 using System.Linq;
 using System.Threading;
 using Windows.Foundation;
@@ -253,6 +254,55 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        // Logs the time of a measure pass against the number of realized elements. The realized
+        // range is grown through the cache length so that the viewport stays the same.
+        [TestMethod]
+        public void MeasureTimeAgainstRealizedCount()
+        {
+            const int measureCount = 20;
+            var realizedCounts = new List<int>();
+            foreach (var cacheLength in new[] { 1.0, 5.0, 20.0 })
+            {
+                ItemsRepeater repeater = null;
+                ScrollViewer scrollViewer = null;
+                RunOnUIThread.Execute(() =>
+                {
+                    var host = CreateAndInitializeRepeater(
+                        Enumerable.Range(0, 10000),
+                        new StackLayout(),
+                        GetDataTemplate("<Border Height='2' />"),
+                        ref repeater,
+                        ref scrollViewer);
+                    repeater.VerticalCacheLength = cacheLength;
+                    Content = host;
+                    Content.UpdateLayout();
+                });
+
+                // Let the cache buffer fill up.
+                IdleSynchronizer.Wait();
+
+                RunOnUIThread.Execute(() =>
+                {
+                    var stopwatch = Stopwatch.StartNew();
+                    for (int i = 0; i < measureCount; i++)
+                    {
+                        repeater.InvalidateMeasure();
+                        repeater.UpdateLayout();
+                    }
+                    stopwatch.Stop();
+
+                    var realizedCount = repeater.Children.Count;
+                    realizedCounts.Add(realizedCount);
+                    Log.Comment(string.Format("Cache length {0}: {1} realized elements, {2:F3}ms per measure.",
+                        cacheLength,
+                        realizedCount,
+                        stopwatch.Elapsed.TotalMilliseconds / measureCount));
+                });
+            }
+
+            Verify.IsTrue(realizedCounts[0] < realizedCounts[1] && realizedCounts[1] < realizedCounts[2]);
+        }
+
         private ItemsRepeaterScrollHost CreateAndInitializeRepeater(
            object itemsSource,
            VirtualizingLayout layout,
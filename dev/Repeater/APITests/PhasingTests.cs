@@ -53,6 +53,8 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
 
             RunOnUIThread.Execute(() =>
             {
+                RepeaterTestHooks.ResetBuildTreeSchedulerCounters();
+
                 var itemTemplate = (DataTemplate)XamlReader.Load(
                        @"<DataTemplate  xmlns='http://schemas.microsoft.com/winfx/2006/xaml/presentation'>
                             <Button Width='100' Height='100'/>
@@ -108,6 +110,30 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
                     }
 
                     ElementPhasingManager.ProcessedCalls.Clear();
+
+                    // Every phase after the first one was scheduled as work
+                    var counters = RepeaterTestHooks.GetBuildTreeSchedulerCounters();
+                    Log.Comment("Frames: {0}, work: {1}, deferred: {2}, overruns: {3}, budget: {4}ms, frame interval: {5}ms",
+                        counters.FrameCount, counters.WorkCount, counters.DeferredWorkCount, counters.BudgetOverrunCount, counters.BudgetInMs, counters.FrameIntervalInMs);
+                    Verify.IsGreaterThan(counters.FrameCount, 0L);
+                    Verify.IsGreaterThanOrEqual(counters.WorkCount, counters.FrameCount);
+                    Verify.IsLessThanOrEqual(counters.BudgetOverrunCount, counters.FrameCount);
+                    Verify.IsGreaterThan(counters.BudgetInMs, 0.0);
+                    Verify.IsLessThanOrEqual(counters.BudgetInMs, 40.0);
+
+                    // Every realized element ran its last phase, its latency is from its realization until then.
+                    var phaserCounters = RepeaterTestHooks.GetPhaserCounters(repeater);
+                    Log.Comment("Completed: {0}, abandoned: {1}, pending: {2}, last latency: {3}ms, max latency: {4}ms, average latency: {5}ms",
+                        phaserCounters.CompletedElements, phaserCounters.AbandonedElements, phaserCounters.PendingElements,
+                        phaserCounters.LastLatencyInMs, phaserCounters.MaxLatencyInMs, phaserCounters.AverageLatencyInMs);
+                    Verify.AreEqual(0, phaserCounters.PendingElements);
+                    Verify.IsGreaterThanOrEqual(phaserCounters.CompletedElements, 9L);
+                    Verify.IsGreaterThan(phaserCounters.MaxLatencyInMs, 0.0);
+                    Verify.IsLessThanOrEqual(phaserCounters.LastLatencyInMs, phaserCounters.MaxLatencyInMs);
+                    Verify.IsLessThanOrEqual(phaserCounters.AverageLatencyInMs, phaserCounters.MaxLatencyInMs);
+
+                    RepeaterTestHooks.ResetPhaserCounters(repeater);
+                    Verify.AreEqual(0L, RepeaterTestHooks.GetPhaserCounters(repeater).CompletedElements);
                 });
             }
             else
@@ -26,6 +26,7 @@ using ItemsRepeater = Microsoft.UI.Xaml.Controls.ItemsRepeater;
 using RecyclePool = Microsoft.UI.Xaml.Controls.RecyclePool;
 using StackLayout = Microsoft.UI.Xaml.Controls.StackLayout;
 using ItemsRepeaterScrollHost = Microsoft.UI.Xaml.Controls.ItemsRepeaterScrollHost;
+using RepeaterTestHooks = Microsoft.UI.Private.Controls.RepeaterTestHooks;
 
 namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
 {
@@ -102,6 +103,65 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void ValidateCapacityEvictionAndCounters()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                RecyclePool pool = new RecyclePool() { MaxElementsPerKey = 2, MaxElements = 3 };
+                var owner = new StackPanel();
+                var otherOwner = new StackPanel();
+                var buttons = Enumerable.Range(0, 3).Select(i => new Button()).ToList();
+                foreach (var button in buttons)
+                {
+                    owner.Children.Add(button);
+                    pool.PutElement(button, "Button", owner);
+                }
+
+                // The least recently put element went over the per key capacity and left its owner.
+                var counters = RepeaterTestHooks.GetRecyclePoolCounters(pool);
+                Verify.AreEqual(1L, counters.Evictions);
+                Verify.AreEqual(2, counters.ElementCount);
+                Verify.AreEqual(-1, owner.Children.IndexOf(buttons[0]));
+
+                // Going over the total capacity evicts the least recently put element of any key.
+                var textBlocks = new[] { new TextBlock(), new TextBlock() };
+                pool.PutElement(textBlocks[0], "TextBlock");
+                pool.PutElement(textBlocks[1], "TextBlock");
+                counters = RepeaterTestHooks.GetRecyclePoolCounters(pool);
+                Verify.AreEqual(2L, counters.Evictions);
+                Verify.AreEqual(3, counters.ElementCount);
+                Verify.AreEqual(-1, owner.Children.IndexOf(buttons[1]));
+
+                // Elements of the same owner come first, most recently put first.
+                Verify.AreSame(buttons[2], pool.TryGetElement("Button", owner));
+                Verify.AreSame(textBlocks[1], pool.TryGetElement("TextBlock", otherOwner));
+                Verify.IsNull(pool.TryGetElement("Button", owner));
+
+                // An element given to another owner is removed from its previous owner.
+                pool.PutElement(buttons[2], "Button", owner);
+                Verify.AreSame(buttons[2], pool.TryGetElement("Button", otherOwner));
+                Verify.AreEqual(-1, owner.Children.IndexOf(buttons[2]));
+
+                counters = RepeaterTestHooks.GetRecyclePoolCounters(pool);
+                Verify.AreEqual(3L, counters.Hits);
+                Verify.AreEqual(1L, counters.Misses);
+                Verify.AreEqual(1L, counters.Reparents);
+                Verify.AreEqual(1, counters.ElementCount);
+
+                // Lowering the capacity trims the pool right away.
+                pool.MaxElements = 0;
+                counters = RepeaterTestHooks.GetRecyclePoolCounters(pool);
+                Verify.AreEqual(3L, counters.Evictions);
+                Verify.AreEqual(0, counters.ElementCount);
+
+                RepeaterTestHooks.ResetRecyclePoolCounters(pool);
+                counters = RepeaterTestHooks.GetRecyclePoolCounters(pool);
+                Verify.AreEqual(0L, counters.Hits);
+                Verify.AreEqual(0L, counters.Evictions);
+            });
+        }
+
         // Validate that if the pool has an element for the requested owner,
         // then that is given preference over other elements.
         [TestMethod]
@@ -25,6 +25,7 @@ using SelectionModel = Microsoft.UI.Xaml.Controls.SelectionModel;
 using IndexPath = Microsoft.UI.Xaml.Controls.IndexPath;
 using SelectionModelSelectionChangedEventArgs = Microsoft.UI.Xaml.Controls.SelectionModelSelectionChangedEventArgs;
 using SelectionModelChildrenRequestedEventArgs = Microsoft.UI.Xaml.Controls.SelectionModelChildrenRequestedEventArgs;
+using RepeaterTestHooks = Microsoft.UI.Private.Controls.RepeaterTestHooks;
 
 namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
 {
@@ -273,6 +274,113 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void ValidateSelectedIndicesAndItemsRandomAccess()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                SelectionModel selectionModel = new SelectionModel();
+                Log.Comment("Setting the source");
+                selectionModel.Source = Enumerable.Range(0, 20).ToList();
+
+                Log.Comment("Selecting overlapping and adjacent ranges out of order");
+                selectionModel.SelectRange(Path(10), Path(12));
+                selectionModel.SelectRange(Path(2), Path(5));
+                selectionModel.SelectRange(Path(4), Path(6));
+                Select(selectionModel, 7, true);
+                Select(selectionModel, 18, true);
+                Select(selectionModel, 3, false);
+
+                var expectedIndices = new List<int>() { 2, 4, 5, 6, 7, 10, 11, 12, 18 };
+                Verify.AreEqual(expectedIndices.Count, selectionModel.SelectedIndices.Count);
+                Verify.AreEqual(expectedIndices.Count, selectionModel.SelectedItems.Count);
+
+                // Read in reverse so that every access is a random access into the selection.
+                for (int i = expectedIndices.Count - 1; i >= 0; i--)
+                {
+                    Verify.AreEqual(0, selectionModel.SelectedIndices[i].CompareTo(Path(expectedIndices[i])));
+                    Verify.AreEqual(expectedIndices[i], (int)selectionModel.SelectedItems[i]);
+                }
+
+                Verify.AreEqual(2, selectionModel.SelectedIndex.GetAt(0));
+                Verify.AreEqual(2, (int)selectionModel.SelectedItem);
+
+                Log.Comment("Enumerating the selection");
+                Verify.IsTrue(expectedIndices.SequenceEqual(selectionModel.SelectedItems.Select(item => (int)item)));
+                Verify.IsTrue(expectedIndices.SequenceEqual(selectionModel.SelectedIndices.Select(index => index.GetAt(0))));
+
+                Log.Comment("Selecting across groups of a nested source");
+                selectionModel.Source = CreateNestedData(1 /* levels */ , 3 /* groupsAtLevel */, 4 /* countAtLeaf */);
+                Select(selectionModel, 2, 1, true);
+                Select(selectionModel, 0, 3, true);
+                Select(selectionModel, 0, 1, true);
+
+                var expectedPaths = new List<IndexPath>() { Path(0, 1), Path(0, 3), Path(2, 1) };
+                Verify.AreEqual(expectedPaths.Count, selectionModel.SelectedIndices.Count);
+                for (int i = expectedPaths.Count - 1; i >= 0; i--)
+                {
+                    Verify.AreEqual(0, selectionModel.SelectedIndices[i].CompareTo(expectedPaths[i]));
+                }
+            });
+        }
+
+        [TestMethod]
+        public void ValidateSelectedIndicesAndItemsIndexOfAndGetMany()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                SelectionModel selectionModel = new SelectionModel();
+                selectionModel.Source = Enumerable.Range(0, 20).ToList();
+
+                // Selected ranges are [2], [4, 7], [10, 12] and [18].
+                Select(selectionModel, 2, true);
+                selectionModel.SelectRange(Path(4), Path(7));
+                selectionModel.SelectRange(Path(10), Path(12));
+                Select(selectionModel, 18, true);
+
+                Log.Comment("IndexOf hits");
+                Verify.AreEqual(0, RepeaterTestHooks.SelectedItemsIndexOf(selectionModel, 2));
+                Verify.AreEqual(5, RepeaterTestHooks.SelectedItemsIndexOf(selectionModel, 10));
+                Verify.AreEqual(8, RepeaterTestHooks.SelectedItemsIndexOf(selectionModel, 18));
+                Verify.AreEqual(3, RepeaterTestHooks.SelectedIndicesIndexOf(selectionModel, Path(6)));
+                Verify.AreEqual(7, RepeaterTestHooks.SelectedIndicesIndexOf(selectionModel, Path(12)));
+
+                Log.Comment("IndexOf misses");
+                Verify.AreEqual(-1, RepeaterTestHooks.SelectedItemsIndexOf(selectionModel, 3));
+                Verify.AreEqual(-1, RepeaterTestHooks.SelectedItemsIndexOf(selectionModel, 100));
+                Verify.AreEqual(-1, RepeaterTestHooks.SelectedIndicesIndexOf(selectionModel, Path(9)));
+                Verify.AreEqual(-1, RepeaterTestHooks.SelectedIndicesIndexOf(selectionModel, Path(19)));
+                Verify.AreEqual(-1, RepeaterTestHooks.SelectedIndicesIndexOf(selectionModel, Path(4, 0)));
+
+                Log.Comment("GetMany from an offset spanning several ranges");
+                var items = RepeaterTestHooks.SelectedItemsGetMany(selectionModel, 3 /* startIndex */, 5 /* capacity */);
+                Verify.IsTrue(new List<int>() { 6, 7, 10, 11, 12 }.SequenceEqual(items.Select(item => (int)item)));
+                var indices = RepeaterTestHooks.SelectedIndicesGetMany(selectionModel, 3 /* startIndex */, 5 /* capacity */);
+                Verify.IsTrue(new List<int>() { 6, 7, 10, 11, 12 }.SequenceEqual(indices.Select(index => index.GetAt(0))));
+
+                Log.Comment("GetMany past the end of the selection");
+                items = RepeaterTestHooks.SelectedItemsGetMany(selectionModel, 6 /* startIndex */, 10 /* capacity */);
+                Verify.IsTrue(new List<int>() { 11, 12, 18 }.SequenceEqual(items.Select(item => (int)item)));
+                Verify.AreEqual(0, RepeaterTestHooks.SelectedIndicesGetMany(selectionModel, 9 /* startIndex */, 10 /* capacity */).Count);
+
+                Log.Comment("Nested source");
+                selectionModel.Source = CreateNestedData(1 /* levels */ , 3 /* groupsAtLevel */, 4 /* countAtLeaf */);
+                Select(selectionModel, 0, 1, true);
+                Select(selectionModel, 0, 2, true);
+                Select(selectionModel, 2, 0, true);
+                Select(selectionModel, 2, 3, true);
+
+                Verify.AreEqual(2, RepeaterTestHooks.SelectedIndicesIndexOf(selectionModel, Path(2, 0)));
+                Verify.AreEqual(-1, RepeaterTestHooks.SelectedIndicesIndexOf(selectionModel, Path(1, 1)));
+                Verify.AreEqual(-1, RepeaterTestHooks.SelectedIndicesIndexOf(selectionModel, Path(2)));
+
+                indices = RepeaterTestHooks.SelectedIndicesGetMany(selectionModel, 1 /* startIndex */, 2 /* capacity */);
+                Verify.AreEqual(2, indices.Count);
+                Verify.AreEqual(0, indices[0].CompareTo(Path(0, 2)));
+                Verify.AreEqual(0, indices[1].CompareTo(Path(2, 0)));
+            });
+        }
+
         [TestMethod]
         public void ValidateNestedSingleSelection()
         {
@@ -519,6 +627,48 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests.RepeaterTests
             });
         }
 
+        [TestMethod]
+        public void ValidateScatteredSelectionWithInsertsAndRemoves()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                // Large enough for the selection to span several storage chunks.
+                const int itemCount = 70000;
+                var data = new ObservableCollection<int>(Enumerable.Range(0, itemCount));
+                var selectionModel = new SelectionModel();
+                selectionModel.Source = data;
+
+                Log.Comment("Selecting every other item");
+                for (int i = 0; i < itemCount; i += 2)
+                {
+                    selectionModel.Select(i);
+                }
+
+                Verify.AreEqual(itemCount / 2, selectionModel.SelectedIndices.Count);
+                Verify.AreEqual(0, selectionModel.SelectedIndices[0].GetAt(0));
+                Verify.AreEqual(itemCount - 2, selectionModel.SelectedIndices[itemCount / 2 - 1].GetAt(0));
+
+                Log.Comment("Inserting an item in the middle of the selection");
+                data.Insert(65535, -1);
+                Verify.AreEqual(itemCount / 2, selectionModel.SelectedIndices.Count);
+                Verify.IsTrue(selectionModel.IsSelected(65534).Value);
+                Verify.IsFalse(selectionModel.IsSelected(65535).Value);
+                Verify.IsFalse(selectionModel.IsSelected(65536).Value);
+                Verify.IsTrue(selectionModel.IsSelected(65537).Value);
+                Verify.AreEqual(65537, selectionModel.SelectedIndices[65536 / 2].GetAt(0));
+                Verify.AreEqual(65536, (int)selectionModel.SelectedItems[65536 / 2]);
+
+                Log.Comment("Removing a selected item near the start");
+                data.RemoveAt(10);
+                Verify.AreEqual(itemCount / 2 - 1, selectionModel.SelectedIndices.Count);
+                Verify.IsFalse(selectionModel.IsSelected(10).Value);
+                Verify.IsTrue(selectionModel.IsSelected(11).Value);
+                Verify.AreEqual(12, (int)selectionModel.SelectedItems[5]);
+                Verify.AreEqual(65536, selectionModel.SelectedIndices[65536 / 2 - 1].GetAt(0));
+                Verify.AreEqual(itemCount - 2, (int)selectionModel.SelectedItems[itemCount / 2 - 2]);
+            });
+        }
+
         [TestMethod]
         public void ValidateGroupInserts()
         {
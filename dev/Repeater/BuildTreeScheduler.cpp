@@ -6,19 +6,26 @@
 #include "QPCTimer.h"
 #include "BuildTreeScheduler.h"
 #include "RepeaterTestHooks.h"
+#include "RepeaterTrace.h"
+#include <algorithm>
 
-double BuildTreeScheduler::m_budgetInMs = 40.0;
 thread_local QPCTimer BuildTreeScheduler::m_timer{};
 thread_local std::vector<WorkInfo> BuildTreeScheduler::m_pendingWork{};
+thread_local uint64_t BuildTreeScheduler::m_nextSequence{ 0 };
 thread_local winrt::event_token BuildTreeScheduler::m_renderingToken{};
+thread_local winrt::TimeSpan BuildTreeScheduler::m_lastRenderingTime{};
+thread_local double BuildTreeScheduler::m_frameIntervalInMs{ BuildTreeScheduler::c_defaultFrameIntervalInMs };
+thread_local double BuildTreeScheduler::m_budgetInMs{ BuildTreeScheduler::c_defaultFrameIntervalInMs * BuildTreeScheduler::c_budgetFrameShare };
+thread_local BuildTreeScheduler::WorkCounters BuildTreeScheduler::m_counters{};
 
-void BuildTreeScheduler::RegisterWork(int priority, const std::function<void()>& workFunc)
+void BuildTreeScheduler::RegisterWork(int priority, WorkInfo::WorkFunc workFunc, void* context)
 {
     MUX_ASSERT(priority >= 0);
     MUX_ASSERT(workFunc != nullptr);
 
     QueueTick();
-    m_pendingWork.push_back(WorkInfo(priority, workFunc));
+    m_pendingWork.emplace_back(priority, m_nextSequence++, workFunc, context);
+    std::push_heap(m_pendingWork.begin(), m_pendingWork.end(), IsLowerPriority);
 }
 
 bool BuildTreeScheduler::ShouldYield()
@@ -26,20 +33,49 @@ bool BuildTreeScheduler::ShouldYield()
     return m_timer.DurationInMilliSeconds() > m_budgetInMs;
 }
 
-void BuildTreeScheduler::OnRendering(const winrt::IInspectable&, const winrt::IInspectable&)
+BuildTreeScheduler::WorkCounters BuildTreeScheduler::Counters()
 {
-    const bool budgetReached = ShouldYield();
-    if (!budgetReached && m_pendingWork.size() > 0)
+    auto counters = m_counters;
+    counters.BudgetInMs = m_budgetInMs;
+    counters.FrameIntervalInMs = m_frameIntervalInMs;
+    return counters;
+}
+
+void BuildTreeScheduler::ResetCounters()
+{
+    m_counters = {};
+}
+
+void BuildTreeScheduler::OnRendering(const winrt::IInspectable&, const winrt::IInspectable& args)
+{
+    // The budget is measured from the start of this tick.
+    m_timer.Reset();
+    UpdateBudget(args.as<winrt::Windows::UI::Xaml::Media::RenderingEventArgs>().RenderingTime());
+
+    // Work registered while this tick runs waits for the next one.
+    const size_t workCountAtStart = m_pendingWork.size();
+    uint32_t workCount = 0;
+    while (workCount < workCountAtStart && !m_pendingWork.empty() && !ShouldYield())
     {
-        // Sort in descending order of priority and work from the end of the list to avoid moving around during erase.
-        std::sort(m_pendingWork.begin(), m_pendingWork.end(), [](const auto& lhs, const auto& rhs) { return lhs.Priority() > rhs.Priority(); });
-        int currentIndex = static_cast<int>(m_pendingWork.size()) - 1;
+        std::pop_heap(m_pendingWork.begin(), m_pendingWork.end(), IsLowerPriority);
+        const WorkInfo work = m_pendingWork.back();
+        m_pendingWork.pop_back();
 
-        do
+        work.InvokeWorkFunc();
+        workCount++;
+    }
+
+    if (workCountAtStart > 0)
+    {
+        m_counters.FrameCount++;
+        m_counters.WorkCount += workCount;
+        m_counters.LastFrameWorkCount = workCount;
+        m_counters.DeferredWorkCount += m_pendingWork.size();
+        if (ShouldYield())
         {
-            m_pendingWork[currentIndex].InvokeWorkFunc();
-            m_pendingWork.erase(m_pendingWork.begin() + currentIndex);
-        } while (--currentIndex >= 0 && !ShouldYield());
+            m_counters.BudgetOverrunCount++;
+            REPEATER_TRACE_INFO(L"BuildTreeScheduler: %d work items ran past the %.1fms budget. \n", workCount, m_budgetInMs);
+        }
     }
 
     if (m_pendingWork.empty())
@@ -48,11 +84,10 @@ void BuildTreeScheduler::OnRendering(const winrt::IInspectable&, const winrt::II
         // call the event at 60 frames per second
         winrt::Windows::UI::Xaml::Media::CompositionTarget::CompositionTarget::Rendering(m_renderingToken);
         m_renderingToken.value = 0;
+        // The next tick comes after some idle time, don't measure it as a frame interval.
+        m_lastRenderingTime = {};
         RepeaterTestHooks::NotifyBuildTreeCompleted();
     }
-
-    // Reset the timer so it snaps the time just before rendering
-    m_timer.Reset();
 }
 
 void  BuildTreeScheduler::QueueTick()
@@ -62,3 +97,30 @@ void  BuildTreeScheduler::QueueTick()
         m_renderingToken = winrt::Windows::UI::Xaml::Media::CompositionTarget::Rendering(OnRendering);
     }
 }
+
+void BuildTreeScheduler::UpdateBudget(const winrt::TimeSpan& renderingTime)
+{
+    if (m_lastRenderingTime.count() != 0)
+    {
+        const double intervalInMs = std::chrono::duration<double, std::milli>(renderingTime - m_lastRenderingTime).count();
+        if (intervalInMs > 0.0 && intervalInMs <= c_maxFrameIntervalInMs)
+        {
+            // Follow shorter intervals quickly and longer ones slowly. A dropped frame makes one interval
+            // longer without the refresh rate changing, and should not grow the budget which would then
+            // drop even more frames.
+            const double weight = intervalInMs < m_frameIntervalInMs ? 0.5 : 0.05;
+            m_frameIntervalInMs += (intervalInMs - m_frameIntervalInMs) * weight;
+            m_budgetInMs = std::clamp(m_frameIntervalInMs * c_budgetFrameShare, c_minBudgetInMs, c_maxBudgetInMs);
+        }
+    }
+
+    m_lastRenderingTime = renderingTime;
+}
+
+// Heap ordering: lhs runs after rhs.
+bool BuildTreeScheduler::IsLowerPriority(const WorkInfo& lhs, const WorkInfo& rhs)
+{
+    return lhs.Priority() != rhs.Priority() ?
+        lhs.Priority() > rhs.Priority() :
+        lhs.Sequence() > rhs.Sequence();
+}
\ No newline at end of file
@@ -3,35 +3,76 @@
 
 #pragma once
 
+// Work items are plain data so that queuing them does not allocate once the queue has grown to its working size.
 struct WorkInfo
 {
-    WorkInfo(int priority, const std::function<void()>& workFunc) :
+    using WorkFunc = void(*)(void* context);
+
+    WorkInfo(int priority, uint64_t sequence, WorkFunc workFunc, void* context) :
         m_priority(priority),
-        m_workFunc(workFunc)
+        m_sequence(sequence),
+        m_workFunc(workFunc),
+        m_context(context)
     {}
 
     int Priority() const { return m_priority; }
-    void InvokeWorkFunc() const { m_workFunc(); }
+    uint64_t Sequence() const { return m_sequence; }
+    void InvokeWorkFunc() const { m_workFunc(m_context); }
 
 private:
     int m_priority;
-    std::function<void()> m_workFunc;
+    uint64_t m_sequence;
+    WorkFunc m_workFunc;
+    void* m_context;
 };
 
 // High performance time management using QueryPerformanceCounter
 class BuildTreeScheduler final
 {
 public:
-    static void RegisterWork(int priority, const std::function<void()>& workFunc);
+    struct WorkCounters
+    {
+        // Rendering ticks that had pending work.
+        uint64_t FrameCount{ 0 };
+        // Work items invoked, in total and during the last tick.
+        uint64_t WorkCount{ 0 };
+        uint32_t LastFrameWorkCount{ 0 };
+        // Sum over all ticks of the work items left for a later tick.
+        uint64_t DeferredWorkCount{ 0 };
+        // Ticks whose work ran past the budget.
+        uint64_t BudgetOverrunCount{ 0 };
+        double BudgetInMs{ 0.0 };
+        double FrameIntervalInMs{ 0.0 };
+    };
+
+    // Lower priority values run first, work items of the same priority run in registration order.
+    static void RegisterWork(int priority, WorkInfo::WorkFunc workFunc, void* context);
     static bool ShouldYield();
 
+    static WorkCounters Counters();
+    static void ResetCounters();
+
 private:
     static void OnRendering(const winrt::IInspectable& sender, const winrt::IInspectable& args);
     static void QueueTick();
+    static void UpdateBudget(const winrt::TimeSpan& renderingTime);
+    static bool IsLowerPriority(const WorkInfo& lhs, const WorkInfo& rhs);
 
-    static double m_budgetInMs;
+    // Share of the frame interval that the pending work can use on each tick, the rest is left to layout and rendering.
+    static constexpr double c_budgetFrameShare = 0.5;
+    static constexpr double c_minBudgetInMs = 2.0;
+    static constexpr double c_maxBudgetInMs = 40.0;
+    static constexpr double c_defaultFrameIntervalInMs = 1000.0 / 60.0;
+    // Longer gaps between ticks are idle time rather than a frame interval.
+    static constexpr double c_maxFrameIntervalInMs = 100.0;
 
     static thread_local QPCTimer m_timer;
+    // Binary heap ordered by IsLowerPriority.
     static thread_local std::vector<WorkInfo> m_pendingWork;
+    static thread_local uint64_t m_nextSequence;
     static thread_local winrt::event_token m_renderingToken;
+    static thread_local winrt::TimeSpan m_lastRenderingTime;
+    static thread_local double m_frameIntervalInMs;
+    static thread_local double m_budgetInMs;
+    static thread_local WorkCounters m_counters;
 };
\ No newline at end of file
@@ -0,0 +1,118 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include <pch.h>
+#include <common.h>
+#include <BindableVector.h>
+#include "CollectionChangeDiff.h"
+
+/* static */
+CollectionChangeDiff CollectionChangeDiff::FromArgs(const winrt::NotifyCollectionChangedEventArgs& args)
+{
+    CollectionChangeDiff diff{};
+    diff.Action = args.Action();
+
+    switch (diff.Action)
+    {
+    case winrt::NotifyCollectionChangedAction::Add:
+        diff.OldIndex = diff.NewIndex = args.NewStartingIndex();
+        diff.NewCount = static_cast<int>(args.NewItems().Size());
+        break;
+
+    case winrt::NotifyCollectionChangedAction::Remove:
+        diff.OldIndex = diff.NewIndex = args.OldStartingIndex();
+        diff.OldCount = static_cast<int>(args.OldItems().Size());
+        break;
+
+    case winrt::NotifyCollectionChangedAction::Replace:
+        diff.OldIndex = args.OldStartingIndex();
+        diff.OldCount = static_cast<int>(args.OldItems().Size());
+        diff.NewIndex = args.NewStartingIndex();
+        diff.NewCount = static_cast<int>(args.NewItems().Size());
+        break;
+
+    case winrt::NotifyCollectionChangedAction::Move:
+        diff.OldIndex = args.OldStartingIndex();
+        diff.NewIndex = args.NewStartingIndex();
+        diff.OldCount = diff.NewCount = args.OldItems() ? static_cast<int>(args.OldItems().Size()) : 1;
+        break;
+
+    case winrt::NotifyCollectionChangedAction::Reset:
+        break;
+    }
+
+    return diff;
+}
+
+winrt::NotifyCollectionChangedEventArgs CollectionChangeDiff::ToArgs(const winrt::ItemsSourceView& source, int sourceIndex) const
+{
+    auto oldItems = winrt::make<Vector<winrt::IInspectable, MakeVectorParam<VectorFlag::Bindable>()>>();
+    auto newItems = winrt::make<Vector<winrt::IInspectable, MakeVectorParam<VectorFlag::Bindable>()>>();
+    for (int i = 0; i < NewCount; ++i)
+    {
+        newItems.Append(source.GetAt(sourceIndex + i));
+    }
+
+    if (Action == winrt::NotifyCollectionChangedAction::Move)
+    {
+        oldItems = newItems;
+    }
+    else
+    {
+        for (int i = 0; i < OldCount; ++i)
+        {
+            oldItems.Append(nullptr);
+        }
+    }
+
+    const bool hasOldItems = Action != winrt::NotifyCollectionChangedAction::Add && Action != winrt::NotifyCollectionChangedAction::Reset;
+    const bool hasNewItems = Action != winrt::NotifyCollectionChangedAction::Remove && Action != winrt::NotifyCollectionChangedAction::Reset;
+    return winrt::NotifyCollectionChangedEventArgs(
+        Action,
+        newItems,
+        oldItems,
+        hasNewItems ? NewIndex : -1,
+        hasOldItems ? OldIndex : -1);
+}
+
+int CollectionChangeDiff::FirstAffectedIndex() const
+{
+    switch (Action)
+    {
+    case winrt::NotifyCollectionChangedAction::Reset:
+        return 0;
+    case winrt::NotifyCollectionChangedAction::Move:
+        return std::min(OldIndex, NewIndex);
+    default:
+        return OldIndex;
+    }
+}
+
+int CollectionChangeDiff::MapIndex(int oldIndex) const
+{
+    if (Action == winrt::NotifyCollectionChangedAction::Reset)
+    {
+        return -1;
+    }
+
+    if (oldIndex < FirstAffectedIndex())
+    {
+        return oldIndex;
+    }
+
+    const int oldEndIndex = OldIndex + OldCount;
+    if (Action == winrt::NotifyCollectionChangedAction::Move)
+    {
+        if (oldIndex >= OldIndex && oldIndex < oldEndIndex)
+        {
+            return NewIndex + (oldIndex - OldIndex);
+        }
+
+        // NewIndex is the index of the block once it has been taken out, so
+        // take the block out and put it back in.
+        const int indexWithoutBlock = oldIndex >= oldEndIndex ? oldIndex - OldCount : oldIndex;
+        return indexWithoutBlock >= NewIndex ? indexWithoutBlock + OldCount : indexWithoutBlock;
+    }
+
+    return oldIndex < oldEndIndex ? -1 : oldIndex + NewCount - OldCount;
+}
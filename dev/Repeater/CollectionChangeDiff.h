@@ -0,0 +1,30 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+// Normalized form of a collection change notification: OldCount items at OldIndex
+// are replaced by NewCount items at NewIndex. Adds, removes and replaces only shift
+// the indices after the changed block, a move keeps the identity of its items so that
+// their containers can move along with them.
+struct CollectionChangeDiff
+{
+    winrt::NotifyCollectionChangedAction Action{ winrt::NotifyCollectionChangedAction::Reset };
+    int OldIndex{ -1 };
+    int OldCount{ 0 };
+    int NewIndex{ -1 };
+    int NewCount{ 0 };
+
+    static CollectionChangeDiff FromArgs(const winrt::NotifyCollectionChangedEventArgs& args);
+    // Args for the change. The items it adds or moves are read from the source starting at
+    // sourceIndex. The items it removes are no longer in the source, so OldItems of a remove
+    // holds one nullptr per removed item: only its size and OldStartingIndex are meaningful.
+    winrt::NotifyCollectionChangedEventArgs ToArgs(const winrt::ItemsSourceView& source, int sourceIndex) const;
+
+    // Items before this index keep their index.
+    int FirstAffectedIndex() const;
+
+    // Index after the change of the item that was at oldIndex before the change,
+    // or -1 if the item was removed or replaced.
+    int MapIndex(int oldIndex) const;
+};
@@ -30,12 +30,12 @@ void ElementManager::OnBeginMeasure(const ScrollOrientation& orientation)
             // If we are initialized with a non-virtualizing context, make sure that
             // we have enough space to hold the bounds for all the elements.
             const int count = m_context.ItemCount();
-            if (static_cast<int>(m_realizedElementLayoutBounds.size()) != count)
+            if (static_cast<int>(m_realizedElementLayoutBounds.Size()) != count)
             {
                 // Make sure there is enough space for the bounds.
                 // Note: We could optimize when the count becomes smaller, but keeping
                 // it always up to date is the simplest option for now.
-                m_realizedElementLayoutBounds.resize(count, winrt::Rect());
+                m_realizedElementLayoutBounds.Resize(count);
             }
         }
     }
@@ -58,7 +58,7 @@ winrt::UIElement ElementManager::GetAt(int realizedIndex)
             const int dataIndex = GetDataIndexFromRealizedRangeIndex(realizedIndex);
             REPEATER_TRACE_INFO(L"Creating element for sentinal with data index %d. \n", dataIndex);
             element = m_context.GetOrCreateElementAt(dataIndex, winrt::ElementRealizationOptions::ForceCreate | winrt::ElementRealizationOptions::SuppressAutoRecycle);
-            m_realizedElements[realizedIndex] = tracker_ref<winrt::UIElement>{ m_owner, element };
+            SetRealizedElement(realizedIndex, element);
         }
         else
         {
@@ -83,8 +83,13 @@ void ElementManager::Add(const winrt::UIElement& element, int dataIndex)
         m_firstRealizedDataIndex = dataIndex;
     }
 
+    if (element)
+    {
+        m_realizedElementSlots[ElementIdentity(element)] = static_cast<int>(m_realizedElements.size()) + m_realizedSlotOffset;
+    }
+
     m_realizedElements.emplace_back(tracker_ref<winrt::UIElement>{ m_owner, element });
-    m_realizedElementLayoutBounds.emplace_back(winrt::Rect());
+    m_realizedElementLayoutBounds.PushBack(0.f, 0.f, 0.f, 0.f);
 }
 
 void ElementManager::Insert(int realizedIndex, int dataIndex, const winrt::UIElement& element)
@@ -93,11 +98,21 @@ void ElementManager::Insert(int realizedIndex, int dataIndex, const winrt::UIEle
     if (realizedIndex == 0)
     {
         m_firstRealizedDataIndex = dataIndex;
+        m_realizedSlotOffset--;
+    }
+    else
+    {
+        ShiftRealizedElementSlots(realizedIndex, 1);
+    }
+
+    if (element)
+    {
+        m_realizedElementSlots[ElementIdentity(element)] = realizedIndex + m_realizedSlotOffset;
     }
 
     m_realizedElements.insert(m_realizedElements.begin() + realizedIndex, tracker_ref<winrt::UIElement>{ m_owner, element });
     // Set bounds to an invalid rect since we do not know it yet.
-    m_realizedElementLayoutBounds.insert(m_realizedElementLayoutBounds.begin() + realizedIndex, winrt::Rect{ -1.f, -1.f, -1.f, -1.f });
+    m_realizedElementLayoutBounds.Insert(realizedIndex, -1.f, -1.f, -1.f, -1.f);
 }
 
 void ElementManager::ClearRealizedRange(int realizedIndex, int count)
@@ -110,13 +125,29 @@ void ElementManager::ClearRealizedRange(int realizedIndex, int count)
         const int index = realizedIndex == 0 ? realizedIndex + i : (realizedIndex + count - 1) - i;
         if (auto elementRef = m_realizedElements[index])
         {
+            m_realizedElementSlots.erase(ElementIdentity(elementRef.get()));
             m_context.RecycleElement(elementRef.get());
         }
     }
 
     const int endIndex = realizedIndex + count;
+    if (realizedIndex == 0)
+    {
+        m_realizedSlotOffset += count;
+    }
+    else
+    {
+        ShiftRealizedElementSlots(endIndex, -count);
+    }
+
     m_realizedElements.erase(m_realizedElements.begin() + realizedIndex, m_realizedElements.begin() + endIndex);
-    m_realizedElementLayoutBounds.erase(m_realizedElementLayoutBounds.begin() + realizedIndex, m_realizedElementLayoutBounds.begin() + endIndex);
+    m_realizedElementLayoutBounds.Erase(realizedIndex, endIndex);
+
+    if (m_realizedElements.empty())
+    {
+        MUX_ASSERT(m_realizedElementSlots.empty());
+        m_realizedSlotOffset = 0;
+    }
 
     if (realizedIndex == 0)
     {
@@ -156,24 +187,28 @@ void ElementManager::ClearRealizedRange()
 winrt::Rect ElementManager::GetLayoutBoundsForDataIndex(int dataIndex) const
 {
     const int realizedIndex = GetRealizedRangeIndexFromDataIndex(dataIndex);
-    return m_realizedElementLayoutBounds[realizedIndex];
+    return GetLayoutBoundsForRealizedIndex(realizedIndex);
 }
 
 void ElementManager::SetLayoutBoundsForDataIndex(int dataIndex, const winrt::Rect& bounds)
 {
     const int realizedIndex = GetRealizedRangeIndexFromDataIndex(dataIndex);
-    m_realizedElementLayoutBounds[realizedIndex] = bounds;
+    SetLayoutBoundsForRealizedIndex(realizedIndex, bounds);
 }
 
 
 winrt::Rect ElementManager::GetLayoutBoundsForRealizedIndex(int realizedIndex) const
 {
-    return m_realizedElementLayoutBounds[realizedIndex];
+    return winrt::Rect{
+        m_realizedElementLayoutBounds.X(realizedIndex),
+        m_realizedElementLayoutBounds.Y(realizedIndex),
+        m_realizedElementLayoutBounds.Width(realizedIndex),
+        m_realizedElementLayoutBounds.Height(realizedIndex) };
 }
 
 void ElementManager::SetLayoutBoundsForRealizedIndex(int realizedIndex, const winrt::Rect& bounds)
 {
-    m_realizedElementLayoutBounds[realizedIndex] = bounds;
+    m_realizedElementLayoutBounds.Set(realizedIndex, bounds.X, bounds.Y, bounds.Width, bounds.Height);
 }
 
 
@@ -232,7 +267,7 @@ bool ElementManager::IsWindowConnected(const winrt::Rect& window, const ScrollOr
 {
     MUX_ASSERT(IsVirtualizingContext());
     bool intersects = false;
-    if (m_realizedElementLayoutBounds.size() > 0)
+    if (!m_realizedElementLayoutBounds.Empty())
     {
         const auto firstElementBounds = GetLayoutBoundsForRealizedIndex(0);
         const auto lastElementBounds = GetLayoutBoundsForRealizedIndex(GetRealizedElementCount() - 1);
@@ -260,52 +295,39 @@ void ElementManager::DataSourceChanged(const winrt::IInspectable& /*source*/, wi
     MUX_ASSERT(IsVirtualizingContext());
     if (m_realizedElements.size() > 0)
     {
-        switch (args.Action())
+        const auto diff = CollectionChangeDiff::FromArgs(args);
+        switch (diff.Action)
         {
         case winrt::NotifyCollectionChangedAction::Add:
         {
-            OnItemsAdded(args.NewStartingIndex(), args.NewItems().Size());
+            OnItemsAdded(diff.NewIndex, diff.NewCount);
         }
         break;
 
         case winrt::NotifyCollectionChangedAction::Replace:
         {
-            const int oldSize = args.OldItems().Size();
-            const int newSize = args.NewItems().Size();
-            const int oldStartIndex = args.OldStartingIndex();
-            const int newStartIndex = args.NewStartingIndex();
-
-            if (oldSize == newSize &&
-                oldStartIndex == newStartIndex &&
-                IsDataIndexRealized(oldStartIndex) &&
-                IsDataIndexRealized(oldStartIndex + oldSize - 1))
+            if (diff.OldCount == diff.NewCount &&
+                diff.OldIndex == diff.NewIndex)
             {
-                // Straight up replace of n items within the realization window.
+                // Straight up replace of n items, indices are not affected.
                 // Removing and adding might causes us to lose the anchor causing us
                 // to throw away all containers and start from scratch.
-                // Instead, we can just clear those items and set the element to
+                // Instead, we can just clear the realized items and set the element to
                 // null (sentinel) and let the next measure get new containers for them.
-                const auto startRealizedIndex = GetRealizedRangeIndexFromDataIndex(oldStartIndex);
-                for (int realizedIndex = startRealizedIndex; realizedIndex < startRealizedIndex + oldSize; realizedIndex++)
-                {
-                    if (auto elementRef = m_realizedElements[realizedIndex])
-                    {
-                        m_context.RecycleElement(elementRef.get());
-                        m_realizedElements[realizedIndex] = tracker_ref<winrt::UIElement>{ m_owner, nullptr };
-                    }
-                }
+                // Replaced items outside of the realized range need no work at all.
+                OnItemsReplaced(diff.OldIndex, diff.OldCount);
             }
             else
             {
-                OnItemsRemoved(oldStartIndex, oldSize);
-                OnItemsAdded(newStartIndex, newSize);
+                OnItemsRemoved(diff.OldIndex, diff.OldCount);
+                OnItemsAdded(diff.NewIndex, diff.NewCount);
             }
         }
         break;
 
         case winrt::NotifyCollectionChangedAction::Remove:
         {
-            OnItemsRemoved(args.OldStartingIndex(), args.OldItems().Size());
+            OnItemsRemoved(diff.OldIndex, diff.OldCount);
         }
         break;
 
@@ -314,9 +336,11 @@ void ElementManager::DataSourceChanged(const winrt::IInspectable& /*source*/, wi
             break;
 
         case winrt::NotifyCollectionChangedAction::Move:
-            int size = args.OldItems() != NULL ? args.OldItems().Size() : 1;
-            OnItemsRemoved(args.OldStartingIndex(), size);
-            OnItemsAdded(args.NewStartingIndex(), size);
+            if (!OnItemsMoved(diff.OldIndex, diff.NewIndex, diff.OldCount))
+            {
+                OnItemsRemoved(diff.OldIndex, diff.OldCount);
+                OnItemsAdded(diff.NewIndex, diff.NewCount);
+            }
             break;
         }
     }
@@ -325,10 +349,10 @@ void ElementManager::DataSourceChanged(const winrt::IInspectable& /*source*/, wi
 int ElementManager::GetElementDataIndex(const winrt::UIElement& suggestedAnchor) const
 {
     MUX_ASSERT(suggestedAnchor);
-    auto it = std::find(m_realizedElements.cbegin(), m_realizedElements.cend(), suggestedAnchor);
+    const auto it = m_realizedElementSlots.find(ElementIdentity(suggestedAnchor));
     return
-        it != m_realizedElements.cend() ?
-        GetDataIndexFromRealizedRangeIndex(static_cast<int>(std::distance(m_realizedElements.cbegin(), it))) :
+        it != m_realizedElementSlots.cend() ?
+        GetDataIndexFromRealizedRangeIndex(it->second - m_realizedSlotOffset) :
         -1;
 }
 
@@ -349,7 +373,7 @@ int ElementManager::GetRealizedRangeIndexFromDataIndex(int dataIndex) const
 void ElementManager::DiscardElementsOutsideWindow(const winrt::Rect& window, const ScrollOrientation& orientation)
 {
     MUX_ASSERT(IsVirtualizingContext());
-    MUX_ASSERT(m_realizedElements.size() == m_realizedElementLayoutBounds.size());
+    MUX_ASSERT(m_realizedElements.size() == m_realizedElementLayoutBounds.Size());
 
     // The following illustration explains the cutoff indices.
     // We will clear all the realized elements from both ends
@@ -374,24 +398,12 @@ void ElementManager::DiscardElementsOutsideWindow(const winrt::Rect& window, con
     // layout pass).
 
     const int realizedRangeSize = GetRealizedElementCount();
-    int frontCutoffIndex = -1;
-    int backCutoffIndex = realizedRangeSize;
+    const auto axis = orientation == ScrollOrientation::Vertical ? LayoutBoundsStore::Axis::Y : LayoutBoundsStore::Axis::X;
+    const float windowStart = orientation == ScrollOrientation::Vertical ? window.Y : window.X;
+    const float windowEnd = orientation == ScrollOrientation::Vertical ? window.Y + window.Height : window.X + window.Width;
 
-    for (int i = 0;
-        i < realizedRangeSize &&
-        !Intersects(window, m_realizedElementLayoutBounds[i], orientation);
-        ++i)
-    {
-        ++frontCutoffIndex;
-    }
-
-    for (int i = realizedRangeSize - 1;
-        i >= 0 &&
-        !Intersects(window, m_realizedElementLayoutBounds[i], orientation);
-        --i)
-    {
-        --backCutoffIndex;
-    }
+    const int frontCutoffIndex = static_cast<int>(m_realizedElementLayoutBounds.CountLeadingOutside(axis, windowStart, windowEnd)) - 1;
+    const int backCutoffIndex = realizedRangeSize - static_cast<int>(m_realizedElementLayoutBounds.CountTrailingOutside(axis, windowStart, windowEnd));
 
     if (backCutoffIndex < realizedRangeSize - 1)
     {
@@ -404,17 +416,6 @@ void ElementManager::DiscardElementsOutsideWindow(const winrt::Rect& window, con
     }
 }
 
-/* static */
-bool ElementManager::Intersects(const winrt::Rect& lhs, const winrt::Rect& rhs, const ScrollOrientation& orientation)
-{
-    const auto lhsStart = orientation == ScrollOrientation::Vertical ? lhs.Y : lhs.X;
-    const auto lhsEnd = orientation == ScrollOrientation::Vertical ? lhs.Y + lhs.Height : lhs.X + lhs.Width;
-    const auto rhsStart = orientation == ScrollOrientation::Vertical ? rhs.Y : rhs.X;
-    const auto rhsEnd = orientation == ScrollOrientation::Vertical ? rhs.Y + rhs.Height : rhs.X + rhs.Width;
-
-    return lhsEnd >= rhsStart && lhsStart <= rhsEnd;
-}
-
 void ElementManager::OnItemsAdded(int index, int count)
 {
     // Using the old indices here (before it was updated by the collection change)
@@ -465,6 +466,91 @@ void ElementManager::OnItemsRemoved(int index, int count)
 }
 
 
+void ElementManager::OnItemsReplaced(int index, int count)
+{
+    const int lastRealizedDataIndex = m_firstRealizedDataIndex + GetRealizedElementCount() - 1;
+    const int startIndex = std::max(m_firstRealizedDataIndex, index);
+    const int endIndex = std::min(lastRealizedDataIndex, index + count - 1);
+
+    for (int dataIndex = startIndex; dataIndex <= endIndex; dataIndex++)
+    {
+        const int realizedIndex = GetRealizedRangeIndexFromDataIndex(dataIndex);
+        if (auto elementRef = m_realizedElements[realizedIndex])
+        {
+            m_context.RecycleElement(elementRef.get());
+            SetRealizedElement(realizedIndex, nullptr);
+        }
+    }
+}
+
+// If the moved items stay within the realized range, their containers are moved along
+// with them instead of being recycled and realized again at the new position. The layout
+// bounds stay where they are since the next measure lays out the range again anyway.
+bool ElementManager::OnItemsMoved(int oldIndex, int newIndex, int count)
+{
+    const int lastRealizedDataIndex = m_firstRealizedDataIndex + GetRealizedElementCount() - 1;
+    const int firstMovedDataIndex = std::min(oldIndex, newIndex);
+    const int lastMovedDataIndex = std::max(oldIndex, newIndex) + count - 1;
+    if (count <= 0 ||
+        firstMovedDataIndex < m_firstRealizedDataIndex ||
+        lastMovedDataIndex > lastRealizedDataIndex)
+    {
+        return false;
+    }
+
+    const int firstRealizedIndex = GetRealizedRangeIndexFromDataIndex(firstMovedDataIndex);
+    const int lastRealizedIndex = GetRealizedRangeIndexFromDataIndex(lastMovedDataIndex);
+    // The block is at the front of the affected range when moving forward and at its end
+    // when moving backward. The layout bounds move along with their elements.
+    const int middleRealizedIndex = oldIndex < newIndex ? firstRealizedIndex + count : lastRealizedIndex + 1 - count;
+    std::rotate(
+        m_realizedElements.begin() + firstRealizedIndex,
+        m_realizedElements.begin() + middleRealizedIndex,
+        m_realizedElements.begin() + lastRealizedIndex + 1);
+    m_realizedElementLayoutBounds.Rotate(firstRealizedIndex, middleRealizedIndex, lastRealizedIndex + 1);
+
+    for (int realizedIndex = firstRealizedIndex; realizedIndex <= lastRealizedIndex; ++realizedIndex)
+    {
+        if (auto elementRef = m_realizedElements[realizedIndex])
+        {
+            m_realizedElementSlots[ElementIdentity(elementRef.get())] = realizedIndex + m_realizedSlotOffset;
+        }
+    }
+
+    return true;
+}
+
+
+// Replaces the element (or sentinel) at realizedIndex, keeping the slot map in sync.
+void ElementManager::SetRealizedElement(int realizedIndex, const winrt::UIElement& element)
+{
+    if (auto previous = m_realizedElements[realizedIndex])
+    {
+        m_realizedElementSlots.erase(ElementIdentity(previous.get()));
+    }
+
+    if (element)
+    {
+        m_realizedElementSlots[ElementIdentity(element)] = realizedIndex + m_realizedSlotOffset;
+    }
+
+    m_realizedElements[realizedIndex] = tracker_ref<winrt::UIElement>{ m_owner, element };
+}
+
+// Moves the slots of the elements from fromRealizedIndex to the end of the realized range.
+// Only needed when the range changes in the middle, which only happens on collection changes.
+void ElementManager::ShiftRealizedElementSlots(int fromRealizedIndex, int delta)
+{
+    const int realizedCount = static_cast<int>(m_realizedElements.size());
+    for (int realizedIndex = fromRealizedIndex; realizedIndex < realizedCount; ++realizedIndex)
+    {
+        if (auto elementRef = m_realizedElements[realizedIndex])
+        {
+            m_realizedElementSlots[ElementIdentity(elementRef.get())] += delta;
+        }
+    }
+}
+
 bool ElementManager::IsVirtualizingContext() const
 {
     if (m_context)
@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "OrientationBasedMeasures.h"
+#include "LayoutBoundsStore.h"
+#include "CollectionChangeDiff.h"
 
 // Internal component for layout to keep track of elements and
 // help with collection changes.
@@ -31,6 +35,8 @@ public:
 
     winrt::Rect GetLayoutBoundsForRealizedIndex(int realizedIndex) const;
     void SetLayoutBoundsForRealizedIndex(int realizedIndex, const winrt::Rect& bounds);
+    // Layout bounds by realized index, for passes over the whole realized range.
+    const LayoutBoundsStore& LayoutBounds() const { return m_realizedElementLayoutBounds; }
 
     bool IsDataIndexRealized(int index) const;
     bool IsIndexValidInData(int currentIndex) const;
@@ -52,17 +58,27 @@ private:
     int GetRealizedRangeIndexFromDataIndex(int dataIndex) const;
 
     void DiscardElementsOutsideWindow(const winrt::Rect& window, const ScrollOrientation& orientation);
-    static bool Intersects(const winrt::Rect& lhs, const winrt::Rect& rhs, const ScrollOrientation& orientation);
 
     void OnItemsAdded(int index, int count);
     void OnItemsRemoved(int index, int count);
+    void OnItemsReplaced(int index, int count);
+    bool OnItemsMoved(int oldIndex, int newIndex, int count);
 
     bool IsVirtualizingContext() const;
 
+    static void* ElementIdentity(const winrt::UIElement& element) { return winrt::get_abi(element); }
+    void SetRealizedElement(int realizedIndex, const winrt::UIElement& element);
+    void ShiftRealizedElementSlots(int fromRealizedIndex, int delta);
+
     const ITrackerHandleManager* m_owner;
 
     std::vector<tracker_ref<winrt::UIElement>> m_realizedElements;
-    std::vector<winrt::Rect> m_realizedElementLayoutBounds;
+    // Slot of each element in m_realizedElements, sentinels are not in the map. The realized
+    // index of a slot is slot - m_realizedSlotOffset, so that adding or clearing elements at
+    // the front only moves the offset.
+    std::unordered_map<void* /* element identity */, int /* slot */> m_realizedElementSlots;
+    int m_realizedSlotOffset{ 0 };
+    LayoutBoundsStore m_realizedElementLayoutBounds;
     int m_firstRealizedDataIndex{ -1 };
     winrt::VirtualizingLayoutContext m_context{ nullptr };
 };
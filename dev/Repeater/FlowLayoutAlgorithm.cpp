@@ -172,7 +172,8 @@ int FlowLayoutAlgorithm::GetAnchorIndex(
         const auto suggestedAnchorIndex = m_context.get().RecommendedAnchorIndex();
 
         const bool isAnchorSuggestionValid = suggestedAnchorIndex >= 0 &&
-            m_elementManager.IsDataIndexRealized(suggestedAnchorIndex);
+            m_elementManager.IsDataIndexRealized(suggestedAnchorIndex) &&
+            !IsAnchorOutsideRealizationRect(suggestedAnchorIndex);
 
         if (isAnchorSuggestionValid)
         {
@@ -298,6 +299,11 @@ void FlowLayoutAlgorithm::Generate(
             direction == GenerateDirection::Forward ? L"forward" : L"backward",
             anchorIndex);
 
+        // The sizes the layout knows up front can change from one measure to the next.
+        m_knownItemSizesStartIndex = -1;
+        m_knownItemSizesCount = 0;
+        m_areItemSizesKnown = true;
+
         int previousIndex = anchorIndex;
         int currentIndex = anchorIndex + step;
         const auto anchorBounds = m_elementManager.GetLayoutBoundsForDataIndex(anchorIndex);
@@ -312,7 +318,16 @@ void FlowLayoutAlgorithm::Generate(
             // Ensure layout element.
             m_elementManager.EnsureElementRealized(direction == GenerateDirection::Forward, currentIndex, layoutId);
             const auto currentElement = m_elementManager.GetRealizedElement(currentIndex);
-            const auto desiredSize = MeasureElement(currentElement, currentIndex, availableSize, m_context.get());
+            winrt::Size desiredSize{};
+            const bool isSizeKnown = TryGetKnownItemSize(currentIndex, direction, availableSize, desiredSize);
+            if (isSizeKnown)
+            {
+                currentElement.Measure(desiredSize);
+            }
+            else
+            {
+                desiredSize = MeasureElement(currentElement, currentIndex, availableSize, m_context.get());
+            }
 
             // Lay it out.
             const auto previousElement = m_elementManager.GetRealizedElement(previousIndex);
@@ -322,7 +337,7 @@ void FlowLayoutAlgorithm::Generate(
             if (direction == GenerateDirection::Forward)
             {
                 const double remainingSpace = Minor(availableSize) - (MinorStart(previousElementBounds) + MinorSize(previousElementBounds) + minItemSpacing + Minor(desiredSize));
-                if (countInLine >= maxItemsPerLine || m_algorithmCallbacks->Algorithm_ShouldBreakLine(currentIndex, remainingSpace))
+                if (countInLine >= maxItemsPerLine || ShouldBreakLine(currentIndex, remainingSpace, isSizeKnown))
                 {
                     // No more space in this row. wrap to next row.
                     MinorStart(currentBounds) = 0;
@@ -360,7 +375,7 @@ void FlowLayoutAlgorithm::Generate(
             {
                 // Backward
                 const double remainingSpace = MinorStart(previousElementBounds) - (Minor(desiredSize) + static_cast<float>(minItemSpacing));
-                if (countInLine >= maxItemsPerLine || m_algorithmCallbacks->Algorithm_ShouldBreakLine(currentIndex, remainingSpace))
+                if (countInLine >= maxItemsPerLine || ShouldBreakLine(currentIndex, remainingSpace, isSizeKnown))
                 {
                     // Does not fit, wrap to the previous row
                     const auto availableSizeMinor = Minor(availableSize);
@@ -448,6 +463,28 @@ bool FlowLayoutAlgorithm::IsReflowRequired() const
         m_elementManager.GetLayoutBoundsForRealizedIndex(0).Y != 0);
 }
 
+// After a far jump, the scroller can still suggest an element that was anchoring the old viewport.
+// Generating from it would realize and discard every item between it and the realization rect.
+// Layouts with uniform item placement compute the anchor for the realization rect directly, so
+// for them such a suggestion is ignored.
+bool FlowLayoutAlgorithm::IsAnchorOutsideRealizationRect(int anchorIndex)
+{
+    if (m_algorithmCallbacks->Algorithm_IsItemPlacementUniform())
+    {
+        const auto realizationRect = RealizationRect();
+        // An empty realization rect (eg. a BringIntoView issued before the first layout pass)
+        // does not tell us where the anchor should be.
+        if (MajorSize(realizationRect) > 0)
+        {
+            const auto anchorBounds = m_elementManager.GetLayoutBoundsForDataIndex(anchorIndex);
+            return MajorEnd(anchorBounds) < MajorStart(realizationRect) ||
+                MajorStart(anchorBounds) > MajorEnd(realizationRect);
+        }
+    }
+
+    return false;
+}
+
 bool FlowLayoutAlgorithm::ShouldContinueFillingUpSpace(
     int index,
     GenerateDirection direction)
@@ -482,6 +519,53 @@ bool FlowLayoutAlgorithm::ShouldContinueFillingUpSpace(
     return shouldContinue;
 }
 
+// Items whose size the layout knows up front are measured at that size without calling back
+// into the layout. Their sizes are fetched a chunk at a time in the direction we generate.
+bool FlowLayoutAlgorithm::TryGetKnownItemSize(
+    int index,
+    GenerateDirection direction,
+    const winrt::Size& availableSize,
+    winrt::Size& size)
+{
+    if (!m_areItemSizesKnown)
+    {
+        return false;
+    }
+
+    if (index < m_knownItemSizesStartIndex || index >= m_knownItemSizesStartIndex + m_knownItemSizesCount)
+    {
+        const int startIndex = direction == GenerateDirection::Forward ?
+            index :
+            std::max(0, index - c_knownItemSizesChunkSize + 1);
+        const int count = direction == GenerateDirection::Forward ?
+            std::min(c_knownItemSizesChunkSize, m_context.get().ItemCount() - index) :
+            index - startIndex + 1;
+
+        m_knownItemSizes.resize(count);
+        m_knownItemSizesStartIndex = startIndex;
+        m_knownItemSizesCount = m_algorithmCallbacks->Algorithm_GetKnownItemSizes(startIndex, availableSize, m_context.get(), m_knownItemSizes);
+        MUX_ASSERT(m_knownItemSizesCount <= count);
+
+        if (index >= m_knownItemSizesStartIndex + m_knownItemSizesCount)
+        {
+            // Do not ask again for the rest of this pass.
+            m_areItemSizesKnown = false;
+            return false;
+        }
+    }
+
+    size = m_knownItemSizes[index - m_knownItemSizesStartIndex];
+    return true;
+}
+
+bool FlowLayoutAlgorithm::ShouldBreakLine(int index, double remainingSpace, bool isSizeKnown)
+{
+    // Known sizes come with the default line breaking behavior.
+    return isSizeKnown ?
+        remainingSpace < 0 :
+        m_algorithmCallbacks->Algorithm_ShouldBreakLine(index, remainingSpace);
+}
+
 winrt::Rect FlowLayoutAlgorithm::EstimateExtent(const winrt::Size& availableSize, const wstring_view& layoutId)
 {
     winrt::UIElement firstRealizedElement = nullptr;
@@ -565,39 +649,35 @@ void FlowLayoutAlgorithm::ArrangeVirtualizingLayout(
 {
     // Walk through the realized elements one line at a time and
     // align them, Then call element.Arrange with the arranged bounds.
+    // A line ends at the first element with a different major start, which we
+    // find by scanning the major starts of several elements at a time.
     const int realizedElementCount = m_elementManager.GetRealizedElementCount();
     if (realizedElementCount > 0)
     {
-        int countInLine = 1;
-        auto previousElementBounds = m_elementManager.GetLayoutBoundsForRealizedIndex(0);
-        auto currentLineOffset = MajorStart(previousElementBounds);
-        auto spaceAtLineStart = MinorStart(previousElementBounds);
-        float spaceAtLineEnd = 0;
-        float currentLineSize = MajorSize(previousElementBounds);
-        for (int i = 1; i < realizedElementCount; i++)
-        {
-            const auto currentBounds = m_elementManager.GetLayoutBoundsForRealizedIndex(i);
-            if (MajorStart(currentBounds) != currentLineOffset)
-            {
-                spaceAtLineEnd = Minor(finalSize) - MinorStart(previousElementBounds) - MinorSize(previousElementBounds);
-                PerformLineAlignment(i - countInLine, countInLine, spaceAtLineStart, spaceAtLineEnd, currentLineSize, lineAlignment, isWrapping, finalSize, layoutId);
-                spaceAtLineStart = MinorStart(currentBounds);
-                countInLine = 0;
-                currentLineOffset = MajorStart(currentBounds);
-                currentLineSize = 0;
-            }
-
-            countInLine++; // for current element
-            currentLineSize = std::max(currentLineSize, MajorSize(currentBounds));
-            previousElementBounds = currentBounds;
-        }
+        const auto& layoutBounds = m_elementManager.LayoutBounds();
+        MUX_ASSERT(static_cast<int>(layoutBounds.Size()) >= realizedElementCount);
+        const auto majorAxis = GetScrollOrientation() == ScrollOrientation::Vertical ? LayoutBoundsStore::Axis::Y : LayoutBoundsStore::Axis::X;
 
-        // Last line - potentially have a property to customize
-        // aligning the last line or not.
-        if (countInLine > 0)
+        int lineStartIndex = 0;
+        while (lineStartIndex < realizedElementCount)
         {
-            const float spaceAtEnd = Minor(finalSize) - MinorStart(previousElementBounds) - MinorSize(previousElementBounds);
-            PerformLineAlignment(realizedElementCount - countInLine, countInLine, spaceAtLineStart, spaceAtEnd, currentLineSize, lineAlignment, isWrapping, finalSize, layoutId);
+            const auto lineStartBounds = m_elementManager.GetLayoutBoundsForRealizedIndex(lineStartIndex);
+            const int lineEndIndex = std::min(
+                realizedElementCount,
+                static_cast<int>(layoutBounds.FindStartNotEqual(majorAxis, lineStartIndex + 1, MajorStart(lineStartBounds))));
+            // The first line starts from the size of its first element, the others from zero.
+            const float lineSize = layoutBounds.MaxSize(
+                majorAxis,
+                lineStartIndex == 0 ? 1 : lineStartIndex,
+                lineEndIndex,
+                lineStartIndex == 0 ? MajorSize(lineStartBounds) : 0.0f);
+
+            // Potentially have a property to customize aligning the last line or not.
+            const auto lineEndBounds = m_elementManager.GetLayoutBoundsForRealizedIndex(lineEndIndex - 1);
+            const float spaceAtLineEnd = Minor(finalSize) - MinorStart(lineEndBounds) - MinorSize(lineEndBounds);
+            PerformLineAlignment(lineStartIndex, lineEndIndex - lineStartIndex, MinorStart(lineStartBounds), spaceAtLineEnd, lineSize, lineAlignment, isWrapping, finalSize, layoutId);
+
+            lineStartIndex = lineEndIndex;
         }
     }
 }
@@ -615,62 +695,59 @@ void FlowLayoutAlgorithm::PerformLineAlignment(
     const winrt::Size& finalSize,
     const wstring_view& layoutId)
 {
+    // The alignment moves the i-th element of the line by lineShift + step * (stepScale * i + stepOffset).
+    // Work that out once for the line rather than for every element.
+    const bool isAligned = !m_scrollOrientationSameAsFlow && (spaceAtLineStart != 0 || spaceAtLineEnd != 0);
+    const float totalSpace = spaceAtLineStart + spaceAtLineEnd;
+    float lineShift = -spaceAtLineStart;
+    float step = 0.0f;
+    int stepScale = 0;
+    int stepOffset = 0;
+    switch (lineAlignment)
+    {
+    case FlowLayoutAlgorithm::LineAlignment::Start:
+        break;
+
+    case FlowLayoutAlgorithm::LineAlignment::End:
+        lineShift = spaceAtLineEnd;
+        break;
+
+    case FlowLayoutAlgorithm::LineAlignment::Center:
+        step = totalSpace / 2;
+        stepOffset = 1;
+        break;
+
+    case FlowLayoutAlgorithm::LineAlignment::SpaceAround:
+        step = countInLine >= 1 ? totalSpace / (countInLine * 2) : 0;
+        stepScale = 2;
+        stepOffset = 1;
+        break;
+
+    case FlowLayoutAlgorithm::LineAlignment::SpaceBetween:
+        step = countInLine > 1 ? totalSpace / (countInLine - 1) : 0;
+        stepScale = 1;
+        break;
+
+    case FlowLayoutAlgorithm::LineAlignment::SpaceEvenly:
+        step = countInLine >= 1 ? totalSpace / (countInLine + 1) : 0;
+        stepScale = 1;
+        stepOffset = 1;
+        break;
+    }
+    const bool hasStep = stepScale != 0 || stepOffset != 0;
+
     for (int rangeIndex = lineStartIndex; rangeIndex < lineStartIndex + countInLine; ++rangeIndex)
     {
         auto bounds = m_elementManager.GetLayoutBoundsForRealizedIndex(rangeIndex);
         MajorSize(bounds) = lineSize;
 
-        if (!m_scrollOrientationSameAsFlow)
+        // Note: Space at start could potentially be negative
+        if (isAligned)
         {
-            // Note: Space at start could potentially be negative
-            if (spaceAtLineStart != 0 || spaceAtLineEnd != 0)
+            MinorStart(bounds) += lineShift;
+            if (hasStep)
             {
-                float totalSpace = spaceAtLineStart + spaceAtLineEnd;
-                switch (lineAlignment)
-                {
-                case FlowLayoutAlgorithm::LineAlignment::Start:
-                {
-                    MinorStart(bounds) -= spaceAtLineStart;
-                    break;
-                }
-
-                case FlowLayoutAlgorithm::LineAlignment::End:
-                {
-                    MinorStart(bounds) += spaceAtLineEnd;
-                    break;
-                }
-
-                case FlowLayoutAlgorithm::LineAlignment::Center:
-                {
-                    MinorStart(bounds) -= spaceAtLineStart;
-                    MinorStart(bounds) += totalSpace / 2;
-                    break;
-                }
-
-                case FlowLayoutAlgorithm::LineAlignment::SpaceAround:
-                {
-                    float interItemSpace = countInLine >= 1 ? totalSpace / (countInLine * 2) : 0;
-                    MinorStart(bounds) -= spaceAtLineStart;
-                    MinorStart(bounds) += interItemSpace * ((rangeIndex - lineStartIndex + 1) * 2 - 1);
-                    break;
-                }
-
-                case FlowLayoutAlgorithm::LineAlignment::SpaceBetween:
-                {
-                    float interItemSpace = countInLine > 1 ? totalSpace / (countInLine - 1) : 0;
-                    MinorStart(bounds) -= spaceAtLineStart;
-                    MinorStart(bounds) += interItemSpace * (rangeIndex - lineStartIndex);
-                    break;
-                }
-
-                case FlowLayoutAlgorithm::LineAlignment::SpaceEvenly:
-                {
-                    float interItemSpace = countInLine >= 1 ? totalSpace / (countInLine + 1) : 0;
-                    MinorStart(bounds) -= spaceAtLineStart;
-                    MinorStart(bounds) += interItemSpace * (rangeIndex - lineStartIndex + 1);
-                    break;
-                }
-                }
+                MinorStart(bounds) += step * (stepScale * (rangeIndex - lineStartIndex) + stepOffset);
             }
         }
 
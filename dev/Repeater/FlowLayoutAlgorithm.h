@@ -91,7 +91,14 @@ private:
         const winrt::VirtualizingLayoutContext& context,
         int index,
         const winrt::Size& availableSize);
+    bool TryGetKnownItemSize(
+        int index,
+        GenerateDirection direction,
+        const winrt::Size& availableSize,
+        winrt::Size& size);
+    bool ShouldBreakLine(int index, double remainingSpace, bool isSizeKnown);
     bool IsReflowRequired() const;
+    bool IsAnchorOutsideRealizationRect(int anchorIndex);
     bool ShouldContinueFillingUpSpace(
         int index,
         GenerateDirection direction);
@@ -136,6 +143,14 @@ private:
     int m_firstRealizedDataIndexInsideRealizationWindow{ -1 };
     int m_lastRealizedDataIndexInsideRealizationWindow{ -1 };
 
+    // Sizes of the items in [m_knownItemSizesStartIndex, m_knownItemSizesStartIndex + m_knownItemSizesCount)
+    // as given by Algorithm_GetKnownItemSizes during the current generate pass.
+    std::vector<winrt::Size> m_knownItemSizes;
+    int m_knownItemSizesStartIndex{ -1 };
+    int m_knownItemSizesCount{ 0 };
+    bool m_areItemSizesKnown{ true };
+    static constexpr int c_knownItemSizesChunkSize = 64;
+
     // If the scroll orientation is the same as the folow orientation
     // we will only have one line since we will never wrap. In that case
     // we do not want to align the line. We could potentially switch the
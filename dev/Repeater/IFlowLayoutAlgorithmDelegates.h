@@ -11,6 +11,18 @@ public:
     virtual winrt::Size Algorithm_GetMeasureSize(int index, const winrt::Size& availableSize, const winrt::VirtualizingLayoutContext& context) = 0;
     virtual winrt::Size Algorithm_GetProvisionalArrangeSize(int index, const winrt::Size& measureSize, winrt::Size const& desiredSize, const winrt::VirtualizingLayoutContext& context) = 0;
     virtual bool Algorithm_ShouldBreakLine(int index, double remainingSpace) = 0;
+    // Layouts that know the size of their items before measuring them fill sizes with the sizes
+    // of the items starting at startIndex and return how many they filled. Those items are measured
+    // at that size, and break lines when there is no space left, without calling back into the layout.
+    virtual int Algorithm_GetKnownItemSizes(
+        int /*startIndex*/,
+        const winrt::Size& /*availableSize*/,
+        const winrt::VirtualizingLayoutContext& /*context*/,
+        winrt::array_view<winrt::Size> /*sizes*/) { return 0; }
+    // Layouts that place every item in a fixed cell return true. Their anchor for the realization
+    // rect is computed rather than estimated, so it can be trusted over a suggested anchor that
+    // is far away from the realization rect.
+    virtual bool Algorithm_IsItemPlacementUniform() { return false; }
     virtual winrt::FlowLayoutAnchorInfo Algorithm_GetAnchorForRealizationRect(const winrt::Size& availableSize, const winrt::VirtualizingLayoutContext& context) = 0;
     virtual winrt::FlowLayoutAnchorInfo Algorithm_GetAnchorForTargetElement(int targetIndex, const winrt::Size& availableSize, const winrt::VirtualizingLayoutContext& context) = 0;
     virtual winrt::Rect Algorithm_GetExtent(const winrt::Size& availableSize,
@@ -30,19 +30,30 @@ InspectingDataSource::InspectingDataSource(const winrt::IInspectable& source)
             m_vector.set(reinterpret_cast<const winrt::IVector<winrt::IInspectable>&>(bindableVector));
             ListenToCollectionChanges();
         }
+        else if (auto vectorView = source.try_as<winrt::IVectorView<winrt::IInspectable>>())
+        {
+            // A read only view can still change underneath us without telling anyone, so it
+            // is copied like any other source that does not raise notifications. Its size is
+            // known, which lets the copy happen in one GetMany.
+            SnapshotVectorView(vectorView, false /* isBindable */);
+        }
+        else if (auto bindableVectorView = source.try_as<winrt::IBindableVectorView>())
+        {
+            SnapshotVectorView(reinterpret_cast<const winrt::IVectorView<winrt::IInspectable>&>(bindableVectorView), true /* isBindable */);
+        }
         else
         {
             auto iterable = source.try_as<winrt::IIterable<winrt::IInspectable>>();
             if (iterable)
             {
-                m_vector.set(WrapIterable(iterable));
+                SnapshotIterable(iterable, false /* isBindable */);
             }
             else
             {
                 auto bindableIterable = source.try_as<winrt::IBindableIterable>();
                 if (bindableIterable)
                 {
-                    m_vector.set(WrapIterable(reinterpret_cast<const winrt::IIterable<winrt::IInspectable> &>(bindableIterable)));
+                    SnapshotIterable(reinterpret_cast<const winrt::IIterable<winrt::IInspectable> &>(bindableIterable), true /* isBindable */);
                 }
                 else
                 {
@@ -64,12 +75,27 @@ InspectingDataSource::~InspectingDataSource()
 
 int32_t InspectingDataSource::GetSizeCore()
 {
-    return static_cast<int>(m_vector.get().Size());
+    if (m_vector)
+    {
+        return static_cast<int>(m_vector.get().Size());
+    }
+
+    return static_cast<int>(m_snapshot.size());
 }
 
 winrt::IInspectable InspectingDataSource::GetAtCore(int index)
 {
-    return m_vector.get().GetAt(static_cast<unsigned>(index));
+    if (m_vector)
+    {
+        return m_vector.get().GetAt(static_cast<unsigned>(index));
+    }
+
+    if (index < 0 || index >= static_cast<int>(m_snapshot.size()))
+    {
+        throw winrt::hresult_out_of_bounds();
+    }
+
+    return m_snapshot[index].get();
 }
 
 bool InspectingDataSource::HasKeyIndexMappingCore()
@@ -112,23 +138,90 @@ int InspectingDataSource::IndexOfCore(winrt::IInspectable const& value)
             index = static_cast<int>(v);
         }
     }
+    else
+    {
+        // Items of the snapshot are compared by identity, so a hash of their identities finds them.
+        EnsureIdentityIndex();
+        const auto it = m_identityIndex.find(GetIdentity(value));
+        if (it != m_identityIndex.end())
+        {
+            index = it->second;
+        }
+    }
     return index;
 }
 
 #pragma endregion
 
-winrt::IVector<winrt::IInspectable>
-InspectingDataSource::WrapIterable(const winrt::IIterable<winrt::IInspectable>& iterable)
+// Iterables do not know their size and layouts need it to be exact, so they are
+// enumerated to their end in a single pass.
+void InspectingDataSource::SnapshotIterable(const winrt::IIterable<winrt::IInspectable>& iterable, bool isBindable)
 {
-    auto vector = winrt::make<Vector<winrt::IInspectable, MakeVectorParam<VectorFlag::DependencyObjectBase>()>>();
     auto iterator = iterable.First();
-    while (iterator.HasCurrent())
+    if (isBindable)
     {
-        vector.Append(iterator.Current());
-        iterator.MoveNext();
+        // IBindableIterator has no GetMany.
+        while (iterator.HasCurrent())
+        {
+            m_snapshot.emplace_back(this, iterator.Current());
+            iterator.MoveNext();
+        }
     }
+    else
+    {
+        std::vector<winrt::IInspectable> items(c_iteratorBufferSize, nullptr);
+        for (auto copiedCount = iterator.GetMany(items); copiedCount > 0; copiedCount = iterator.GetMany(items))
+        {
+            for (uint32_t i = 0; i < copiedCount; i++)
+            {
+                m_snapshot.emplace_back(this, items[i]);
+            }
+        }
+    }
+}
 
-    return vector;
+void InspectingDataSource::SnapshotVectorView(const winrt::IVectorView<winrt::IInspectable>& vectorView, bool isBindable)
+{
+    const uint32_t size = vectorView.Size();
+    m_snapshot.reserve(size);
+    if (isBindable)
+    {
+        // IBindableVectorView has no GetMany.
+        for (uint32_t i = 0; i < size; i++)
+        {
+            m_snapshot.emplace_back(this, vectorView.GetAt(i));
+        }
+    }
+    else
+    {
+        std::vector<winrt::IInspectable> items(size, nullptr);
+        const auto copiedCount = vectorView.GetMany(0, items);
+        for (uint32_t i = 0; i < copiedCount; i++)
+        {
+            m_snapshot.emplace_back(this, items[i]);
+        }
+    }
+}
+
+void InspectingDataSource::EnsureIdentityIndex()
+{
+    if (!m_hasIdentityIndex)
+    {
+        m_identityIndex.reserve(m_snapshot.size());
+        for (int i = 0; i < static_cast<int>(m_snapshot.size()); i++)
+        {
+            // Keep the first index of items that are in the source more than once.
+            m_identityIndex.emplace(GetIdentity(m_snapshot[i].get()), i);
+        }
+
+        m_hasIdentityIndex = true;
+    }
+}
+
+/* static */
+void* InspectingDataSource::GetIdentity(const winrt::IInspectable& value)
+{
+    return value ? winrt::get_abi(value.as<winrt::IUnknown>()) : nullptr;
 }
 
 void InspectingDataSource::UnListenToCollectionChanges()
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "ItemsSourceView.h"
 
 class InspectingDataSource : 
@@ -25,8 +27,10 @@ public:
 #pragma endregion
 
 private:
-    winrt::Collections::IVector<winrt::IInspectable>
-    WrapIterable(const winrt::Collections::IIterable<winrt::IInspectable>& iterable);
+    void SnapshotIterable(const winrt::Collections::IIterable<winrt::IInspectable>& iterable, bool isBindable);
+    void SnapshotVectorView(const winrt::Collections::IVectorView<winrt::IInspectable>& vectorView, bool isBindable);
+    void EnsureIdentityIndex();
+    static void* GetIdentity(const winrt::IInspectable& value);
 
     void UnListenToCollectionChanges();
     void ListenToCollectionChanges();
@@ -45,6 +49,16 @@ private:
 
     tracker_ref<winrt::Collections::IVector<winrt::IInspectable>> m_vector{ this };
 
+    // Sources that do not raise change notifications are copied into a snapshot up front.
+    // Layouts ask for the exact count first, which enumerates iterables to their end anyway.
+    std::vector<tracker_ref<winrt::IInspectable>> m_snapshot{};
+    // Identity of the snapshot items to their first index, built on the first IndexOf.
+    std::unordered_map<void* /* identity */, int /* index */> m_identityIndex{};
+    bool m_hasIdentityIndex{ false };
+
+    // Items copied by each GetMany call while enumerating an iterable.
+    static constexpr uint32_t c_iteratorBufferSize = 1024;
+
     // To unhook event from data source
     tracker_ref<winrt::INotifyCollectionChanged> m_notifyCollectionChanged{ this };
     tracker_ref<winrt::IObservableVector<winrt::IInspectable>> m_observableVector{ this };
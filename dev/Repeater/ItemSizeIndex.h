@@ -0,0 +1,241 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+// Keeps track of the measured major size of every item by data index so that
+// virtualizing layouts can map between item indices and offsets without having
+// to extrapolate from a small sample. Items that have not been measured yet are
+// assumed to have the estimated size that is passed into each query (typically
+// the average of the measured items).
+//
+// Internally this is a pair of Fenwick (binary indexed) trees - one holding the
+// sum of measured sizes and one holding the number of measured items - which
+// gives O(log n) updates and O(log n) index->offset and offset->index queries.
+class ItemSizeIndex final
+{
+public:
+    int Count() const { return static_cast<int>(m_sizes.size()); }
+    int MeasuredCount() const { return m_measuredCount; }
+    double MeasuredTotal() const { return m_measuredTotal; }
+
+    bool IsMeasured(int index) const
+    {
+        return index >= 0 && index < Count() && m_measured[index];
+    }
+
+    void Clear()
+    {
+        m_sizes.clear();
+        m_measured.clear();
+        m_sizeTree.clear();
+        m_countTree.clear();
+        m_measuredTotal = 0.0;
+        m_measuredCount = 0;
+    }
+
+    // Makes sure the index covers at least count items. New items are unmeasured.
+    void EnsureCount(int count)
+    {
+        if (count > Count())
+        {
+            const int oldCount = Count();
+            m_sizes.resize(count, 0.0);
+            m_measured.resize(count, false);
+            RebuildFrom(oldCount);
+        }
+    }
+
+    void SetSize(int index, double size)
+    {
+        if (index < 0)
+        {
+            return;
+        }
+
+        if (index >= Count())
+        {
+            // Grow geometrically so that measuring items in increasing index order
+            // does not rebuild the trees for every new item.
+            EnsureCount(std::max(index + 1, Count() * 2));
+        }
+
+        double sizeDelta = size;
+        int countDelta = 1;
+        if (m_measured[index])
+        {
+            sizeDelta -= m_sizes[index];
+            countDelta = 0;
+        }
+
+        m_sizes[index] = size;
+        m_measured[index] = true;
+        m_measuredTotal += sizeDelta;
+        m_measuredCount += countDelta;
+        Update(index, sizeDelta, countDelta);
+    }
+
+    // Inserts count unmeasured items starting at index, shifting the sizes of
+    // the items after it.
+    void Insert(int index, int count)
+    {
+        if (count <= 0 || index < 0 || index > Count())
+        {
+            // Inserting past the end of what we know about does not affect anything.
+            return;
+        }
+
+        m_sizes.insert(m_sizes.begin() + index, count, 0.0);
+        m_measured.insert(m_measured.begin() + index, count, false);
+        RebuildFrom(index);
+    }
+
+    // Removes count items starting at index, shifting the sizes of the items
+    // after it.
+    void Remove(int index, int count)
+    {
+        if (count <= 0 || index < 0 || index >= Count())
+        {
+            return;
+        }
+
+        const int end = std::min(index + count, Count());
+        for (int i = index; i < end; i++)
+        {
+            if (m_measured[i])
+            {
+                m_measuredTotal -= m_sizes[i];
+                m_measuredCount--;
+            }
+        }
+
+        m_sizes.erase(m_sizes.begin() + index, m_sizes.begin() + end);
+        m_measured.erase(m_measured.begin() + index, m_measured.begin() + end);
+        RebuildFrom(index);
+    }
+
+    // Offset of the start of the item at index, assuming every item is followed
+    // by spacing. Items that have not been measured contribute estimatedSize.
+    double OffsetOf(int index, double estimatedSize, double spacing) const
+    {
+        if (index <= 0)
+        {
+            return 0.0;
+        }
+
+        const int known = std::min(index, Count());
+        double measuredSize = 0.0;
+        int measuredCount = 0;
+        for (int i = known; i > 0; i -= LowBit(i))
+        {
+            measuredSize += m_sizeTree[i - 1];
+            measuredCount += m_countTree[i - 1];
+        }
+
+        return measuredSize + (index - measuredCount) * estimatedSize + index * spacing;
+    }
+
+    // Index of the item that contains offset. Offsets before the first item map to
+    // 0. Offsets beyond the known items are extrapolated using estimatedSize, so the
+    // result can be larger than Count(). Callers are expected to clamp to their item count.
+    int IndexAt(double offset, double estimatedSize, double spacing) const
+    {
+        if (offset <= 0)
+        {
+            return 0;
+        }
+
+        // Descend the tree from the largest power of two, skipping every node
+        // whose entire range ends at or before offset.
+        const int count = Count();
+        int position = 0;
+        double consumed = 0.0;
+        for (int step = HighestPowerOfTwo(count); step > 0; step >>= 1)
+        {
+            const int next = position + step;
+            if (next <= count)
+            {
+                const double nodeExtent =
+                    m_sizeTree[next - 1] +
+                    (step - m_countTree[next - 1]) * estimatedSize +
+                    step * spacing;
+                if (consumed + nodeExtent <= offset)
+                {
+                    position = next;
+                    consumed += nodeExtent;
+                }
+            }
+        }
+
+        if (position == count)
+        {
+            const double stride = estimatedSize + spacing;
+            if (stride > 0)
+            {
+                position += static_cast<int>((offset - consumed) / stride);
+            }
+        }
+
+        return position;
+    }
+
+private:
+    static int LowBit(int i) { return i & (-i); }
+
+    static int HighestPowerOfTwo(int value)
+    {
+        int result = 0;
+        for (int bit = 1; bit > 0 && bit <= value; bit <<= 1)
+        {
+            result = bit;
+        }
+        return result;
+    }
+
+    void Update(int index, double sizeDelta, int countDelta)
+    {
+        const int count = Count();
+        for (int i = index + 1; i <= count; i += LowBit(i))
+        {
+            m_sizeTree[i - 1] += sizeDelta;
+            m_countTree[i - 1] += countDelta;
+        }
+    }
+
+    // Rebuilds the tree nodes of the items from index on after m_sizes/m_measured
+    // changed from there. A node only covers items up to its own position, so the
+    // nodes before index are still valid. Shifting the items after an insert or
+    // remove already costs O(n - index), which this matches.
+    void RebuildFrom(int index)
+    {
+        const int count = Count();
+        m_sizeTree.resize(count);
+        m_countTree.resize(count);
+
+        // Node i covers (i - LowBit(i), i]: its own item plus the nodes i - 1, i - 2,
+        // i - 4, ... below LowBit(i), which are all final by the time i is reached.
+        for (int i = index + 1; i <= count; i++)
+        {
+            double size = m_measured[i - 1] ? m_sizes[i - 1] : 0.0;
+            int measuredCount = m_measured[i - 1] ? 1 : 0;
+            for (int child = 1; child < LowBit(i); child <<= 1)
+            {
+                size += m_sizeTree[i - child - 1];
+                measuredCount += m_countTree[i - child - 1];
+            }
+
+            m_sizeTree[i - 1] = size;
+            m_countTree[i - 1] = measuredCount;
+        }
+    }
+
+    std::vector<double> m_sizes{};
+    std::vector<bool> m_measured{};
+    std::vector<double> m_sizeTree{};
+    std::vector<int> m_countTree{};
+    double m_measuredTotal{};
+    int m_measuredCount{};
+};
@@ -523,6 +523,8 @@ void ItemsRepeater::OnDataSourcePropertyChanged(const winrt::ItemsSourceView& ol
         m_itemsSourceViewChanged = newValue.CollectionChanged(winrt::auto_revoke, { this, &ItemsRepeater::OnItemsSourceViewChanged });
     }
 
+    m_keyedResetDiff.OnItemsSourceViewChanged(newValue);
+
     if (auto const layout = Layout())
     {
         auto const args = winrt::NotifyCollectionChangedEventArgs(
@@ -712,6 +714,43 @@ void ItemsRepeater::OnItemsSourceViewChanged(const winrt::IInspectable& sender,
         throw winrt::hresult_error(E_FAIL, L"Changes in the data source are not allowed during another change in the data source.");
     }
 
+    if (args.Action() == winrt::NotifyCollectionChangedAction::Reset)
+    {
+        // With a key index mapping, we can tell which items survived the reset. Replay it as
+        // the changes that lead from the previous keys to the current ones so that those
+        // items keep their containers instead of going through the reset pool.
+        int firstRealizedIndex = std::numeric_limits<int>::max();
+        int lastRealizedIndex = -1;
+        for (const auto& element : Children())
+        {
+            const auto virtInfo = GetVirtualizationInfo(element);
+            if (virtInfo->IsRealized())
+            {
+                firstRealizedIndex = std::min(firstRealizedIndex, virtInfo->Index());
+                lastRealizedIndex = std::max(lastRealizedIndex, virtInfo->Index());
+            }
+        }
+
+        std::vector<KeyedResetDiff::ScriptStep> script;
+        if (m_keyedResetDiff.TryGetScript(ItemsSourceView(), firstRealizedIndex, lastRealizedIndex, script))
+        {
+            for (const auto& step : script)
+            {
+                ProcessItemsSourceChange(sender, step.Change.ToArgs(ItemsSourceView(), step.SourceIndex));
+            }
+            return;
+        }
+    }
+    else
+    {
+        m_keyedResetDiff.OnItemsSourceChanged(ItemsSourceView(), CollectionChangeDiff::FromArgs(args));
+    }
+
+    ProcessItemsSourceChange(sender, args);
+}
+
+void ItemsRepeater::ProcessItemsSourceChange(const winrt::IInspectable& sender, const winrt::NotifyCollectionChangedEventArgs& args)
+{
     m_processingItemsSourceChange.set(args);
     auto processingChange = gsl::finally([this]()
     {
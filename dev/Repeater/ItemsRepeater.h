@@ -5,6 +5,7 @@
 
 #include "AnimationManager.h"
 #include "ViewManager.h"
+#include "KeyedResetDiff.h"
 #include "VirtualizationInfo.h"
 #include "ItemsRepeaterElementPreparedEventArgs.h"
 #include "ItemsRepeaterElementClearingEventArgs.h"
@@ -89,6 +90,7 @@ public:
     winrt::Rect RealizationWindow() const { return m_viewportManager->GetLayoutRealizationWindow(); }
     winrt::UIElement SuggestedAnchor() const { return m_viewportManager->SuggestedAnchor(); }
     winrt::UIElement MadeAnchor() const { return m_viewportManager->MadeAnchor(); }
+    winrt::Point ScrollVelocity() const { return m_viewportManager->ScrollVelocity(); }
     winrt::Point LayoutOrigin() const { return m_layoutOrigin; }
     void LayoutOrigin(winrt::Point value) { m_layoutOrigin = value; }
 
@@ -127,6 +129,7 @@ private:
     void OnAnimatorChanged(const winrt::ElementAnimator& oldValue, const winrt::ElementAnimator& newValue);
 
     void OnItemsSourceViewChanged(const winrt::IInspectable& sender, const winrt::NotifyCollectionChangedEventArgs& args);
+    void ProcessItemsSourceChange(const winrt::IInspectable& sender, const winrt::NotifyCollectionChangedEventArgs& args);
     void InvalidateMeasureForLayout(winrt::Layout const& sender, winrt::IInspectable const& args);
     void InvalidateArrangeForLayout(winrt::Layout const& sender, winrt::IInspectable const& args);
 
@@ -137,6 +140,7 @@ private:
 
     ::AnimationManager m_animationManager{ this };
     ::ViewManager m_viewManager{ this };
+    KeyedResetDiff m_keyedResetDiff{};
     std::shared_ptr<::ViewportManager> m_viewportManager{ nullptr };
 
     tracker_ref<winrt::ItemsSourceView> m_itemsSourceView{ this };
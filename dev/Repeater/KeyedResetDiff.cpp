@@ -0,0 +1,319 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#include <pch.h>
+#include <common.h>
+#include "KeyedResetDiff.h"
+
+void KeyedResetDiff::OnItemsSourceViewChanged(const winrt::ItemsSourceView& source)
+{
+    m_keys.clear();
+    m_hasSnapshot = source && source.HasKeyIndexMapping() && source.Count() <= c_maxSnapshotCount;
+    if (m_hasSnapshot)
+    {
+        TakeSnapshot(source);
+    }
+}
+
+void KeyedResetDiff::OnItemsSourceChanged(const winrt::ItemsSourceView& source, const CollectionChangeDiff& diff)
+{
+    if (!m_hasSnapshot)
+    {
+        return;
+    }
+
+    const int keyCount = static_cast<int>(m_keys.size());
+    if (diff.OldIndex < 0 ||
+        diff.OldIndex + diff.OldCount > keyCount ||
+        diff.NewIndex < 0 ||
+        diff.NewIndex + diff.NewCount > source.Count() ||
+        keyCount - diff.OldCount + diff.NewCount > c_maxSnapshotCount)
+    {
+        // The notification does not match what we know about the source, or the source
+        // grew too big to keep a snapshot of. Next reset will be a regular one.
+        m_keys.clear();
+        m_hasSnapshot = false;
+        return;
+    }
+
+    if (diff.Action == winrt::NotifyCollectionChangedAction::Move)
+    {
+        const auto begin = m_keys.begin() + std::min(diff.OldIndex, diff.NewIndex);
+        const auto end = m_keys.begin() + std::max(diff.OldIndex, diff.NewIndex) + diff.OldCount;
+        std::rotate(begin, diff.OldIndex < diff.NewIndex ? begin + diff.OldCount : end - diff.OldCount, end);
+        return;
+    }
+
+    m_keys.erase(m_keys.begin() + diff.OldIndex, m_keys.begin() + diff.OldIndex + diff.OldCount);
+    m_keys.insert(m_keys.begin() + diff.NewIndex, diff.NewCount, winrt::hstring{});
+    for (int i = 0; i < diff.NewCount; ++i)
+    {
+        m_keys[diff.NewIndex + i] = source.KeyFromIndex(diff.NewIndex + i);
+    }
+}
+
+bool KeyedResetDiff::TryGetScript(
+    const winrt::ItemsSourceView& source,
+    int firstRealizedIndex,
+    int lastRealizedIndex,
+    std::vector<ScriptStep>& script)
+{
+    script.clear();
+    if (!source || !source.HasKeyIndexMapping() || source.Count() > c_maxSnapshotCount)
+    {
+        m_keys.clear();
+        m_hasSnapshot = false;
+        return false;
+    }
+
+    const bool hadSnapshot = m_hasSnapshot;
+    auto oldKeys = std::move(m_keys);
+    m_keys.clear();
+    TakeSnapshot(source);
+    m_hasSnapshot = true;
+
+    if (!hadSnapshot)
+    {
+        return false;
+    }
+
+    if (TryGetScript(oldKeys, m_keys, script))
+    {
+        return true;
+    }
+
+    // The full replay is too long, which is typical of big sources that got sorted or filtered.
+    // Only the realized items need to keep their containers, so remove the items around them
+    // and replay the changes from what is left. That script is bounded by the realized count.
+    const int oldCount = static_cast<int>(oldKeys.size());
+    const int first = std::max(firstRealizedIndex, 0);
+    const int end = std::min(lastRealizedIndex + 1, oldCount);
+    if (first >= end)
+    {
+        return false;
+    }
+
+    const std::vector<winrt::hstring> realizedKeys(oldKeys.begin() + first, oldKeys.begin() + end);
+    std::vector<ScriptStep> realizedScript;
+    if (!TryGetScript(realizedKeys, m_keys, realizedScript))
+    {
+        return false;
+    }
+
+    script.clear();
+    script.reserve(realizedScript.size() + 2);
+    // The trailing items go first so that the index of the leading ones is not affected.
+    if (end < oldCount)
+    {
+        CollectionChangeDiff remove{};
+        remove.Action = winrt::NotifyCollectionChangedAction::Remove;
+        remove.OldIndex = remove.NewIndex = end;
+        remove.OldCount = oldCount - end;
+        script.push_back({ remove, -1 });
+    }
+    if (first > 0)
+    {
+        CollectionChangeDiff remove{};
+        remove.Action = winrt::NotifyCollectionChangedAction::Remove;
+        remove.OldIndex = remove.NewIndex = 0;
+        remove.OldCount = first;
+        script.push_back({ remove, -1 });
+    }
+    script.insert(script.end(), realizedScript.begin(), realizedScript.end());
+    return true;
+}
+
+/* static */
+bool KeyedResetDiff::TryGetScript(
+    const std::vector<winrt::hstring>& oldKeys,
+    const std::vector<winrt::hstring>& newKeys,
+    std::vector<ScriptStep>& script)
+{
+    const int oldCount = static_cast<int>(oldKeys.size());
+    const int newCount = static_cast<int>(newKeys.size());
+
+    std::unordered_map<winrt::hstring, int> newIndices;
+    newIndices.reserve(newKeys.size());
+    for (int newIndex = 0; newIndex < newCount; ++newIndex)
+    {
+        if (!newIndices.emplace(newKeys[newIndex], newIndex).second)
+        {
+            // Keys are not unique, the pool would reject them anyway.
+            return false;
+        }
+    }
+
+    // New index of every old item, -1 if it was removed.
+    std::vector<int> targets(oldKeys.size(), -1);
+    std::vector<bool> isKept(newKeys.size(), false);
+    for (int oldIndex = 0; oldIndex < oldCount; ++oldIndex)
+    {
+        const auto it = newIndices.find(oldKeys[oldIndex]);
+        if (it != newIndices.end())
+        {
+            if (isKept[it->second])
+            {
+                return false;
+            }
+
+            targets[oldIndex] = it->second;
+            isKept[it->second] = true;
+        }
+    }
+
+    // New indices of the kept items, in their old order.
+    std::vector<int> current;
+    current.reserve(oldKeys.size());
+    for (const int target : targets)
+    {
+        if (target >= 0)
+        {
+            current.push_back(target);
+        }
+    }
+
+    // Longest increasing subsequence of the new indices. Its items are already in the
+    // right order relative to each other and do not move, every other kept item does.
+    std::vector<int> tails;
+    std::vector<int> previous(current.size(), -1);
+    for (int i = 0; i < static_cast<int>(current.size()); ++i)
+    {
+        const auto tail = std::lower_bound(tails.begin(), tails.end(), current[i],
+            [&current](int position, int value) { return current[position] < value; });
+        if (tail != tails.begin())
+        {
+            previous[i] = *(tail - 1);
+        }
+
+        if (tail == tails.end())
+        {
+            tails.push_back(i);
+        }
+        else
+        {
+            *tail = i;
+        }
+    }
+
+    std::vector<bool> isPlaced(current.size(), false);
+    for (int i = tails.empty() ? -1 : tails.back(); i >= 0; i = previous[i])
+    {
+        isPlaced[i] = true;
+    }
+
+    // Count the changes before building them so that big
+    // changes bail out without doing the expensive part.
+    size_t scriptLength = current.size() - tails.size();
+    for (int i = 0; i < oldCount; ++i)
+    {
+        if (targets[i] < 0 && (i == 0 || targets[i - 1] >= 0))
+        {
+            ++scriptLength;
+        }
+    }
+    for (int i = 0; i < newCount; ++i)
+    {
+        if (!isKept[i] && (i == 0 || isKept[i - 1]))
+        {
+            ++scriptLength;
+        }
+    }
+
+    if (scriptLength > c_maxScriptLength)
+    {
+        return false;
+    }
+
+    script.reserve(scriptLength);
+
+    // Removes go from the back so that the indices of the ones left to do are not affected.
+    for (int end = oldCount - 1; end >= 0; --end)
+    {
+        if (targets[end] < 0)
+        {
+            int start = end;
+            while (start > 0 && targets[start - 1] < 0)
+            {
+                --start;
+            }
+
+            CollectionChangeDiff remove{};
+            remove.Action = winrt::NotifyCollectionChangedAction::Remove;
+            remove.OldIndex = remove.NewIndex = start;
+            remove.OldCount = end - start + 1;
+            script.push_back({ remove, -1 });
+            end = start;
+        }
+    }
+
+    // Move every item that is not placed yet right before the first placed item that comes
+    // after it. Going in the order of the new indices, that keeps the placed items sorted.
+    std::vector<int> moved;
+    for (int i = 0; i < static_cast<int>(current.size()); ++i)
+    {
+        if (!isPlaced[i])
+        {
+            moved.push_back(current[i]);
+        }
+    }
+    std::sort(moved.begin(), moved.end());
+
+    for (const int target : moved)
+    {
+        const int oldIndex = static_cast<int>(std::find(current.begin(), current.end(), target) - current.begin());
+        current.erase(current.begin() + oldIndex);
+        isPlaced.erase(isPlaced.begin() + oldIndex);
+
+        int newIndex = 0;
+        while (newIndex < static_cast<int>(current.size()) && !(isPlaced[newIndex] && current[newIndex] > target))
+        {
+            ++newIndex;
+        }
+
+        current.insert(current.begin() + newIndex, target);
+        isPlaced.insert(isPlaced.begin() + newIndex, true);
+
+        if (oldIndex != newIndex)
+        {
+            CollectionChangeDiff move{};
+            move.Action = winrt::NotifyCollectionChangedAction::Move;
+            move.OldIndex = oldIndex;
+            move.NewIndex = newIndex;
+            move.OldCount = move.NewCount = 1;
+            script.push_back({ move, target });
+        }
+    }
+
+    // The kept items are now in their final order, adds go from the front
+    // so that each one lands at its final index.
+    for (int start = 0; start < newCount; ++start)
+    {
+        if (!isKept[start])
+        {
+            int end = start;
+            while (end + 1 < newCount && !isKept[end + 1])
+            {
+                ++end;
+            }
+
+            CollectionChangeDiff add{};
+            add.Action = winrt::NotifyCollectionChangedAction::Add;
+            add.OldIndex = add.NewIndex = start;
+            add.NewCount = end - start + 1;
+            script.push_back({ add, start });
+            start = end;
+        }
+    }
+
+    return true;
+}
+
+void KeyedResetDiff::TakeSnapshot(const winrt::ItemsSourceView& source)
+{
+    const int count = source.Count();
+    m_keys.reserve(count);
+    for (int index = 0; index < count; ++index)
+    {
+        m_keys.push_back(source.KeyFromIndex(index));
+    }
+}
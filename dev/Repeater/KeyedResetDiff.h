@@ -0,0 +1,58 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include "CollectionChangeDiff.h"
+
+// Keeps the keys of a data source that has a key index mapping so that a Reset can be
+// replayed as the remove, move and add changes that turn the previous keys into the
+// current ones. Items that survive the reset keep their containers that way, and the
+// ones that kept their relative order (the longest increasing subsequence of their new
+// indices) are not touched at all.
+class KeyedResetDiff final
+{
+public:
+    struct ScriptStep
+    {
+        CollectionChangeDiff Change;
+        // Index in the current source of the first item that the change adds or moves, -1 for removes.
+        int SourceIndex{ -1 };
+    };
+
+    // Takes a snapshot of the keys of the new source if it has a key index mapping.
+    void OnItemsSourceViewChanged(const winrt::ItemsSourceView& source);
+
+    // Keeps the snapshot in sync with an incremental change.
+    void OnItemsSourceChanged(const winrt::ItemsSourceView& source, const CollectionChangeDiff& diff);
+
+    // Computes the changes that replay a Reset and takes a snapshot of the current keys.
+    // When the full replay is too long, only the items in [firstRealizedIndex, lastRealizedIndex]
+    // (indices before the Reset) are replayed, and the items around them are removed up front.
+    // Returns false if the Reset has to be processed as such.
+    bool TryGetScript(
+        const winrt::ItemsSourceView& source,
+        int firstRealizedIndex,
+        int lastRealizedIndex,
+        std::vector<ScriptStep>& script);
+
+    static bool TryGetScript(
+        const std::vector<winrt::hstring>& oldKeys,
+        const std::vector<winrt::hstring>& newKeys,
+        std::vector<ScriptStep>& script);
+
+private:
+    void TakeSnapshot(const winrt::ItemsSourceView& source);
+
+    // Past this, replaying the changes costs more than
+    // clearing the realized elements and realizing them again.
+    static constexpr size_t c_maxScriptLength = 256;
+
+    // Taking a snapshot asks the source for the key of every item when the source is set
+    // and on every Reset, incremental changes only ask for the keys of the added items.
+    // Past this many items, Resets are processed as such.
+    static constexpr int c_maxSnapshotCount = 100000;
+
+    std::vector<winrt::hstring> m_keys;
+    bool m_hasSnapshot{ false };
+};
@@ -62,24 +62,30 @@ void Phaser::PhaseElement(
 
     if (shouldPhase)
     {
-        // Insert at the top since we remove from bottom during DoPhasedWorkCallback. This keeps the ordering of items
-        // the same as the order in which items are realized.
-        m_pendingElements.insert(m_pendingElements.begin(), ElementInfo(element, virtInfo));
+        // Elements are queued by phase and distance from the visible window once they have been arranged.
+        const auto ticket = ++m_nextTicket;
+        m_pendingElements[virtInfo.get()] = PendingInfo{ ticket, m_timer.DurationInMilliSeconds() };
+        m_newElements.emplace_back(element, virtInfo, ticket);
         RegisterForCallback();
     }
 }
 
-void Phaser::StopPhasing(const winrt::UIElement& element, const winrt::com_ptr<VirtualizationInfo>& virtInfo)
+void Phaser::StopPhasing(const winrt::UIElement& /*element*/, const winrt::com_ptr<VirtualizationInfo>& virtInfo)
 {
-    // We need to remove the element from the pending elements list. We cannot just change the phase to -1
-    // since it will get updated when the element gets recycled.
+    // We need to remove the element from the pending elements. We cannot just change the phase to -1
+    // since it will get updated when the element gets recycled. Its entry in the queue is dropped
+    // when the queue reaches it.
     if (virtInfo->DataTemplateComponent())
     {
-        auto it = std::find_if(m_pendingElements.begin(), m_pendingElements.end(), [&element](const ElementInfo& info) { return info.Element() == element; });
+        if (m_pendingElements.erase(virtInfo.get()) > 0)
+        {
+            m_counters.AbandonedElements++;
+        }
 
-        if (it != m_pendingElements.end())
+        if (m_pendingElements.empty())
         {
-            m_pendingElements.erase(it);
+            m_newElements.clear();
+            m_buckets.clear();
         }
     }
 
@@ -93,15 +99,20 @@ void Phaser::DoPhasedWorkCallback()
 
     if (!m_pendingElements.empty() && !BuildTreeScheduler::ShouldYield())
     {
-        const auto visibleWindow = m_owner->VisibleWindow();
-        SortElements(visibleWindow);
-        int currentIndex = static_cast<int>(m_pendingElements.size()) - 1;
+        UpdateBuckets(m_owner->VisibleWindow());
         do
         {
-            const auto info = m_pendingElements[currentIndex];
-            const auto element = info.Element();
-            const auto virtInfo = info.VirtInfo();
-            const auto dataIndex = virtInfo->Index();
+            // Elements in the visible window go first, then the lowest phase.
+            auto bucket = GetNextBucket();
+            if (!bucket)
+            {
+                // Only elements phased during this callback are left.
+                break;
+            }
+
+            auto pendingElement = PopFromBucket(*bucket);
+            const auto element = pendingElement.Element();
+            const auto virtInfo = pendingElement.VirtInfo();
 
             const int currentPhase = virtInfo->Phase();
             if (currentPhase > 0)
@@ -116,45 +127,26 @@ void Phaser::DoPhasedWorkCallback()
                 if (nextPhase > 0)
                 {
                     virtInfo->Phase(nextPhase);
-                    // If we are the first item or 
-                    // If the current items phase is higher than the next items phase, then move to the next item.
-                    if (currentIndex == 0 ||
-                        virtInfo->Phase() > m_pendingElements[currentIndex - 1].VirtInfo()->Phase())
-                    {
-                        currentIndex--;
-                    }
+                    PushToBucket(m_buckets[nextPhase], std::move(pendingElement));
                 }
                 else
                 {
-                    m_pendingElements.erase(m_pendingElements.begin() + currentIndex);
-                    currentIndex--;
+                    const auto it = m_pendingElements.find(virtInfo.get());
+                    if (it != m_pendingElements.end())
+                    {
+                        const double latencyInMs = m_timer.DurationInMilliSeconds() - it->second.RealizedAtInMs;
+                        m_counters.CompletedElements++;
+                        m_counters.LastLatencyInMs = latencyInMs;
+                        m_counters.MaxLatencyInMs = std::max(m_counters.MaxLatencyInMs, latencyInMs);
+                        m_counters.TotalLatencyInMs += latencyInMs;
+                        m_pendingElements.erase(it);
+                    }
                 }
             }
             else
             {
                 throw winrt::hresult_error(E_FAIL, L"Cleared element found in pending list which is not expected");
             }
-
-            const auto pendingCount = static_cast<int>(m_pendingElements.size());
-            if (currentIndex == -1)
-            {
-                // Reached the top, start from the bottom again
-                currentIndex = pendingCount - 1;
-            }
-            else if (currentIndex > -1 && currentIndex < pendingCount - 1)
-            {
-                // If the next element is oustide the visible window and there are elements in the visible window
-                // go back to the visible window.
-                bool nextItemIsVisible = SharedHelpers::DoRectsIntersect(visibleWindow, m_pendingElements[currentIndex].VirtInfo()->ArrangeBounds());
-                if (!nextItemIsVisible)
-                {
-                    bool haveVisibleItems = SharedHelpers::DoRectsIntersect(visibleWindow, m_pendingElements[pendingCount - 1].VirtInfo()->ArrangeBounds());
-                    if (haveVisibleItems)
-                    {
-                        currentIndex = pendingCount - 1;
-                    }
-                }
-            }
         } while (!m_pendingElements.empty() && !BuildTreeScheduler::ShouldYield());
     }
 
@@ -162,6 +154,10 @@ void Phaser::DoPhasedWorkCallback()
     {
         RegisterForCallback();
     }
+    else
+    {
+        m_buckets.clear();
+    }
 }
 
 void Phaser::RegisterForCallback()
@@ -170,12 +166,26 @@ void Phaser::RegisterForCallback()
     {
         MUX_ASSERT(!m_pendingElements.empty());
         m_registeredForCallback = true;
+
+        // Use the phase of the element that runs next, or of an element not queued yet if that is lower.
+        int priority = std::numeric_limits<int>::max();
+        if (const auto bucket = GetNextBucket())
+        {
+            priority = bucket->front().VirtInfo()->Phase();
+        }
+
+        for (const auto& pendingElement : m_newElements)
+        {
+            priority = std::min(priority, pendingElement.VirtInfo()->Phase());
+        }
+
         BuildTreeScheduler::RegisterWork(
-            m_pendingElements[m_pendingElements.size() - 1].VirtInfo()->Phase(), // Use the phase of the last one in the sorted list
-            [this]()
+            priority,
+            [](void* phaser)
         {
-            DoPhasedWorkCallback();
-        });
+            static_cast<Phaser*>(phaser)->DoPhasedWorkCallback();
+        },
+            this);
     }
 }
 
@@ -184,44 +194,114 @@ void Phaser::MarkCallbackRecieved()
     m_registeredForCallback = false;
 }
 
-/* static */
-void Phaser::ValidatePhaseOrdering(int currentPhase, int nextPhase)
+// Distances only change when the visible window moves, so the buckets are only reordered then.
+// Elements phased since the last callback are added to the bucket of their phase.
+void Phaser::UpdateBuckets(const winrt::Rect& visibleWindow)
 {
-    if (nextPhase > 0 && nextPhase <= currentPhase)
+    if (visibleWindow != m_lastVisibleWindow)
     {
-        // nextPhase <= currentPhase is invalid
-        throw winrt::hresult_error(E_FAIL, L"Phases are required to be monotonically increasing.");
+        m_lastVisibleWindow = visibleWindow;
+        for (auto it = m_buckets.begin(); it != m_buckets.end();)
+        {
+            auto& bucket = it->second;
+            bucket.erase(
+                std::remove_if(bucket.begin(), bucket.end(), [this](const PendingElement& pendingElement) { return !IsPending(pendingElement); }),
+                bucket.end());
+
+            for (auto& pendingElement : bucket)
+            {
+                pendingElement.Distance(GetDistanceFromWindow(pendingElement.VirtInfo()->ArrangeBounds(), visibleWindow));
+            }
+
+            std::make_heap(bucket.begin(), bucket.end(), IsFartherFromWindow);
+            it = bucket.empty() ? m_buckets.erase(it) : std::next(it);
+        }
     }
-}
 
-void Phaser::SortElements(const winrt::Rect& visibleWindow)
-{
-    // Sort in descending order (inVisibleWindow, phase)
-    std::sort(
-        m_pendingElements.begin(),
-        m_pendingElements.end(),
-        [visibleWindow](const auto& lhs, const auto& rhs)
+    for (auto& pendingElement : m_newElements)
     {
-        const auto lhsBounds = lhs.VirtInfo()->ArrangeBounds();
-        const auto lhsIntersects = SharedHelpers::DoRectsIntersect(lhsBounds, visibleWindow);
-        const auto rhsBounds = rhs.VirtInfo()->ArrangeBounds();
-        const auto rhsIntersects = SharedHelpers::DoRectsIntersect(rhsBounds, visibleWindow);
-
-        if ((lhsIntersects && rhsIntersects) ||
-            (!lhsIntersects && !rhsIntersects))
+        if (IsPending(pendingElement))
         {
-            // Both are in the visible window or both are not
-            return lhs.VirtInfo()->Phase() < rhs.VirtInfo()->Phase();
+            pendingElement.Distance(GetDistanceFromWindow(pendingElement.VirtInfo()->ArrangeBounds(), visibleWindow));
+            const int phase = pendingElement.VirtInfo()->Phase();
+            PushToBucket(m_buckets[phase], std::move(pendingElement));
         }
-        else if (lhsIntersects)
+    }
+
+    m_newElements.clear();
+}
+
+// Returns the bucket of the lowest phase with an element in the visible window, or the
+// bucket of the lowest phase if no pending element is in the visible window.
+Phaser::PhaseBucket* Phaser::GetNextBucket()
+{
+    PhaseBucket* nextBucket = nullptr;
+    for (auto& [phase, bucket] : m_buckets)
+    {
+        while (!bucket.empty() && !IsPending(bucket.front()))
         {
-            // Left is in visible window
-            return false;
+            PopFromBucket(bucket);
         }
-        else
+
+        if (!bucket.empty())
         {
-            return true;
+            if (bucket.front().Distance() == 0.0f)
+            {
+                return &bucket;
+            }
+
+            if (!nextBucket)
+            {
+                nextBucket = &bucket;
+            }
         }
     }
-    );
+
+    return nextBucket;
+}
+
+bool Phaser::IsPending(const PendingElement& pendingElement) const
+{
+    const auto it = m_pendingElements.find(pendingElement.VirtInfo().get());
+    return it != m_pendingElements.end() && it->second.Ticket == pendingElement.Ticket();
+}
+
+/* static */
+void Phaser::PushToBucket(PhaseBucket& bucket, PendingElement&& pendingElement)
+{
+    bucket.push_back(std::move(pendingElement));
+    std::push_heap(bucket.begin(), bucket.end(), IsFartherFromWindow);
+}
+
+/* static */
+Phaser::PendingElement Phaser::PopFromBucket(PhaseBucket& bucket)
+{
+    std::pop_heap(bucket.begin(), bucket.end(), IsFartherFromWindow);
+    auto pendingElement = std::move(bucket.back());
+    bucket.pop_back();
+    return pendingElement;
+}
+
+/* static */
+bool Phaser::IsFartherFromWindow(const PendingElement& lhs, const PendingElement& rhs)
+{
+    return lhs.Distance() > rhs.Distance();
+}
+
+/* static */
+float Phaser::GetDistanceFromWindow(const winrt::Rect& bounds, const winrt::Rect& window)
+{
+    const float distanceX = std::max({ 0.0f, window.X - (bounds.X + bounds.Width), bounds.X - (window.X + window.Width) });
+    const float distanceY = std::max({ 0.0f, window.Y - (bounds.Y + bounds.Height), bounds.Y - (window.Y + window.Height) });
+    return std::max(distanceX, distanceY);
+}
+
+/* static */
+void Phaser::ValidatePhaseOrdering(int currentPhase, int nextPhase)
+{
+    if (nextPhase > 0 && nextPhase <= currentPhase)
+    {
+        // nextPhase <= currentPhase is invalid
+        throw winrt::hresult_error(E_FAIL, L"Phases are required to be monotonically increasing.");
+    }
 }
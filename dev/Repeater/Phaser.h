@@ -3,37 +3,93 @@
 
 #pragma once
 
-class ItemsRepeater;
+#include <map>
+#include <unordered_map>
 
-struct ElementInfo
-{
-    ElementInfo(const winrt::UIElement&  element, const winrt::com_ptr<VirtualizationInfo>& virtInfo) :
-        m_element(element),
-        m_virtInfo(virtInfo)
-    {}
+#include "QPCTimer.h"
 
-    winrt::UIElement Element() const { return m_element; }
-    winrt::com_ptr<VirtualizationInfo> VirtInfo() const { return m_virtInfo; }
-private:
-    winrt::UIElement m_element{ nullptr };
-    winrt::com_ptr<VirtualizationInfo> m_virtInfo{ nullptr };
-};
+class ItemsRepeater;
 
 class Phaser final
 {
 public:
+    struct PhasingCounters
+    {
+        // Elements that ran their last phase, and elements cleared before they did.
+        uint64_t CompletedElements{ 0 };
+        uint64_t AbandonedElements{ 0 };
+        // Time from the realization of an element until its last phase ran.
+        double LastLatencyInMs{ 0.0 };
+        double MaxLatencyInMs{ 0.0 };
+        double TotalLatencyInMs{ 0.0 };
+
+        double AverageLatencyInMs() const { return CompletedElements > 0 ? TotalLatencyInMs / CompletedElements : 0.0; }
+    };
+
     Phaser(ItemsRepeater* owner);
     void PhaseElement(const winrt::UIElement& element, const winrt::com_ptr<VirtualizationInfo>& virtInfo);
     void StopPhasing(const winrt::UIElement& element, const winrt::com_ptr<VirtualizationInfo>& virtInfo);
 
+    int PendingElementCount() const { return static_cast<int>(m_pendingElements.size()); }
+    const PhasingCounters& Counters() const { return m_counters; }
+    void ResetCounters() { m_counters = {}; }
+
 private:
+    struct PendingElement
+    {
+        PendingElement(const winrt::UIElement& element, const winrt::com_ptr<VirtualizationInfo>& virtInfo, uint64_t ticket) :
+            m_element(element),
+            m_virtInfo(virtInfo),
+            m_ticket(ticket)
+        {}
+
+        winrt::UIElement Element() const { return m_element; }
+        const winrt::com_ptr<VirtualizationInfo>& VirtInfo() const { return m_virtInfo; }
+        uint64_t Ticket() const { return m_ticket; }
+        float Distance() const { return m_distance; }
+        void Distance(float distance) { m_distance = distance; }
+
+    private:
+        winrt::UIElement m_element{ nullptr };
+        winrt::com_ptr<VirtualizationInfo> m_virtInfo{ nullptr };
+        uint64_t m_ticket{ 0 };
+        // Distance from the visible window, 0 when the element is in it.
+        float m_distance{ 0.0f };
+    };
+
+    struct PendingInfo
+    {
+        uint64_t Ticket;
+        double RealizedAtInMs;
+    };
+
+    // Elements waiting for the same phase, as a binary heap with the element closest
+    // to the visible window on top.
+    using PhaseBucket = std::vector<PendingElement>;
+
     void DoPhasedWorkCallback();
     void RegisterForCallback();
     void MarkCallbackRecieved();
-    void SortElements(const winrt::Rect& visibleWindow);
+    void UpdateBuckets(const winrt::Rect& visibleWindow);
+    PhaseBucket* GetNextBucket();
+    bool IsPending(const PendingElement& element) const;
+    static void PushToBucket(PhaseBucket& bucket, PendingElement&& element);
+    static PendingElement PopFromBucket(PhaseBucket& bucket);
+    static bool IsFartherFromWindow(const PendingElement& lhs, const PendingElement& rhs);
+    static float GetDistanceFromWindow(const winrt::Rect& bounds, const winrt::Rect& window);
     static void ValidatePhaseOrdering(int currentPhase, int nextPhase);
 
     ItemsRepeater* m_owner{ nullptr };
-    std::vector<ElementInfo> m_pendingElements{};
+    // Elements phased since the last callback. Their bounds are only known once they are arranged,
+    // so they are moved to their bucket at the start of the next callback.
+    std::vector<PendingElement> m_newElements{};
+    std::map<int /* phase */, PhaseBucket> m_buckets{};
+    // Elements that still have phases to run. Cleared elements are removed from here right away and
+    // their bucket entries are dropped when they are reached.
+    std::unordered_map<VirtualizationInfo*, PendingInfo> m_pendingElements{};
+    uint64_t m_nextTicket{ 0 };
+    winrt::Rect m_lastVisibleWindow{};
     bool m_registeredForCallback{ false };
+    QPCTimer m_timer{};
+    PhasingCounters m_counters{};
 };
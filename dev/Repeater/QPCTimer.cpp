@@ -19,16 +19,16 @@ void QPCTimer::Reset()
     QueryPerformanceCounter(&m_start);
 }
 
-int QPCTimer::DurationInMilliSeconds() const
+double QPCTimer::DurationInMilliSeconds() const
 {
     LARGE_INTEGER now;
     const auto success = QueryPerformanceCounter(&now);
-    int elapsedMilliSeconds = 0;
+    double elapsedMilliSeconds = 0.0;
 
     if (success)
     {
         const double elapsedSeconds = static_cast<DOUBLE>(now.QuadPart - m_start.QuadPart) / static_cast<DOUBLE>(m_frequency.QuadPart);
-        elapsedMilliSeconds = static_cast<int>(elapsedSeconds * 1000);
+        elapsedMilliSeconds = elapsedSeconds * 1000;
     }
     else
     {
@@ -45,24 +45,18 @@ void RecyclePool::PutElementCore(
     winrt::hstring const& key,
     winrt::UIElement const& owner)
 {
-
     const auto& winrtKey = key;
-    const auto iterator = m_elements.find(winrtKey);
     const auto& winrtOwner = owner;
     auto winrtOwnerAsPanel = EnsureOwnerIsPanelOrNull(winrtOwner);
+    void* ownerIdentity = OwnerIdentity(winrtOwnerAsPanel);
 
-    ElementInfo elementInfo{ this /* refManager */, element, winrtOwnerAsPanel };
+    m_pooledElements.emplace_back(this /* refManager */, element, winrtOwnerAsPanel, winrtKey, m_nextSequence++);
 
-    if (iterator != m_elements.end())
-    {
-        iterator->second.emplace_back(std::move(elementInfo));
-    }
-    else
-    {
-        std::vector<ElementInfo> pool;
-        pool.emplace_back(elementInfo);
-        m_elements.emplace(winrtKey, std::move(pool));
-    }
+    auto& keyPool = m_elements[winrtKey];
+    keyPool.m_ownerPools[ownerIdentity].push_back(std::prev(m_pooledElements.end()));
+    keyPool.m_count++;
+
+    TrimToCapacity(winrtKey);
 }
 
 winrt::UIElement RecyclePool::TryGetElementCore(
@@ -72,45 +66,41 @@ winrt::UIElement RecyclePool::TryGetElementCore(
     const auto iterator = m_elements.find(key);
     if (iterator != m_elements.end())
     {
-        auto& elements = iterator->second;
-        if (elements.size() > 0)
+        auto& keyPool = iterator->second;
+        const auto& winrtOwner = owner;
+        auto ownerAsPanel = EnsureOwnerIsPanelOrNull(winrtOwner);
+
+        // Prefer an element from the same owner, then one with no owner so that we don't incur
+        // the enter/leave cost during recycling. Otherwise take the most recently put element.
+        auto ownerPool = keyPool.m_ownerPools.find(OwnerIdentity(ownerAsPanel));
+        if (ownerPool == keyPool.m_ownerPools.end())
         {
-            ElementInfo elementInfo{ this /* refManager */, nullptr, nullptr };
-            // Prefer an element from the same owner or with no owner so that we don't incur
-            // the enter/leave cost during recycling.
-            // TODO: prioritize elements with the same owner to those without an owner.
-            const auto& winrtOwner = owner;
-            auto iter = std::find_if(
-                elements.begin(),
-                elements.end(),
-                [&winrtOwner](const ElementInfo& elemInfo) { return elemInfo.Owner() == winrtOwner || !elemInfo.Owner(); });
-
-            if (iter != elements.end())
-            {
-                elementInfo = *iter;
-                elements.erase(iter);
-            }
-            else
+            ownerPool = keyPool.m_ownerPools.find(nullptr);
+        }
+        if (ownerPool == keyPool.m_ownerPools.end())
+        {
+            for (auto it = keyPool.m_ownerPools.begin(); it != keyPool.m_ownerPools.end(); ++it)
             {
-                elementInfo = elements.back();
-                elements.pop_back();
+                if (ownerPool == keyPool.m_ownerPools.end() ||
+                    it->second.back()->m_sequence > ownerPool->second.back()->m_sequence)
+                {
+                    ownerPool = it;
+                }
             }
+        }
+
+        if (ownerPool != keyPool.m_ownerPools.end())
+        {
+            auto elementInfo = TakeElement(keyPool, ownerPool->second, ownerPool->first);
+            m_counters.Hits++;
 
-            auto ownerAsPanel = EnsureOwnerIsPanelOrNull(winrtOwner);
             if (elementInfo.Owner() && elementInfo.Owner() != ownerAsPanel)
             {
                 // Element is still under its parent. remove it from its parent.
-                auto panel = elementInfo.Owner();
-                if (panel)
+                m_counters.Reparents++;
+                if (!RemoveFromOwner(elementInfo))
                 {
-                    unsigned int childIndex = 0;
-                    bool found = panel.Children().IndexOf(elementInfo.Element(), childIndex);
-                    if (!found)
-                    {
-                        throw winrt::hresult_error(E_FAIL, L"ItemsRepeater's child not found in its Children collection.");
-                    }
-
-                    panel.Children().RemoveAt(childIndex);
+                    throw winrt::hresult_error(E_FAIL, L"ItemsRepeater's child not found in its Children collection.");
                 }
             }
 
@@ -118,12 +108,137 @@ winrt::UIElement RecyclePool::TryGetElementCore(
         }
     }
 
+    m_counters.Misses++;
     return nullptr;
 }
 
-
 #pragma endregion
 
+uint32_t RecyclePool::MaxElementsPerKey()
+{
+    return m_maxElementsPerKey;
+}
+
+void RecyclePool::MaxElementsPerKey(uint32_t value)
+{
+    m_maxElementsPerKey = value;
+
+    std::vector<winrt::hstring> keys;
+    keys.reserve(m_elements.size());
+    for (auto const& keyPool : m_elements)
+    {
+        keys.push_back(keyPool.first);
+    }
+
+    for (auto const& key : keys)
+    {
+        TrimToCapacity(key);
+    }
+}
+
+uint32_t RecyclePool::MaxElements()
+{
+    return m_maxElements;
+}
+
+void RecyclePool::MaxElements(uint32_t value)
+{
+    m_maxElements = value;
+    TrimToCapacity(winrt::hstring{});
+}
+
+/* static */
+void* RecyclePool::OwnerIdentity(const winrt::Panel& owner)
+{
+    return owner ? winrt::get_abi(owner.as<winrt::IUnknown>()) : nullptr;
+}
+
+// Removes the element from the children of the owner it was put with. Returns false if it was not a child anymore.
+/* static */
+bool RecyclePool::RemoveFromOwner(const ElementInfo& elementInfo)
+{
+    if (auto panel = elementInfo.Owner())
+    {
+        unsigned int childIndex = 0;
+        bool found = panel.Children().IndexOf(elementInfo.Element(), childIndex);
+        if (!found)
+        {
+            return false;
+        }
+
+        panel.Children().RemoveAt(childIndex);
+    }
+
+    return true;
+}
+
+// Takes the most recently put element out of the owner pool.
+RecyclePool::ElementInfo RecyclePool::TakeElement(KeyPool& keyPool, OwnerPool& ownerPool, void* ownerIdentity)
+{
+    const auto pooledElement = ownerPool.back();
+    ElementInfo elementInfo = pooledElement->m_info;
+
+    ownerPool.pop_back();
+    if (ownerPool.empty())
+    {
+        keyPool.m_ownerPools.erase(ownerIdentity);
+    }
+    keyPool.m_count--;
+    m_pooledElements.erase(pooledElement);
+
+    return elementInfo;
+}
+
+// Drops the least recently put element of the key pool.
+void RecyclePool::EvictOldest(KeyPool& keyPool)
+{
+    auto oldest = keyPool.m_ownerPools.end();
+    for (auto it = keyPool.m_ownerPools.begin(); it != keyPool.m_ownerPools.end(); ++it)
+    {
+        if (oldest == keyPool.m_ownerPools.end() ||
+            it->second.front()->m_sequence < oldest->second.front()->m_sequence)
+        {
+            oldest = it;
+        }
+    }
+
+    MUX_ASSERT(oldest != keyPool.m_ownerPools.end());
+    auto& ownerPool = oldest->second;
+    const auto pooledElement = ownerPool.front();
+    const ElementInfo elementInfo = pooledElement->m_info;
+
+    ownerPool.pop_front();
+    if (ownerPool.empty())
+    {
+        keyPool.m_ownerPools.erase(oldest);
+    }
+    keyPool.m_count--;
+    m_pooledElements.erase(pooledElement);
+    m_counters.Evictions++;
+
+    // The element is not going to be recycled, so it should not stay under its owner either.
+    RemoveFromOwner(elementInfo);
+}
+
+// Evicts the least recently put elements of key, then of the whole pool, until both are within capacity.
+void RecyclePool::TrimToCapacity(const winrt::hstring& key)
+{
+    const auto iterator = m_elements.find(key);
+    if (iterator != m_elements.end())
+    {
+        while (iterator->second.m_count > m_maxElementsPerKey)
+        {
+            EvictOldest(iterator->second);
+        }
+    }
+
+    while (m_pooledElements.size() > m_maxElements)
+    {
+        // The least recently put element of the pool is also the least recently put element of its key.
+        EvictOldest(m_elements[m_pooledElements.front().m_key]);
+    }
+}
+
 winrt::Panel RecyclePool::EnsureOwnerIsPanelOrNull(const winrt::UIElement& owner)
 {
     winrt::Panel ownerAsPanel = nullptr;
@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <deque>
+#include <list>
+#include <unordered_map>
+
 #include "RecyclePool.g.h"
 #include "RecyclePool.properties.h"
 
@@ -24,6 +28,11 @@ public:
     winrt::UIElement TryGetElement(
         winrt::hstring const& key,
         winrt::UIElement const& owner);
+
+    uint32_t MaxElementsPerKey();
+    void MaxElementsPerKey(uint32_t value);
+    uint32_t MaxElements();
+    void MaxElements(uint32_t value);
 #pragma endregion
 
 #pragma region IRecyclePoolOverrides
@@ -51,6 +60,21 @@ public:
     /* internal */
     static winrt::DependencyProperty GetOriginTemplateProperty() { return s_originTemplateProperty; };
 
+    struct PoolCounters
+    {
+        // TryGetElement calls that returned an element or found none.
+        uint64_t Hits{ 0 };
+        uint64_t Misses{ 0 };
+        // Elements dropped to stay within MaxElementsPerKey or MaxElements.
+        uint64_t Evictions{ 0 };
+        // Elements returned to a different owner than the one they were put with.
+        uint64_t Reparents{ 0 };
+    };
+
+    PoolCounters Counters() const { return m_counters; }
+    void ResetCounters() { m_counters = {}; }
+    uint32_t ElementCount() const { return static_cast<uint32_t>(m_pooledElements.size()); }
+
 private:
     static GlobalDependencyProperty s_reuseKeyProperty;
     static GlobalDependencyProperty s_originTemplateProperty;
@@ -70,5 +94,38 @@ private:
         tracker_ref<winrt::Panel> m_owner;
     };
 
-    std::map<winrt::hstring /*key*/, std::vector<ElementInfo>> m_elements;
+    // Every element in the pool, from the least to the most recently put. This is the eviction order.
+    struct PooledElement
+    {
+        PooledElement(const ITrackerHandleManager* refManager, const winrt::UIElement& element, const winrt::Panel& owner, const winrt::hstring& key, uint64_t sequence)
+            :m_info(refManager, element, owner), m_key(key), m_sequence(sequence) {}
+
+        ElementInfo m_info;
+        winrt::hstring m_key;
+        uint64_t m_sequence;
+    };
+    using PooledElements = std::list<PooledElement>;
+    using OwnerPool = std::deque<PooledElements::iterator>;
+
+    // The elements of one reuse key, split by owner so that TryGetElement finds an element of the
+    // requesting owner without a search. Elements put without an owner are under the null owner.
+    // Each owner pool is in put order.
+    struct KeyPool
+    {
+        std::unordered_map<void* /* owner identity */, OwnerPool> m_ownerPools;
+        size_t m_count{ 0 };
+    };
+
+    static void* OwnerIdentity(const winrt::Panel& owner);
+    static bool RemoveFromOwner(const ElementInfo& elementInfo);
+    ElementInfo TakeElement(KeyPool& keyPool, OwnerPool& ownerPool, void* ownerIdentity);
+    void EvictOldest(KeyPool& keyPool);
+    void TrimToCapacity(const winrt::hstring& key);
+
+    PooledElements m_pooledElements;
+    std::unordered_map<winrt::hstring /*key*/, KeyPool> m_elements;
+    uint64_t m_nextSequence{ 0 };
+    uint32_t m_maxElementsPerKey{ std::numeric_limits<uint32_t>::max() };
+    uint32_t m_maxElements{ std::numeric_limits<uint32_t>::max() };
+    PoolCounters m_counters{};
 };
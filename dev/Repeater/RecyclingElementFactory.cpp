@@ -9,6 +9,7 @@
 #include "RecyclingElementFactory.h"
 #include "ItemsRepeater.h"
 #include "RecyclePool.h"
+#include "BuildTreeScheduler.h"
 
 #include "RecyclingElementFactory.properties.cpp"
 
@@ -39,6 +40,33 @@ void RecyclingElementFactory::Templates(winrt::IMap<winrt::hstring, winrt::DataT
     m_templates.set(value);
 }
 
+bool RecyclingElementFactory::IsPrewarmingEnabled()
+{
+    return m_isPrewarmingEnabled;
+}
+
+void RecyclingElementFactory::IsPrewarmingEnabled(bool value)
+{
+    m_isPrewarmingEnabled = value;
+    if (!value)
+    {
+        // Elements already in the recycle pool stay there, we just stop tracking them.
+        m_templateHistory.clear();
+        m_prewarmedElements.clear();
+        m_prewarmedElementCount = 0;
+    }
+}
+
+uint32_t RecyclingElementFactory::MaxPrewarmedElements()
+{
+    return m_maxPrewarmedElements;
+}
+
+void RecyclingElementFactory::MaxPrewarmedElements(uint32_t value)
+{
+    m_maxPrewarmedElements = value;
+}
+
 #pragma endregion
 
 #pragma region IRecyclingElementFactoryOverrides
@@ -95,6 +123,7 @@ winrt::UIElement RecyclingElementFactory::GetElementCore(winrt::ElementFactoryGe
 
     // Get an element from the Recycle Pool or create one
     auto element = m_recyclePool.get().TryGetElement(templateKey, winrtOwner).as<winrt::FrameworkElement>();
+    const bool isColdCreation = !element;
 
     if (!element)
     {
@@ -112,6 +141,24 @@ winrt::UIElement RecyclingElementFactory::GetElementCore(winrt::ElementFactoryGe
         RecyclePool::SetReuseKey(element, templateKey);
     }
 
+    if (m_isPrewarmingEnabled)
+    {
+        const bool isOwnerScrolling = IsScrolling(winrtOwner);
+        OnTemplateSelected(templateKey, isColdCreation, isOwnerScrolling);
+        if (isColdCreation)
+        {
+            m_prewarmCounters.ColdCreations++;
+            if (isOwnerScrolling)
+            {
+                RegisterPrewarmWork();
+            }
+        }
+        else if (TakePrewarmedElement(templateKey, element))
+        {
+            m_prewarmCounters.AvoidedColdCreations++;
+        }
+    }
+
     return element;
 }
 
@@ -123,3 +170,160 @@ void RecyclingElementFactory::RecycleElementCore(winrt::ElementFactoryRecycleArg
 }
 
 #pragma endregion
+
+#pragma region Prewarming
+
+/* static */
+bool RecyclingElementFactory::IsScrolling(const winrt::UIElement& owner)
+{
+    if (auto repeater = owner.try_as<winrt::ItemsRepeater>())
+    {
+        const auto velocity = winrt::get_self<ItemsRepeater>(repeater)->ScrollVelocity();
+        return std::abs(velocity.X) >= c_minPrewarmScrollVelocity || std::abs(velocity.Y) >= c_minPrewarmScrollVelocity;
+    }
+
+    return false;
+}
+
+void RecyclingElementFactory::OnTemplateSelected(const winrt::hstring& templateKey, bool isColdCreation, bool isOwnerScrolling)
+{
+    const double nowInMs = m_prewarmTimer.DurationInMilliSeconds();
+    if (isOwnerScrolling)
+    {
+        m_prewarmCounters.ScrollTimeInMs += std::min(nowInMs - m_lastSelectionTimeInMs, c_maxScrollSampleIntervalInMs);
+    }
+    m_lastSelectionTimeInMs = nowInMs;
+
+    m_templateHistory.push_back({ templateKey, nowInMs, isColdCreation });
+    while (!m_templateHistory.empty() &&
+        (m_templateHistory.size() > c_maxTemplateHistoryLength ||
+         nowInMs - m_templateHistory.front().m_timeInMs > c_templateHistoryWindowInMs))
+    {
+        m_templateHistory.pop_front();
+    }
+}
+
+void RecyclingElementFactory::RegisterPrewarmWork()
+{
+    if (!m_isPrewarmWorkRegistered)
+    {
+        m_isPrewarmWorkRegistered = true;
+        // The scheduler does not hold a reference, so the work item owns one until it runs.
+        BuildTreeScheduler::RegisterWork(
+            c_prewarmWorkPriority,
+            [](void* context)
+        {
+            winrt::com_ptr<RecyclingElementFactory> factory;
+            factory.attach(static_cast<RecyclingElementFactory*>(context));
+            factory->DoPrewarmWork();
+        },
+            get_strong().detach());
+    }
+}
+
+// Creates elements of the templates that recently missed the recycle pool, in proportion
+// to how often they missed, until the expected misses are covered or the ceiling is hit.
+void RecyclingElementFactory::DoPrewarmWork()
+{
+    m_isPrewarmWorkRegistered = false;
+    if (!m_isPrewarmingEnabled || !m_recyclePool || !m_templates)
+    {
+        return;
+    }
+
+    PrunePrewarmedElements();
+
+    std::unordered_map<winrt::hstring, uint32_t> coldCreationCounts;
+    for (auto const& selection : m_templateHistory)
+    {
+        if (selection.m_isColdCreation)
+        {
+            coldCreationCounts[selection.m_templateKey]++;
+        }
+    }
+
+    auto templates = m_templates.get();
+    auto recyclePool = m_recyclePool.get();
+    bool hasPendingWork = false;
+    for (auto const& [templateKey, coldCreationCount] : coldCreationCounts)
+    {
+        const auto target = static_cast<size_t>(std::ceil(coldCreationCount * c_prewarmLookaheadInMs / c_templateHistoryWindowInMs));
+        auto& prewarmedElements = m_prewarmedElements[templateKey];
+        if (prewarmedElements.size() >= target || !templates.HasKey(templateKey))
+        {
+            continue;
+        }
+
+        const auto dataTemplate = templates.Lookup(templateKey);
+        while (prewarmedElements.size() < target && m_prewarmedElementCount < m_maxPrewarmedElements)
+        {
+            if (BuildTreeScheduler::ShouldYield())
+            {
+                hasPendingWork = true;
+                break;
+            }
+
+            auto element = dataTemplate.LoadContent().as<winrt::FrameworkElement>();
+            RecyclePool::SetReuseKey(element, templateKey);
+            recyclePool.PutElement(element, templateKey, nullptr /* owner */);
+            prewarmedElements.push_back(winrt::make_weak<winrt::UIElement>(element));
+            m_prewarmedElementCount++;
+            m_prewarmCounters.PrewarmedElements++;
+        }
+
+        if (hasPendingWork)
+        {
+            break;
+        }
+    }
+
+    REPEATER_TRACE_INFO(L"Prewarm: %d pending, %.1f cold creations avoided per second of scroll. \n",
+        static_cast<int>(m_prewarmedElementCount),
+        m_prewarmCounters.AvoidedColdCreationsPerSecond());
+
+    if (hasPendingWork)
+    {
+        RegisterPrewarmWork();
+    }
+}
+
+bool RecyclingElementFactory::TakePrewarmedElement(const winrt::hstring& templateKey, const winrt::UIElement& element)
+{
+    const auto iterator = m_prewarmedElements.find(templateKey);
+    if (iterator != m_prewarmedElements.end())
+    {
+        auto& prewarmedElements = iterator->second;
+        for (auto it = prewarmedElements.begin(); it != prewarmedElements.end(); ++it)
+        {
+            if (it->get() == element)
+            {
+                *it = std::move(prewarmedElements.back());
+                prewarmedElements.pop_back();
+                m_prewarmedElementCount--;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Forgets prewarmed elements that the recycle pool dropped or that another factory sharing it took.
+void RecyclingElementFactory::PrunePrewarmedElements()
+{
+    for (auto& [templateKey, prewarmedElements] : m_prewarmedElements)
+    {
+        const auto newEnd = std::remove_if(
+            prewarmedElements.begin(),
+            prewarmedElements.end(),
+            [](const winrt::weak_ref<winrt::UIElement>& weakElement)
+        {
+            const auto element = weakElement.get();
+            return !element || CachedVisualTreeHelpers::GetParent(element);
+        });
+        m_prewarmedElementCount -= std::distance(newEnd, prewarmedElements.end());
+        prewarmedElements.erase(newEnd, prewarmedElements.end());
+    }
+}
+
+#pragma endregion
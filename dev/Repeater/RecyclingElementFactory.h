@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <deque>
+#include <unordered_map>
+
 #include "ElementFactory.h"
+#include "QPCTimer.h"
 #include "RecyclingElementFactory.g.h"
 #include "RecyclingElementFactory.properties.h"
 
@@ -21,6 +25,11 @@ public:
     winrt::IMap<winrt::hstring, winrt::DataTemplate> Templates();
     void Templates(winrt::IMap<winrt::hstring, winrt::DataTemplate> const& value);
 
+    bool IsPrewarmingEnabled();
+    void IsPrewarmingEnabled(bool value);
+
+    uint32_t MaxPrewarmedElements();
+    void MaxPrewarmedElements(uint32_t value);
 #pragma endregion
 
 #pragma region IRecyclingElementFactoryOverrides
@@ -32,8 +41,66 @@ public:
     void RecycleElementCore(winrt::ElementFactoryRecycleArgs const& args);
 #pragma endregion
 
+    struct PrewarmCounters
+    {
+        // Elements created ahead of time and put in the recycle pool.
+        uint64_t PrewarmedElements{ 0 };
+        // Elements created in GetElement because the recycle pool had none of the template.
+        uint64_t ColdCreations{ 0 };
+        // Prewarmed elements handed out by GetElement, each of which would otherwise have been a cold creation.
+        uint64_t AvoidedColdCreations{ 0 };
+        // Time the owners were scrolling while elements were requested.
+        double ScrollTimeInMs{ 0.0 };
+
+        double AvoidedColdCreationsPerSecond() const
+        {
+            return ScrollTimeInMs > 0.0 ? AvoidedColdCreations * 1000.0 / ScrollTimeInMs : 0.0;
+        }
+    };
+
+    PrewarmCounters Counters() const { return m_prewarmCounters; }
+    void ResetCounters() { m_prewarmCounters = {}; }
+
 private:
+    static bool IsScrolling(const winrt::UIElement& owner);
+    void OnTemplateSelected(const winrt::hstring& templateKey, bool isColdCreation, bool isOwnerScrolling);
+    void RegisterPrewarmWork();
+    void DoPrewarmWork();
+    bool TakePrewarmedElement(const winrt::hstring& templateKey, const winrt::UIElement& element);
+    void PrunePrewarmedElements();
+
+    // Owners scrolling slower than this, in pixels per second, are considered idle.
+    static constexpr float c_minPrewarmScrollVelocity = 50.0f;
+    // Template selections older than this do not influence prewarming.
+    static constexpr double c_templateHistoryWindowInMs = 1000.0;
+    static constexpr size_t c_maxTemplateHistoryLength = 256;
+    // Prewarming tries to cover the cold creations expected over this long at the recent rate.
+    static constexpr double c_prewarmLookaheadInMs = 250.0;
+    static constexpr double c_maxScrollSampleIntervalInMs = 200.0;
+    static constexpr uint32_t c_defaultMaxPrewarmedElements = 20;
+    // Prewarming runs after all phased work.
+    static constexpr int c_prewarmWorkPriority = std::numeric_limits<int>::max();
+
+    struct TemplateSelection
+    {
+        winrt::hstring m_templateKey;
+        double m_timeInMs;
+        bool m_isColdCreation;
+    };
+
     tracker_ref<winrt::RecyclePool> m_recyclePool{ this };
     tracker_ref<winrt::IMap<winrt::hstring, winrt::DataTemplate>> m_templates{ this };
     tracker_ref<winrt::SelectTemplateEventArgs> m_args{ this };
+
+    bool m_isPrewarmingEnabled{ false };
+    uint32_t m_maxPrewarmedElements{ c_defaultMaxPrewarmedElements };
+    bool m_isPrewarmWorkRegistered{ false };
+    // Clock for the template selection history, never reset.
+    QPCTimer m_prewarmTimer{};
+    double m_lastSelectionTimeInMs{ 0.0 };
+    std::deque<TemplateSelection> m_templateHistory;
+    // Prewarmed elements that have not been handed out yet, by template key.
+    std::unordered_map<winrt::hstring, std::vector<winrt::weak_ref<winrt::UIElement>>> m_prewarmedElements;
+    size_t m_prewarmedElementCount{ 0 };
+    PrewarmCounters m_prewarmCounters{};
 };
@@ -3,10 +3,17 @@
 
 #include "pch.h"
 #include "common.h"
+#include "ItemsRepeater.common.h"
 #include "RepeaterTestHooksFactory.h"
 #include "layout.h"
 #include "ElementFactoryGetArgs.h"
 #include "ElementFactoryRecycleArgs.h"
+#include "QPCTimer.h"
+#include "BuildTreeScheduler.h"
+#include "RecyclePool.h"
+#include "RecyclingElementFactory.h"
+#include "ItemsRepeater.h"
+#include "Vector.h"
 
 
 winrt::event_token RepeaterTestHooks::BuildTreeCompletedImpl(
@@ -67,4 +74,129 @@ void RepeaterTestHooks::SetLayoutId(winrt::IInspectable const& layout, const hst
     {
         instance->LayoutId(id);
     }
-}
\ No newline at end of file
+}
+
+namespace
+{
+    template <typename T>
+    int IndexOf(winrt::IVectorView<T> const& view, T const& value)
+    {
+        uint32_t index = 0;
+        return view.IndexOf(value, index) ? static_cast<int>(index) : -1;
+    }
+
+    template <typename T>
+    winrt::IVector<T> GetMany(winrt::IVectorView<T> const& view, uint32_t startIndex, uint32_t capacity)
+    {
+        std::vector<T> values(capacity, nullptr);
+        const uint32_t count = view.GetMany(startIndex, values);
+
+        auto result = winrt::make<Vector<T>>();
+        for (uint32_t i = 0; i < count; i++)
+        {
+            result.Append(values[i]);
+        }
+        return result;
+    }
+}
+
+/* static */
+int RepeaterTestHooks::SelectedItemsIndexOf(winrt::SelectionModel const& selectionModel, winrt::IInspectable const& item)
+{
+    return IndexOf(selectionModel.SelectedItems(), item);
+}
+
+/* static */
+int RepeaterTestHooks::SelectedIndicesIndexOf(winrt::SelectionModel const& selectionModel, winrt::IndexPath const& index)
+{
+    return IndexOf(selectionModel.SelectedIndices(), index);
+}
+
+/* static */
+winrt::IVector<winrt::IInspectable> RepeaterTestHooks::SelectedItemsGetMany(winrt::SelectionModel const& selectionModel, uint32_t startIndex, uint32_t capacity)
+{
+    return GetMany(selectionModel.SelectedItems(), startIndex, capacity);
+}
+
+/* static */
+winrt::IVector<winrt::IndexPath> RepeaterTestHooks::SelectedIndicesGetMany(winrt::SelectionModel const& selectionModel, uint32_t startIndex, uint32_t capacity)
+{
+    return GetMany(selectionModel.SelectedIndices(), startIndex, capacity);
+}
+
+/* static */
+winrt::BuildTreeSchedulerCounters RepeaterTestHooks::GetBuildTreeSchedulerCounters()
+{
+    const auto counters = BuildTreeScheduler::Counters();
+    return winrt::BuildTreeSchedulerCounters{
+        static_cast<int64_t>(counters.FrameCount),
+        static_cast<int64_t>(counters.WorkCount),
+        static_cast<int32_t>(counters.LastFrameWorkCount),
+        static_cast<int64_t>(counters.DeferredWorkCount),
+        static_cast<int64_t>(counters.BudgetOverrunCount),
+        counters.BudgetInMs,
+        counters.FrameIntervalInMs };
+}
+
+/* static */
+void RepeaterTestHooks::ResetBuildTreeSchedulerCounters()
+{
+    BuildTreeScheduler::ResetCounters();
+}
+
+/* static */
+winrt::RecyclePoolCounters RepeaterTestHooks::GetRecyclePoolCounters(winrt::RecyclePool const& pool)
+{
+    const auto poolImpl = winrt::get_self<RecyclePool>(pool);
+    const auto counters = poolImpl->Counters();
+    return winrt::RecyclePoolCounters{
+        static_cast<int64_t>(counters.Hits),
+        static_cast<int64_t>(counters.Misses),
+        static_cast<int64_t>(counters.Evictions),
+        static_cast<int64_t>(counters.Reparents),
+        static_cast<int32_t>(poolImpl->ElementCount()) };
+}
+
+/* static */
+void RepeaterTestHooks::ResetRecyclePoolCounters(winrt::RecyclePool const& pool)
+{
+    winrt::get_self<RecyclePool>(pool)->ResetCounters();
+}
+
+/* static */
+winrt::RecyclingElementFactoryPrewarmCounters RepeaterTestHooks::GetRecyclingElementFactoryPrewarmCounters(winrt::RecyclingElementFactory const& factory)
+{
+    const auto counters = winrt::get_self<RecyclingElementFactory>(factory)->Counters();
+    return winrt::RecyclingElementFactoryPrewarmCounters{
+        static_cast<int64_t>(counters.PrewarmedElements),
+        static_cast<int64_t>(counters.ColdCreations),
+        static_cast<int64_t>(counters.AvoidedColdCreations),
+        counters.ScrollTimeInMs,
+        counters.AvoidedColdCreationsPerSecond() };
+}
+
+/* static */
+void RepeaterTestHooks::ResetRecyclingElementFactoryPrewarmCounters(winrt::RecyclingElementFactory const& factory)
+{
+    winrt::get_self<RecyclingElementFactory>(factory)->ResetCounters();
+}
+
+/* static */
+winrt::PhaserCounters RepeaterTestHooks::GetPhaserCounters(winrt::ItemsRepeater const& repeater)
+{
+    auto& phaser = winrt::get_self<ItemsRepeater>(repeater)->ViewManager().Phaser();
+    const auto counters = phaser.Counters();
+    return winrt::PhaserCounters{
+        static_cast<int64_t>(counters.CompletedElements),
+        static_cast<int64_t>(counters.AbandonedElements),
+        static_cast<int32_t>(phaser.PendingElementCount()),
+        counters.LastLatencyInMs,
+        counters.MaxLatencyInMs,
+        counters.AverageLatencyInMs() };
+}
+
+/* static */
+void RepeaterTestHooks::ResetPhaserCounters(winrt::ItemsRepeater const& repeater)
+{
+    winrt::get_self<ItemsRepeater>(repeater)->ViewManager().Phaser().ResetCounters();
+}
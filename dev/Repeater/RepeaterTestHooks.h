@@ -22,6 +22,14 @@ public:
     static winrt::event_token BuildTreeCompleted(winrt::TypedEventHandler<winrt::IInspectable, winrt::IInspectable> const& value); // subscribe
     static void BuildTreeCompleted(winrt::event_token const& token); // unsubscribe
     static void NotifyBuildTreeCompleted();
+    static winrt::BuildTreeSchedulerCounters GetBuildTreeSchedulerCounters();
+    static void ResetBuildTreeSchedulerCounters();
+    static winrt::RecyclePoolCounters GetRecyclePoolCounters(winrt::RecyclePool const& pool);
+    static void ResetRecyclePoolCounters(winrt::RecyclePool const& pool);
+    static winrt::RecyclingElementFactoryPrewarmCounters GetRecyclingElementFactoryPrewarmCounters(winrt::RecyclingElementFactory const& factory);
+    static void ResetRecyclingElementFactoryPrewarmCounters(winrt::RecyclingElementFactory const& factory);
+    static winrt::PhaserCounters GetPhaserCounters(winrt::ItemsRepeater const& repeater);
+    static void ResetPhaserCounters(winrt::ItemsRepeater const& repeater);
 
     static winrt::IInspectable CreateRepeaterElementFactoryGetArgs();
     static winrt::IInspectable CreateRepeaterElementFactoryRecycleArgs();
@@ -30,6 +38,11 @@ public:
     static hstring GetLayoutId(winrt::IInspectable const& layout);
     static void SetLayoutId(winrt::IInspectable const& layout, const hstring& id);
 
+    static int SelectedItemsIndexOf(winrt::SelectionModel const& selectionModel, winrt::IInspectable const& item);
+    static int SelectedIndicesIndexOf(winrt::SelectionModel const& selectionModel, winrt::IndexPath const& index);
+    static winrt::IVector<winrt::IInspectable> SelectedItemsGetMany(winrt::SelectionModel const& selectionModel, uint32_t startIndex, uint32_t capacity);
+    static winrt::IVector<winrt::IndexPath> SelectedIndicesGetMany(winrt::SelectionModel const& selectionModel, uint32_t startIndex, uint32_t capacity);
+
 private:
     static RepeaterTestHooks* s_testHooks;
 
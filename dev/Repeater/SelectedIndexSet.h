@@ -0,0 +1,747 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Set of non-negative indices that SelectionNode uses to keep track of the selected
+// items of a data source. This is a roaring-style hybrid container: the index space
+// is cut into chunks of at most ChunkSpan indices, and each chunk stores its indices
+// either as sorted runs (compact for contiguous selections) or as a dense bitmap
+// (compact for scattered selections like every other row), whichever is smaller.
+//
+// Unlike roaring bitmaps, chunks are not aligned on multiples of ChunkSpan. Each
+// chunk carries its own begin so that inserting or removing items in the source only
+// rewrites the chunk where the change happens and moves the begin of the chunks
+// after it, instead of shifting every selected index.
+//
+// Contains and PositionOf are O(log chunks) plus a bounded amount of work in the
+// chunk. IndexAt keeps a cursor so that walking the selection in order is amortized
+// O(1) per index.
+class SelectedIndexSet final
+{
+public:
+    static constexpr int ChunkSpan = 1 << 16;
+
+    int Count() const { return m_count; }
+    bool Empty() const { return m_count == 0; }
+
+    void Clear()
+    {
+        m_chunks.clear();
+        m_count = 0;
+        OnChanged();
+    }
+
+    bool Contains(int index) const
+    {
+        const int chunkIndex = FindChunk(index);
+        return chunkIndex >= 0 && ContainsLocal(m_chunks[chunkIndex], index - m_chunks[chunkIndex].begin);
+    }
+
+    // Largest index in the set, or -1 if the set is empty.
+    int LastIndex() const
+    {
+        if (m_chunks.empty())
+        {
+            return -1;
+        }
+
+        const Chunk& chunk = m_chunks.back();
+        if (chunk.IsBitmap())
+        {
+            for (int word = static_cast<int>(chunk.bits.size()) - 1; word >= 0; word--)
+            {
+                if (const uint64_t bits = chunk.bits[word])
+                {
+                    int bit = 63;
+                    while (!(bits & (1ull << bit)))
+                    {
+                        bit--;
+                    }
+                    return chunk.begin + word * 64 + bit;
+                }
+            }
+        }
+        return chunk.begin + chunk.runs.back().end;
+    }
+
+    // Adds the inclusive range [begin, end] and returns how many indices were not
+    // in the set before.
+    int AddRange(int begin, int end)
+    {
+        int added = 0;
+        for (int index = begin; index <= end;)
+        {
+            int chunkIndex = FindChunk(index);
+            if (chunkIndex < 0)
+            {
+                chunkIndex = CreateChunk(index);
+            }
+
+            Chunk& chunk = m_chunks[chunkIndex];
+            const int chunkEnd = std::min(end, chunk.begin + chunk.span - 1);
+            added += AddLocal(chunk, index - chunk.begin, chunkEnd - chunk.begin);
+
+            if (chunkEnd == std::numeric_limits<int>::max())
+            {
+                break;
+            }
+            index = chunkEnd + 1;
+        }
+
+        m_count += added;
+        OnChanged();
+        return added;
+    }
+
+    // Removes the inclusive range [begin, end] and returns how many indices were
+    // in the set before.
+    int RemoveRange(int begin, int end)
+    {
+        int removed = 0;
+        size_t chunkIndex = FirstChunkEndingAfter(begin);
+        while (chunkIndex < m_chunks.size() && m_chunks[chunkIndex].begin <= end)
+        {
+            Chunk& chunk = m_chunks[chunkIndex];
+            const int localBegin = std::max(begin, chunk.begin) - chunk.begin;
+            const int localEnd = std::min(end, chunk.begin + chunk.span - 1) - chunk.begin;
+            removed += RemoveLocal(chunk, localBegin, localEnd);
+
+            if (chunk.count == 0)
+            {
+                m_chunks.erase(m_chunks.begin() + chunkIndex);
+            }
+            else
+            {
+                chunkIndex++;
+            }
+        }
+
+        m_count -= removed;
+        OnChanged();
+        return removed;
+    }
+
+    // Items were inserted in the source: shifts every index at or after index
+    // right by count. The inserted indices are not in the set.
+    void Insert(int index, int count)
+    {
+        if (count <= 0)
+        {
+            return;
+        }
+
+        size_t chunkIndex = FirstChunkEndingAfter(index);
+        if (chunkIndex < m_chunks.size() && m_chunks[chunkIndex].begin < index)
+        {
+            // The insertion point is inside this chunk. Grow it in place when it has
+            // room for the new items, otherwise split it at the insertion point.
+            Chunk& chunk = m_chunks[chunkIndex];
+            const int local = index - chunk.begin;
+            ToRuns(chunk);
+
+            if (chunk.span + count <= ChunkSpan)
+            {
+                for (size_t runIndex = 0; runIndex < chunk.runs.size(); runIndex++)
+                {
+                    Run& run = chunk.runs[runIndex];
+                    if (run.begin >= local)
+                    {
+                        run = { run.begin + count, run.end + count };
+                    }
+                    else if (run.end >= local)
+                    {
+                        const Run after{ local + count, run.end + count };
+                        run = { run.begin, local - 1 };
+                        chunk.runs.insert(chunk.runs.begin() + runIndex + 1, after);
+                        runIndex++;
+                    }
+                }
+                chunk.span += count;
+                Optimize(chunk);
+            }
+            else
+            {
+                Chunk after = SplitChunk(chunk, local);
+                after.begin = index + count;
+                Optimize(chunk);
+                Optimize(after);
+
+                if (chunk.count == 0)
+                {
+                    chunk = std::move(after);
+                }
+                else if (after.count > 0)
+                {
+                    m_chunks.insert(m_chunks.begin() + chunkIndex + 1, std::move(after));
+                    chunkIndex++;
+                }
+            }
+            chunkIndex++;
+        }
+
+        for (; chunkIndex < m_chunks.size(); chunkIndex++)
+        {
+            m_chunks[chunkIndex].begin += count;
+        }
+
+        OnChanged();
+    }
+
+    // Items were removed from the source: drops the indices in [index, index + count)
+    // and shifts every index after them left by count. Returns how many indices were
+    // dropped from the set.
+    int Remove(int index, int count)
+    {
+        if (count <= 0)
+        {
+            return 0;
+        }
+
+        const int end = index + count - 1;
+        const int removed = RemoveRange(index, end);
+
+        size_t chunkIndex = FirstChunkEndingAfter(index);
+        const size_t firstAffected = chunkIndex;
+        for (; chunkIndex < m_chunks.size(); chunkIndex++)
+        {
+            Chunk& chunk = m_chunks[chunkIndex];
+            if (chunk.begin > end)
+            {
+                chunk.begin -= count;
+                continue;
+            }
+
+            // The chunk overlaps the removed indices, which are no longer in the set.
+            // Collapse them out of the chunk.
+            const int localBegin = std::max(index, chunk.begin) - chunk.begin;
+            const int localEnd = std::min(end, chunk.begin + chunk.span - 1) - chunk.begin;
+            const int collapsed = localEnd - localBegin + 1;
+            ToRuns(chunk);
+            for (Run& run : chunk.runs)
+            {
+                if (run.begin > localEnd)
+                {
+                    run = { run.begin - collapsed, run.end - collapsed };
+                }
+            }
+            chunk.span -= collapsed;
+            chunk.begin = std::min(chunk.begin, index);
+            Optimize(chunk);
+        }
+
+        // Neighbours of the removed indices can end up adjacent with room to spare.
+        if (firstAffected > 0)
+        {
+            TryMergeWithNext(firstAffected - 1);
+        }
+        TryMergeWithNext(firstAffected);
+
+        OnChanged();
+        return removed;
+    }
+
+    // Returns the index at position in the sorted set, or -1 if position is out of range.
+    int IndexAt(int position) const
+    {
+        if (position < 0 || position >= m_count)
+        {
+            return -1;
+        }
+
+        EnsureCountsBefore();
+        const int chunkIndex = static_cast<int>(std::upper_bound(m_countsBefore.begin(), m_countsBefore.end(), position) - m_countsBefore.begin()) - 1;
+        const Chunk& chunk = m_chunks[chunkIndex];
+        const int k = position - m_countsBefore[chunkIndex];
+
+        // Resume from the cursor when walking forward in the same chunk.
+        if (m_cursor.chunk != chunkIndex || m_cursor.countBefore > k)
+        {
+            m_cursor = { chunkIndex, 0, 0 };
+        }
+
+        if (chunk.IsBitmap())
+        {
+            for (;; m_cursor.unit++)
+            {
+                const uint64_t bits = chunk.bits[m_cursor.unit];
+                const int bitCount = PopCount(bits);
+                if (m_cursor.countBefore + bitCount > k)
+                {
+                    return chunk.begin + m_cursor.unit * 64 + SelectInWord(bits, k - m_cursor.countBefore);
+                }
+                m_cursor.countBefore += bitCount;
+            }
+        }
+
+        for (;; m_cursor.unit++)
+        {
+            const Run& run = chunk.runs[m_cursor.unit];
+            const int runCount = run.end - run.begin + 1;
+            if (m_cursor.countBefore + runCount > k)
+            {
+                return chunk.begin + run.begin + (k - m_cursor.countBefore);
+            }
+            m_cursor.countBefore += runCount;
+        }
+    }
+
+    // Returns the position of index in the sorted set, or -1 if it is not in the set.
+    int PositionOf(int index) const
+    {
+        const int chunkIndex = FindChunk(index);
+        if (chunkIndex < 0)
+        {
+            return -1;
+        }
+
+        const Chunk& chunk = m_chunks[chunkIndex];
+        const int local = index - chunk.begin;
+        if (!ContainsLocal(chunk, local))
+        {
+            return -1;
+        }
+
+        EnsureCountsBefore();
+        int position = m_countsBefore[chunkIndex];
+        if (chunk.IsBitmap())
+        {
+            const int lastWord = local / 64;
+            for (int word = 0; word < lastWord; word++)
+            {
+                position += PopCount(chunk.bits[word]);
+            }
+            position += PopCount(chunk.bits[lastWord] & ((1ull << (local % 64)) - 1));
+        }
+        else
+        {
+            for (const Run& run : chunk.runs)
+            {
+                if (run.end >= local)
+                {
+                    position += local - run.begin;
+                    break;
+                }
+                position += run.end - run.begin + 1;
+            }
+        }
+        return position;
+    }
+
+    // Calls func(begin, end) for each maximal inclusive range of the set, in increasing
+    // order, without expanding the set into individual indices.
+    template <typename TFunc>
+    void ForEachRange(TFunc&& func) const
+    {
+        int pendingBegin = -1;
+        int pendingEnd = -1;
+        const auto visit = [&](int begin, int end)
+        {
+            if (pendingBegin >= 0 && begin == pendingEnd + 1)
+            {
+                pendingEnd = end;
+                return;
+            }
+            if (pendingBegin >= 0)
+            {
+                func(pendingBegin, pendingEnd);
+            }
+            pendingBegin = begin;
+            pendingEnd = end;
+        };
+
+        for (const Chunk& chunk : m_chunks)
+        {
+            ForEachLocalRun(chunk, [&](int begin, int end) { visit(chunk.begin + begin, chunk.begin + end); });
+        }
+
+        if (pendingBegin >= 0)
+        {
+            func(pendingBegin, pendingEnd);
+        }
+    }
+
+private:
+    // Inclusive range of indices relative to the begin of the chunk.
+    struct Run
+    {
+        Run() = default;
+        Run(int begin, int end) : begin(static_cast<uint16_t>(begin)), end(static_cast<uint16_t>(end)) {}
+
+        uint16_t begin{};
+        uint16_t end{};
+    };
+
+    // Covers [begin, begin + span). Exactly one of runs/bits is in use: bits is
+    // empty for run chunks. Chunks in m_chunks are sorted, do not overlap and are
+    // never empty.
+    struct Chunk
+    {
+        bool IsBitmap() const { return !bits.empty(); }
+
+        int begin{};
+        int span{};
+        int count{};
+        std::vector<Run> runs;
+        std::vector<uint64_t> bits;
+    };
+
+    struct Cursor
+    {
+        int chunk{ -1 };
+        int unit{};
+        int countBefore{};
+    };
+
+    static int PopCount(uint64_t bits)
+    {
+        return static_cast<int>(std::bitset<64>(bits).count());
+    }
+
+    // Position of the k-th (0 based) set bit of bits.
+    static int SelectInWord(uint64_t bits, int k)
+    {
+        for (int bit = 0; bit < 64; bit++)
+        {
+            if ((bits & (1ull << bit)) && k-- == 0)
+            {
+                return bit;
+            }
+        }
+        return -1;
+    }
+
+    static uint64_t WordMask(int firstBit, int lastBit)
+    {
+        return (lastBit - firstBit == 63) ? ~0ull : (((1ull << (lastBit - firstBit + 1)) - 1) << firstBit);
+    }
+
+    static int WordCount(int span) { return (span + 63) / 64; }
+
+    // Calls func(word, mask) for each bitmap word touched by the local range [begin, end].
+    template <typename TFunc>
+    static void ForEachWord(int begin, int end, TFunc&& func)
+    {
+        for (int word = begin / 64; word <= end / 64; word++)
+        {
+            const int firstBit = (word == begin / 64) ? begin % 64 : 0;
+            const int lastBit = (word == end / 64) ? end % 64 : 63;
+            func(word, WordMask(firstBit, lastBit));
+        }
+    }
+
+    template <typename TFunc>
+    static void ForEachLocalRun(const Chunk& chunk, TFunc&& func)
+    {
+        if (!chunk.IsBitmap())
+        {
+            for (const Run& run : chunk.runs)
+            {
+                func(run.begin, run.end);
+            }
+            return;
+        }
+
+        int runBegin = -1;
+        for (int word = 0; word < static_cast<int>(chunk.bits.size()); word++)
+        {
+            const uint64_t bits = chunk.bits[word];
+            if ((bits == 0 && runBegin < 0) || (bits == ~0ull && runBegin >= 0))
+            {
+                continue;
+            }
+
+            for (int bit = 0; bit < 64; bit++)
+            {
+                const bool isSet = (bits & (1ull << bit)) != 0;
+                if (isSet && runBegin < 0)
+                {
+                    runBegin = word * 64 + bit;
+                }
+                else if (!isSet && runBegin >= 0)
+                {
+                    func(runBegin, word * 64 + bit - 1);
+                    runBegin = -1;
+                }
+            }
+        }
+
+        if (runBegin >= 0)
+        {
+            func(runBegin, chunk.span - 1);
+        }
+    }
+
+    static bool ContainsLocal(const Chunk& chunk, int local)
+    {
+        if (chunk.IsBitmap())
+        {
+            return (chunk.bits[local / 64] & (1ull << (local % 64))) != 0;
+        }
+
+        const auto it = std::upper_bound(chunk.runs.begin(), chunk.runs.end(), local,
+            [](int value, const Run& run) { return value < run.begin; });
+        return it != chunk.runs.begin() && (it - 1)->end >= local;
+    }
+
+    static int AddLocal(Chunk& chunk, int begin, int end)
+    {
+        int added = 0;
+        if (chunk.IsBitmap())
+        {
+            ForEachWord(begin, end, [&](int word, uint64_t mask)
+            {
+                added += PopCount(mask & ~chunk.bits[word]);
+                chunk.bits[word] |= mask;
+            });
+            chunk.count += added;
+
+            if (chunk.count == chunk.span)
+            {
+                // Everything is selected, which is a single run.
+                chunk.bits.clear();
+                chunk.runs.assign(1, Run(0, chunk.span - 1));
+            }
+            return added;
+        }
+
+        // Merge with every run that overlaps or touches [begin, end].
+        const auto first = std::lower_bound(chunk.runs.begin(), chunk.runs.end(), begin,
+            [](const Run& run, int value) { return run.end + 1 < value; });
+        auto last = first;
+        int covered = 0;
+        int mergedBegin = begin;
+        int mergedEnd = end;
+        for (; last != chunk.runs.end() && last->begin <= end + 1; ++last)
+        {
+            covered += std::max(0, std::min<int>(last->end, end) - std::max<int>(last->begin, begin) + 1);
+            mergedBegin = std::min<int>(mergedBegin, last->begin);
+            mergedEnd = std::max<int>(mergedEnd, last->end);
+        }
+
+        const auto it = chunk.runs.erase(first, last);
+        chunk.runs.insert(it, Run(mergedBegin, mergedEnd));
+        added = (end - begin + 1) - covered;
+        chunk.count += added;
+
+        if (chunk.runs.size() * sizeof(Run) > WordCount(chunk.span) * sizeof(uint64_t))
+        {
+            ToBitmap(chunk);
+        }
+        return added;
+    }
+
+    static int RemoveLocal(Chunk& chunk, int begin, int end)
+    {
+        int removed = 0;
+        if (chunk.IsBitmap())
+        {
+            ForEachWord(begin, end, [&](int word, uint64_t mask)
+            {
+                removed += PopCount(mask & chunk.bits[word]);
+                chunk.bits[word] &= ~mask;
+            });
+            chunk.count -= removed;
+
+            // Few enough indices left that runs are guaranteed to be smaller.
+            if (static_cast<size_t>(chunk.count) * sizeof(Run) * 2 <= WordCount(chunk.span) * sizeof(uint64_t))
+            {
+                ToRuns(chunk);
+            }
+            return removed;
+        }
+
+        const auto first = std::lower_bound(chunk.runs.begin(), chunk.runs.end(), begin,
+            [](const Run& run, int value) { return run.end < value; });
+        auto last = first;
+        Run remaining[2];
+        int remainingCount = 0;
+        for (; last != chunk.runs.end() && last->begin <= end; ++last)
+        {
+            removed += std::min<int>(last->end, end) - std::max<int>(last->begin, begin) + 1;
+            if (last->begin < begin)
+            {
+                remaining[remainingCount++] = Run(last->begin, begin - 1);
+            }
+            if (last->end > end)
+            {
+                remaining[remainingCount++] = Run(end + 1, last->end);
+            }
+        }
+
+        const auto it = chunk.runs.erase(first, last);
+        chunk.runs.insert(it, remaining, remaining + remainingCount);
+        chunk.count -= removed;
+
+        if (chunk.runs.size() * sizeof(Run) > WordCount(chunk.span) * sizeof(uint64_t))
+        {
+            ToBitmap(chunk);
+        }
+        return removed;
+    }
+
+    static void ToBitmap(Chunk& chunk)
+    {
+        chunk.bits.assign(WordCount(chunk.span), 0);
+        for (const Run& run : chunk.runs)
+        {
+            ForEachWord(run.begin, run.end, [&](int word, uint64_t mask) { chunk.bits[word] |= mask; });
+        }
+        chunk.runs.clear();
+        chunk.runs.shrink_to_fit();
+    }
+
+    static void ToRuns(Chunk& chunk)
+    {
+        if (chunk.IsBitmap())
+        {
+            std::vector<Run> runs;
+            ForEachLocalRun(chunk, [&](int begin, int end) { runs.emplace_back(begin, end); });
+            chunk.runs = std::move(runs);
+            chunk.bits.clear();
+            chunk.bits.shrink_to_fit();
+        }
+    }
+
+    // Picks the smaller representation for a chunk in run form and recomputes its count.
+    static void Optimize(Chunk& chunk)
+    {
+        MUX_ASSERT(!chunk.IsBitmap());
+        chunk.count = 0;
+        for (const Run& run : chunk.runs)
+        {
+            chunk.count += run.end - run.begin + 1;
+        }
+
+        if (chunk.runs.size() * sizeof(Run) > WordCount(chunk.span) * sizeof(uint64_t))
+        {
+            ToBitmap(chunk);
+        }
+    }
+
+    // Moves [local, span) of chunk, which must be in run form, into a new chunk.
+    static Chunk SplitChunk(Chunk& chunk, int local)
+    {
+        Chunk after;
+        after.span = chunk.span - local;
+        std::vector<Run> before;
+        for (const Run& run : chunk.runs)
+        {
+            if (run.end < local)
+            {
+                before.push_back(run);
+            }
+            else if (run.begin >= local)
+            {
+                after.runs.emplace_back(run.begin - local, run.end - local);
+            }
+            else
+            {
+                before.emplace_back(run.begin, local - 1);
+                after.runs.emplace_back(0, run.end - local);
+            }
+        }
+        chunk.runs = std::move(before);
+        chunk.span = local;
+        return after;
+    }
+
+    void TryMergeWithNext(size_t chunkIndex)
+    {
+        if (chunkIndex + 1 >= m_chunks.size())
+        {
+            return;
+        }
+
+        Chunk& chunk = m_chunks[chunkIndex];
+        Chunk& next = m_chunks[chunkIndex + 1];
+        if (chunk.begin + chunk.span == next.begin && chunk.span + next.span <= ChunkSpan)
+        {
+            ToRuns(chunk);
+            ToRuns(next);
+            const int offset = chunk.span;
+            chunk.span += next.span;
+            for (const Run& run : next.runs)
+            {
+                if (!chunk.runs.empty() && chunk.runs.back().end + 1 == offset + run.begin)
+                {
+                    chunk.runs.back() = Run(chunk.runs.back().begin, offset + run.end);
+                }
+                else
+                {
+                    chunk.runs.emplace_back(offset + run.begin, offset + run.end);
+                }
+            }
+            Optimize(chunk);
+            m_chunks.erase(m_chunks.begin() + chunkIndex + 1);
+        }
+    }
+
+    // Index of the chunk that covers index, or -1.
+    int FindChunk(int index) const
+    {
+        const auto it = std::upper_bound(m_chunks.begin(), m_chunks.end(), index,
+            [](int value, const Chunk& chunk) { return value < chunk.begin; });
+        if (it == m_chunks.begin() || index >= (it - 1)->begin + (it - 1)->span)
+        {
+            return -1;
+        }
+        return static_cast<int>(it - m_chunks.begin()) - 1;
+    }
+
+    size_t FirstChunkEndingAfter(int index) const
+    {
+        return std::lower_bound(m_chunks.begin(), m_chunks.end(), index,
+            [](const Chunk& chunk, int value) { return chunk.begin + chunk.span <= value; }) - m_chunks.begin();
+    }
+
+    // Creates an empty chunk covering index, aligned on ChunkSpan when its neighbours allow it.
+    int CreateChunk(int index)
+    {
+        const size_t chunkIndex = FirstChunkEndingAfter(index);
+        const long long previousEnd = chunkIndex > 0 ? static_cast<long long>(m_chunks[chunkIndex - 1].begin) + m_chunks[chunkIndex - 1].span : 0;
+        const long long nextBegin = chunkIndex < m_chunks.size() ? m_chunks[chunkIndex].begin : static_cast<long long>(std::numeric_limits<int>::max()) + 1;
+        const long long begin = std::max(previousEnd, static_cast<long long>(index / ChunkSpan) * ChunkSpan);
+        const long long end = std::min(begin + ChunkSpan, nextBegin);
+
+        Chunk chunk;
+        chunk.begin = static_cast<int>(begin);
+        chunk.span = static_cast<int>(end - begin);
+        m_chunks.insert(m_chunks.begin() + chunkIndex, std::move(chunk));
+        return static_cast<int>(chunkIndex);
+    }
+
+    void OnChanged()
+    {
+        m_countsBeforeValid = false;
+        m_cursor = {};
+    }
+
+    void EnsureCountsBefore() const
+    {
+        if (!m_countsBeforeValid)
+        {
+            m_countsBeforeValid = true;
+            m_countsBefore.resize(m_chunks.size());
+            int count = 0;
+            for (size_t chunkIndex = 0; chunkIndex < m_chunks.size(); chunkIndex++)
+            {
+                m_countsBefore[chunkIndex] = count;
+                count += m_chunks[chunkIndex].count;
+            }
+        }
+    }
+
+    std::vector<Chunk> m_chunks{};
+    int m_count{};
+
+    mutable std::vector<int> m_countsBefore{};
+    mutable bool m_countsBeforeValid{};
+    mutable Cursor m_cursor{};
+};
@@ -12,15 +12,21 @@ class SelectedItems:
         typename winrt::IIterable<T>>
 {
 public:
+    // getAtImpl returns the item at the given position within the selected items of a node, and
+    // indexOfImpl returns the position of the given item within the selected items of a node, or -1.
     SelectedItems(const std::vector<SelectedItemInfo>& infos, 
-        std::function<T(const std::vector<SelectedItemInfo>& infos, unsigned int index)> getAtImpl)
+        std::function<T(const SelectedItemInfo& info, unsigned int indexInNode)> getAtImpl,
+        std::function<int(const SelectedItemInfo& info, T const& value)> indexOfImpl)
     {
         m_infos = infos;
         m_getAtImpl = getAtImpl;
+        m_indexOfImpl = indexOfImpl;
+        m_startIndices.reserve(infos.size());
         for (auto& info: infos)
         {
             if (auto node = info.Node.lock())
             {
+                m_startIndices.push_back(m_totalCount);
                 m_totalCount += node->SelectedCount();
             }
             else
@@ -43,17 +49,48 @@ public:
 
     T GetAt(uint32_t index)
     {
-        return m_getAtImpl(m_infos, index);
+        if (index >= m_totalCount)
+        {
+            return nullptr;
+        }
+
+        // Find the last node whose selected items start at or before index.
+        const auto it = std::upper_bound(m_startIndices.begin(), m_startIndices.end(), index) - 1;
+        const auto infoIndex = it - m_startIndices.begin();
+        return m_getAtImpl(m_infos[infoIndex], index - *it);
     }
 
-    bool IndexOf(T const& value, uint32_t &index) noexcept
+    bool IndexOf(T const& value, uint32_t &index)
     {
-        winrt::throw_hresult(E_NOTIMPL);
+        index = 0;
+
+        for (size_t i = 0; i < m_infos.size(); i++)
+        {
+            const int indexInNode = m_indexOfImpl(m_infos[i], value);
+            if (indexInNode >= 0)
+            {
+                index = m_startIndices[i] + static_cast<uint32_t>(indexInNode);
+                return true;
+            }
+        }
+
+        return false;
     }
 
-    uint32_t GetMany(uint32_t startIndex, winrt::array_view<T> const& values) noexcept
+    uint32_t GetMany(uint32_t startIndex, winrt::array_view<T> const& values)
     {
-        winrt::throw_hresult(E_NOTIMPL);
+        if (startIndex >= m_totalCount)
+        {
+            return 0;
+        }
+
+        const uint32_t actual = std::min(m_totalCount - startIndex, values.size());
+        for (uint32_t i = 0; i < actual; i++)
+        {
+            values[i] = GetAt(startIndex + i);
+        }
+
+        return actual;
     }
 
 #pragma endregion
@@ -134,6 +171,9 @@ private:
     };
 
     std::vector<SelectedItemInfo> m_infos;
+    // The position of the first selected item of each node in m_infos, for binary searching in GetAt.
+    std::vector<unsigned int> m_startIndices;
     unsigned int m_totalCount{ 0 };
-    std::function<T(const std::vector<SelectedItemInfo>& infos, int /*index*/)> m_getAtImpl;
+    std::function<T(const SelectedItemInfo& info, unsigned int /*indexInNode*/)> m_getAtImpl;
+    std::function<int(const SelectedItemInfo& info, T const& /*value*/)> m_indexOfImpl;
 };
\ No newline at end of file
@@ -179,31 +179,25 @@ winrt::IVectorView<winrt::IInspectable> SelectionModel::SelectedItems()
         // easier to consume flat vector view of objects.
         auto selectedItems = winrt::make<::SelectedItems<winrt::IInspectable>>(
             selectedInfos,
-            [](const std::vector<SelectedItemInfo>& infos, unsigned int index) // callback for GetAt(index)
+            [](const SelectedItemInfo& info, unsigned int indexInNode) // callback for GetAt(index)
         {
-            unsigned int currentIndex = 0;
-            winrt::IInspectable item{ nullptr };
-            for (const auto& info : infos)
+            if (const auto node = info.Node.lock())
             {
-                if (const auto node = info.Node.lock())
-                {
-                    const unsigned int currentCount = node->SelectedCount();
-                    if (index >= currentIndex && index < currentIndex + currentCount)
-                    {
-                        int targetIndex = node->SelectedIndices().at(index - currentIndex);
-                        item = node->ItemsSourceView().GetAt(targetIndex);
-                        break;
-                    }
+                const int targetIndex = node->SelectedIndexAt(static_cast<int>(indexInNode));
+                return node->ItemsSourceView().GetAt(targetIndex);
+            }
 
-                    currentIndex += currentCount;
-                }
-                else
-                {
-                    throw winrt::hresult_error(E_FAIL, L"selection has changed since SelectedItems property was read.");
-                }
+            throw winrt::hresult_error(E_FAIL, L"selection has changed since SelectedItems property was read.");
+        },
+            [](const SelectedItemInfo& info, const winrt::IInspectable& value) // callback for IndexOf(value)
+        {
+            if (const auto node = info.Node.lock())
+            {
+                const int sourceIndex = node->ItemsSourceView().IndexOf(value);
+                return sourceIndex >= 0 ? node->SelectedPositionOf(sourceIndex) : -1;
             }
 
-            return item;
+            throw winrt::hresult_error(E_FAIL, L"selection has changed since SelectedItems property was read.");
         });
         m_selectedItemsCached = selectedItems;
     }
@@ -234,31 +228,39 @@ winrt::IVectorView<winrt::IndexPath> SelectionModel::SelectedIndices()
         // easier to consume flat vector view of IndexPaths.
         auto indices = winrt::make<::SelectedItems<winrt::IndexPath>>(
             selectedInfos,
-            [](const std::vector<SelectedItemInfo>& infos, unsigned int index) // callback for GetAt(index)
+            [](const SelectedItemInfo& info, unsigned int indexInNode) // callback for GetAt(index)
+        {
+            if (const auto node = info.Node.lock())
+            {
+                const int targetIndex = node->SelectedIndexAt(static_cast<int>(indexInNode));
+                return winrt::get_self<IndexPath>(info.Path)->CloneWithChildIndex(targetIndex);
+            }
+
+            throw winrt::hresult_error(E_FAIL, L"selection has changed since SelectedIndices property was read.");
+        },
+            [](const SelectedItemInfo& info, const winrt::IndexPath& value) // callback for IndexOf(value)
         {
-            unsigned int currentIndex = 0;
-            winrt::IndexPath path{ nullptr };
-            for (const auto info : infos)
+            if (const auto node = info.Node.lock())
             {
-                if (const auto node = info.Node.lock())
+                // The value can only be one of this node's selected indices if it is a direct child of the node's path.
+                const int pathSize = info.Path.GetSize();
+                if (value && value.GetSize() == pathSize + 1)
                 {
-                    const unsigned int currentCount = node->SelectedCount();
-                    if (index >= currentIndex && index < currentIndex + currentCount)
+                    for (int i = 0; i < pathSize; i++)
                     {
-                        int targetIndex = node->SelectedIndices().at(index - currentIndex);
-                        path = winrt::get_self<IndexPath>(info.Path)->CloneWithChildIndex(targetIndex);
-                        break;
+                        if (value.GetAt(i) != info.Path.GetAt(i))
+                        {
+                            return -1;
+                        }
                     }
 
-                    currentIndex += currentCount;
-                }
-                else
-                {
-                    throw winrt::hresult_error(E_FAIL, L"selection has changed since SelectedIndices property was read.");
+                    return node->SelectedPositionOf(value.GetAt(pathSize));
                 }
+
+                return -1;
             }
 
-            return path;
+            throw winrt::hresult_error(E_FAIL, L"selection has changed since SelectedIndices property was read.");
         });
         m_selectedIndicesCached = indices;
     }
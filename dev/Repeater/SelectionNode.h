@@ -3,6 +3,7 @@
 
 #pragma once
 #include "IndexRange.h"
+#include "SelectedIndexSet.h"
 
 class SelectionModel;
 
@@ -40,7 +41,11 @@ public:
     bool IsSelected(int index);
     int SelectedIndex();
     void SelectedIndex(int value);
-    std::vector<int> SelectedIndices();
+    // Rank/select over the sorted selected indices of this node.
+    // SelectedIndexAt(position) returns the position-th selected index, and
+    // SelectedPositionOf(index) returns -1 if the index is not selected.
+    int SelectedIndexAt(int position);
+    int SelectedPositionOf(int index);
     bool Select(int index, bool select);
     bool ToggleSelect(int index);
     void SelectAll();
@@ -54,14 +59,12 @@ private:
     void HookupCollectionChangedHandler();
     void UnhookCollectionChangedHandler();
     bool IsValidIndex(int index);
-    void AddRange(const IndexRange& addRange, bool raiseOnSelectionChanged);
-    void RemoveRange(const IndexRange& removeRange, bool raiseOnSelectionChanged);
+    void AddRange(const IndexRange& addRange);
+    void RemoveRange(const IndexRange& removeRange);
     void ClearSelection();
-    bool Select(int index, bool select, bool raiseOnSelectionChanged);
     void OnSourceListChanged(const winrt::IInspectable& dataSource, const winrt::NotifyCollectionChangedEventArgs& args);
     bool OnItemsAdded(int index, int count);
     bool OnItemsRemoved(int index, int count);
-    void OnSelectionChanged();
 
     SelectionModel* m_manager;
 
@@ -74,15 +77,12 @@ private:
     SelectionNode* m_parent { nullptr };
 
     // For parents of leaf nodes (any node whose children are not data sources)
-    std::vector<IndexRange> m_selected;
+    SelectedIndexSet m_selected;
     
     tracker_ref<winrt::IInspectable> m_source;
     tracker_ref<winrt::ItemsSourceView> m_dataSource;
     winrt::ItemsSourceView::CollectionChanged_revoker m_itemsSourceViewChanged{};
 
-    int m_selectedCount{ 0 };
-    std::vector<int> m_selectedIndicesCached;
-    bool m_selectedIndicesCacheIsValid = false;
     int m_anchorIndex{ -1 };
     int m_realizedChildrenNodeCount{ 0 };
 };
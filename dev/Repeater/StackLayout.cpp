@@ -92,6 +92,7 @@ void StackLayout::OnItemsChangedCore(
     winrt::NotifyCollectionChangedEventArgs const& args)
 {
     GetFlowAlgorithm(context).OnItemsSourceChanged(source, args, context);
+    GetAsStackState(context.LayoutState())->OnItemsSourceChanged(args);
     // Always invalidate layout to keep the view accurate.
     InvalidateLayout();
 }
@@ -116,9 +117,12 @@ winrt::FlowLayoutAnchorInfo StackLayout::GetAnchorForRealizationRect(
         const auto state = GetAsStackState(context.LayoutState());
         const auto lastExtent = state->FlowAlgorithm().LastExtent();
 
-        const double averageElementSize = GetAverageElementSize(availableSize, context, state) + m_itemSpacing;
+        const double averageElementSize = GetAverageElementSize(availableSize, context, state);
+        const auto& itemSizeIndex = state->ItemSizeIndex();
         const double realizationWindowOffsetInExtent = MajorStart(realizationRect) - MajorStart(lastExtent);
-        const double majorSize = MajorSize(lastExtent) == 0 ? std::max(0.0, averageElementSize * itemsCount - m_itemSpacing) : MajorSize(lastExtent);
+        const double majorSize = MajorSize(lastExtent) == 0 ?
+            std::max(0.0, itemSizeIndex.OffsetOf(itemsCount, averageElementSize, m_itemSpacing) - m_itemSpacing) :
+            MajorSize(lastExtent);
         if (itemsCount > 0 &&
             MajorSize(realizationRect) >= 0 &&
             // MajorSize = 0 will account for when a nested repeater is outside the realization rect but still being measured. Also,
@@ -127,9 +131,9 @@ winrt::FlowLayoutAnchorInfo StackLayout::GetAnchorForRealizationRect(
             // in the navigating direction.
             realizationWindowOffsetInExtent + MajorSize(realizationRect) >= 0 && realizationWindowOffsetInExtent <= majorSize)
         {
-            anchorIndex = (int)(realizationWindowOffsetInExtent / averageElementSize);
-            offset = anchorIndex * averageElementSize + MajorStart(lastExtent);
+            anchorIndex = itemSizeIndex.IndexAt(realizationWindowOffsetInExtent, averageElementSize, m_itemSpacing);
             anchorIndex = std::max(0, std::min(itemsCount - 1, anchorIndex));
+            offset = itemSizeIndex.OffsetOf(anchorIndex, averageElementSize, m_itemSpacing) + MajorStart(lastExtent);
         }
     }
 
@@ -153,18 +157,20 @@ winrt::Rect StackLayout::GetExtent(
     // Constants
     const int itemsCount = context.ItemCount();
     const auto stackState = GetAsStackState(context.LayoutState());
-    const double averageElementSize = GetAverageElementSize(availableSize, context, stackState) + m_itemSpacing;
+    const double averageElementSize = GetAverageElementSize(availableSize, context, stackState);
+    const auto& itemSizeIndex = stackState->ItemSizeIndex();
+    const double totalSize = itemSizeIndex.OffsetOf(itemsCount, averageElementSize, m_itemSpacing);
 
     MinorSize(extent) = static_cast<float>(stackState->MaxArrangeBounds());
-    MajorSize(extent) = std::max(0.0f, static_cast<float>(itemsCount * averageElementSize - m_itemSpacing));
+    MajorSize(extent) = std::max(0.0f, static_cast<float>(totalSize - m_itemSpacing));
     if (itemsCount > 0)
     {
         if (firstRealized)
         {
             MUX_ASSERT(lastRealized);
-            MajorStart(extent) = static_cast<float>(MajorStart(firstRealizedLayoutBounds) - firstRealizedItemIndex * averageElementSize);
-            auto remainingItems = itemsCount - lastRealizedItemIndex - 1;
-            MajorSize(extent) = MajorEnd(lastRealizedLayoutBounds) - MajorStart(extent) + static_cast<float>(remainingItems* averageElementSize);
+            MajorStart(extent) = static_cast<float>(MajorStart(firstRealizedLayoutBounds) - itemSizeIndex.OffsetOf(firstRealizedItemIndex, averageElementSize, m_itemSpacing));
+            const double remainingSize = totalSize - itemSizeIndex.OffsetOf(lastRealizedItemIndex + 1, averageElementSize, m_itemSpacing);
+            MajorSize(extent) = MajorEnd(lastRealizedLayoutBounds) - MajorStart(extent) + static_cast<float>(remainingSize);
         }
         else
         {
@@ -251,8 +257,8 @@ winrt::FlowLayoutAnchorInfo StackLayout::Algorithm_GetAnchorForTargetElement(
     {
         index = targetIndex;
         const auto state = GetAsStackState(context.LayoutState());
-        const double averageElementSize = GetAverageElementSize(availableSize, context, state) + m_itemSpacing;
-        offset = index * averageElementSize + MajorStart(state->FlowAlgorithm().LastExtent());
+        const double averageElementSize = GetAverageElementSize(availableSize, context, state);
+        offset = state->ItemSizeIndex().OffsetOf(index, averageElementSize, m_itemSpacing) + MajorStart(state->FlowAlgorithm().LastExtent());
     }
 
     return winrt::FlowLayoutAnchorInfo{ index, offset };
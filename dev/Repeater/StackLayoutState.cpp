@@ -14,11 +14,6 @@ void StackLayoutState::InitializeForContext(
     IFlowLayoutAlgorithmDelegates* callbacks)
 {
     m_flowAlgorithm.InitializeForContext(context, callbacks);
-    if (m_estimationBuffer.size() == 0)
-    {
-        m_estimationBuffer.resize(BufferSize, 0.0f);
-    }
-
     context.LayoutStateCore(*this);
 }
 
@@ -29,17 +24,7 @@ void StackLayoutState::UninitializeForContext(const winrt::VirtualizingLayoutCon
 
 void StackLayoutState::OnElementMeasured(int elementIndex, double majorSize, double minorSize)
 {
-    const int estimationBufferIndex = elementIndex % m_estimationBuffer.size();
-    const bool alreadyMeasured = m_estimationBuffer[estimationBufferIndex] != 0;
-    if (!alreadyMeasured)
-    {
-        m_totalElementsMeasured++;
-    }
-
-    m_totalElementSize -= m_estimationBuffer[estimationBufferIndex];
-    m_totalElementSize += majorSize;
-    m_estimationBuffer[estimationBufferIndex] = majorSize;
-
+    m_itemSizeIndex.SetSize(elementIndex, majorSize);
     m_maxArrangeBounds = std::max(m_maxArrangeBounds, minorSize);
 }
 
@@ -47,3 +32,39 @@ void StackLayoutState::OnMeasureStart()
 {
     m_maxArrangeBounds = 0.0;
 }
+
+void StackLayoutState::OnItemsSourceChanged(const winrt::NotifyCollectionChangedEventArgs& args)
+{
+    // Shift the measured sizes along with the items so that the sizes we already
+    // know about are still valid after the collection change.
+    switch (args.Action())
+    {
+    case winrt::NotifyCollectionChangedAction::Add:
+        m_itemSizeIndex.Insert(args.NewStartingIndex(), args.NewItems().Size());
+        break;
+
+    case winrt::NotifyCollectionChangedAction::Remove:
+        m_itemSizeIndex.Remove(args.OldStartingIndex(), args.OldItems().Size());
+        break;
+
+    case winrt::NotifyCollectionChangedAction::Replace:
+    {
+        // Replaced items will need to be measured again.
+        m_itemSizeIndex.Remove(args.OldStartingIndex(), args.OldItems().Size());
+        m_itemSizeIndex.Insert(args.NewStartingIndex(), args.NewItems().Size());
+    }
+    break;
+
+    case winrt::NotifyCollectionChangedAction::Move:
+    {
+        const int size = args.OldItems() ? args.OldItems().Size() : 1;
+        m_itemSizeIndex.Remove(args.OldStartingIndex(), size);
+        m_itemSizeIndex.Insert(args.NewStartingIndex(), size);
+    }
+    break;
+
+    case winrt::NotifyCollectionChangedAction::Reset:
+        m_itemSizeIndex.Clear();
+        break;
+    }
+}
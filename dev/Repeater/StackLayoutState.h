@@ -5,6 +5,7 @@
 
 #include "StackLayoutState.g.h"
 #include "FlowLayoutAlgorithm.h"
+#include "ItemSizeIndex.h"
 
 class StackLayoutState :
     public ReferenceTracker<StackLayoutState, winrt::implementation::StackLayoutStateT, winrt::composing>
@@ -16,20 +17,21 @@ public:
     void UninitializeForContext(const winrt::VirtualizingLayoutContext& context);
     void OnElementMeasured(int elementIndex, double majorSize, double minorSize);
     void OnMeasureStart();
+    void OnItemsSourceChanged(const winrt::NotifyCollectionChangedEventArgs& args);
 
     ::FlowLayoutAlgorithm& FlowAlgorithm() { return m_flowAlgorithm; }
-    double TotalElementSize() const { return m_totalElementSize; }
+    const ::ItemSizeIndex& ItemSizeIndex() const { return m_itemSizeIndex; }
+    double TotalElementSize() const { return m_itemSizeIndex.MeasuredTotal(); }
     double MaxArrangeBounds() const { return m_maxArrangeBounds; }
-    int TotalElementsMeasured() const { return m_totalElementsMeasured; }
+    int TotalElementsMeasured() const { return m_itemSizeIndex.MeasuredCount(); }
 
 private:
     ::FlowLayoutAlgorithm m_flowAlgorithm{ this };
-    std::vector<double> m_estimationBuffer{};
-    double m_totalElementSize{};
+    // Measured major size of every item we have seen so far, keyed by data index.
+    // Items that were never measured are estimated using the average size.
+    ::ItemSizeIndex m_itemSizeIndex{};
     // During the measure pass, as we measure the elements, we will keep track
     // of the largest arrange bounds in the non-virtualizing direction. This value
     // is going to be used in the calculation of the extent.
     double m_maxArrangeBounds{};
-    int m_totalElementsMeasured{};
-    static const int BufferSize = 100;
 };
@@ -125,6 +125,18 @@ bool UniformGridLayout::Algorithm_ShouldBreakLine(int /*index*/, double remainin
     return remainingSpace < 0;
 }
 
+int UniformGridLayout::Algorithm_GetKnownItemSizes(
+    int /*startIndex*/,
+    const winrt::Size& /*availableSize*/,
+    const winrt::VirtualizingLayoutContext& context,
+    winrt::array_view<winrt::Size> sizes)
+{
+    // Every item is measured and arranged at the effective item size.
+    const auto gridState = GetAsGridState(context.LayoutState());
+    std::fill(sizes.begin(), sizes.end(), winrt::Size{ static_cast<float>(gridState->EffectiveItemWidth()), static_cast<float>(gridState->EffectiveItemHeight()) });
+    return static_cast<int>(sizes.size());
+}
+
 winrt::FlowLayoutAnchorInfo UniformGridLayout::Algorithm_GetAnchorForRealizationRect(
     const winrt::Size & availableSize,
     const winrt::VirtualizingLayoutContext & context)
@@ -39,6 +39,12 @@ public:
     winrt::Size Algorithm_GetMeasureSize(int index, const winrt::Size& availableSize, const winrt::VirtualizingLayoutContext& context) override;
     winrt::Size Algorithm_GetProvisionalArrangeSize(int index, const winrt::Size& measureSize, winrt::Size const& desiredSize, const winrt::VirtualizingLayoutContext& context) override;
     bool Algorithm_ShouldBreakLine(int index, double remainingSpace) override;
+    int Algorithm_GetKnownItemSizes(
+        int startIndex,
+        const winrt::Size& availableSize,
+        const winrt::VirtualizingLayoutContext& context,
+        winrt::array_view<winrt::Size> sizes) override;
+    bool Algorithm_IsItemPlacementUniform() override { return true; }
     winrt::FlowLayoutAnchorInfo Algorithm_GetAnchorForRealizationRect(
         const winrt::Size& availableSize,
         const winrt::VirtualizingLayoutContext& context) override;
@@ -18,15 +18,13 @@ void UniqueIdElementPool::Add(const winrt::UIElement& element)
     MUX_ASSERT(m_owner->ItemsSourceView().HasKeyIndexMapping());
 
     auto virtInfo = ItemsRepeater::GetVirtualizationInfo(element);
-    auto key = std::wstring(virtInfo->UniqueId().data());
+    const auto& key = virtInfo->UniqueId();
 
-    if (m_elementMap.find(key) != m_elementMap.end())
+    if (!m_elementMap.emplace(key, tracker_ref<winrt::UIElement>(m_owner, element)).second)
     {
-        std::wstring message = L"The unique id provided (" + std::wstring(virtInfo->UniqueId().data()) + L") is not unique.";
+        std::wstring message = L"The unique id provided (" + std::wstring(key.data()) + L") is not unique.";
         throw winrt::hresult_error(E_FAIL, message.c_str());
     }
-
-    m_elementMap.insert(std::make_pair(std::move(key), tracker_ref<winrt::UIElement>(m_owner, element)));
 }
 
 winrt::UIElement UniqueIdElementPool::Remove(int index)
@@ -35,8 +33,7 @@ winrt::UIElement UniqueIdElementPool::Remove(int index)
 
     // Check if there is already a element in the mapping and if so, use it.
     winrt::UIElement element = nullptr;
-    std::wstring key = std::wstring(m_owner->ItemsSourceView().KeyFromIndex(index));
-    const auto it = m_elementMap.find(key);
+    const auto it = m_elementMap.find(m_owner->ItemsSourceView().KeyFromIndex(index));
     if (it != m_elementMap.end())
     {
         element = it->second.get();
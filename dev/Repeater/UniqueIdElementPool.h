@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 class ItemsRepeater;
 
 class UniqueIdElementPool final
@@ -23,5 +25,6 @@ public:
 
 private:
     ItemsRepeater* m_owner{ nullptr };
-    std::map<std::wstring, tracker_ref<winrt::UIElement>> m_elementMap;
+    // Keyed by the hstring the data source gave us, so lookups neither copy nor allocate the key.
+    std::unordered_map<winrt::hstring, tracker_ref<winrt::UIElement>> m_elementMap;
 };
@@ -281,22 +281,30 @@ void ViewManager::PrunePinnedElements()
 
     // Go through pinned elements and make sure they still have
     // a reason to be pinned.
-    for (size_t i = 0; i < m_pinnedPool.size(); ++i)
+    std::vector<winrt::UIElement> unpinnedElements;
+    for (size_t i = 0; i < m_pinnedPool.size();)
     {
-        auto elementInfo = m_pinnedPool[i];
+        const auto& elementInfo = m_pinnedPool[i];
         auto virtInfo = elementInfo.VirtualizationInfo();
 
         MUX_ASSERT(virtInfo->Owner() == ElementOwner::PinnedPool);
 
         if (!virtInfo->IsPinned())
         {
-            m_pinnedPool.erase(m_pinnedPool.begin() + i);
-            --i;
-
-            // Pinning was the only thing keeping this element alive.
-            ClearElementToElementFactory(elementInfo.PinnedElement());
+            unpinnedElements.push_back(elementInfo.PinnedElement());
+            RemoveFromPinnedPool(i);
+        }
+        else
+        {
+            ++i;
         }
     }
+
+    for (const auto& element : unpinnedElements)
+    {
+        // Pinning was the only thing keeping this element alive.
+        ClearElementToElementFactory(element);
+    }
 }
 
 void ViewManager::UpdatePin(const winrt::UIElement& element, bool addPin)
@@ -336,29 +344,16 @@ void ViewManager::OnItemsSourceChanged(const winrt::IInspectable&, const winrt::
 {
     // Note: For items that have been removed, the index will not be touched. It will hold
     // the old index before it was removed. It is not valid anymore.
-    switch (args.Action())
+    const auto diff = CollectionChangeDiff::FromArgs(args);
+    switch (diff.Action)
     {
     case winrt::NotifyCollectionChangedAction::Add:
     {
-        const auto newIndex = args.NewStartingIndex();
-        const auto newCount = args.NewItems().Size();
         EnsureFirstLastRealizedIndices();
-        if (newIndex <= m_lastRealizedElementIndexHeldByLayout)
+        if (diff.NewIndex <= m_lastRealizedElementIndexHeldByLayout)
         {
-            m_lastRealizedElementIndexHeldByLayout += newCount;
-            auto children = m_owner->Children();
-            const auto childCount = children.Size();
-            for (unsigned i = 0u; i < childCount; ++i)
-            {
-                const auto element = children.GetAt(i);
-                const auto virtInfo = ItemsRepeater::GetVirtualizationInfo(element);
-                const auto dataIndex = virtInfo->Index();
-
-                if (virtInfo->IsRealized() && dataIndex >= newIndex)
-                {
-                    UpdateElementIndex(element, virtInfo, dataIndex + newCount);
-                }
-            }
+            m_lastRealizedElementIndexHeldByLayout += diff.NewCount;
+            ApplyIndexChanges(diff);
         }
         else
         {
@@ -370,10 +365,10 @@ void ViewManager::OnItemsSourceChanged(const winrt::IInspectable&, const winrt::
                 const auto virtInfo = elementInfo.VirtualizationInfo();
                 const auto dataIndex = virtInfo->Index();
 
-                if (virtInfo->IsRealized() && dataIndex >= newIndex)
+                if (virtInfo->IsRealized() && dataIndex >= diff.NewIndex)
                 {
                     auto element = elementInfo.PinnedElement();
-                    UpdateElementIndex(element, virtInfo, dataIndex + newCount);
+                    UpdateElementIndex(element, virtInfo, diff.MapIndex(dataIndex));
                 }
             }
         }
@@ -389,45 +384,27 @@ void ViewManager::OnItemsSourceChanged(const winrt::IInspectable&, const winrt::
         // case 2: oldCount != newCount
         //         Replaced with less or more items. This is like an insert or remove
         //         depending on the counts.
-        const auto oldStartIndex = args.OldStartingIndex();
-        const auto newStartingIndex = args.NewStartingIndex();
-        const auto oldCount = static_cast<int>(args.OldItems().Size());
-        const auto newCount = static_cast<int>(args.NewItems().Size());
-        if (oldStartIndex != newStartingIndex)
+        if (diff.OldIndex != diff.NewIndex)
         {
             throw winrt::hresult_error(E_FAIL, L"Replace is only allowed with OldStartingIndex equals to NewStartingIndex.");
         }
 
-        if (oldCount == 0)
+        if (diff.OldCount == 0)
         {
             throw winrt::hresult_error(E_FAIL, L"Replace notification with args.OldItemsCount value of 0 is not allowed. Use Insert action instead.");
         }
 
-        if (newCount == 0)
+        if (diff.NewCount == 0)
         {
             throw winrt::hresult_error(E_FAIL, L"Replace notification with args.NewItemCount value of 0 is not allowed. Use Remove action instead.");
         }
 
-        const int countChange = newCount - oldCount;
+        const int countChange = diff.NewCount - diff.OldCount;
         if (countChange != 0)
         {
             // countChange > 0 : countChange items were added
             // countChange < 0 : -countChange  items were removed
-            const auto children = m_owner->Children();
-            for (unsigned i = 0u; i < children.Size(); ++i)
-            {
-                const auto element = children.GetAt(i);
-                const auto virtInfo = ItemsRepeater::GetVirtualizationInfo(element);
-                const auto dataIndex = virtInfo->Index();
-
-                if (virtInfo->IsRealized())
-                {
-                    if (dataIndex >= oldStartIndex + oldCount)
-                    {
-                        UpdateElementIndex(element, virtInfo, dataIndex + countChange);
-                    }
-                }
-            }
+            ApplyIndexChanges(diff);
 
             EnsureFirstLastRealizedIndices();
             m_lastRealizedElementIndexHeldByLayout += countChange;
@@ -437,30 +414,20 @@ void ViewManager::OnItemsSourceChanged(const winrt::IInspectable&, const winrt::
 
     case winrt::NotifyCollectionChangedAction::Remove:
     {
-        const auto oldStartIndex = args.OldStartingIndex();
-        const auto oldCount = static_cast<int>(args.OldItems().Size());
-        const auto children = m_owner->Children();
-        for (unsigned i = 0u; i < children.Size(); ++i)
-        {
-            const auto element = children.GetAt(i);
-            const auto virtInfo = ItemsRepeater::GetVirtualizationInfo(element);
-            const auto dataIndex = virtInfo->Index();
+        ApplyIndexChanges(diff);
+        InvalidateRealizedIndicesHeldByLayout();
+        break;
+    }
 
-            if (virtInfo->IsRealized())
-            {
-                if (virtInfo->AutoRecycleCandidate() && oldStartIndex <= dataIndex && dataIndex < oldStartIndex + oldCount)
-                {
-                    // If we are doing the mapping, remove the element who's data was removed.
-                    m_owner->ClearElementImpl(element);
-                }
-                else if (dataIndex >= (oldStartIndex + oldCount))
-                {
-                    UpdateElementIndex(element, virtInfo, dataIndex - oldCount);
-                }
-            }
+    case winrt::NotifyCollectionChangedAction::Move:
+    {
+        // The moved elements keep their containers, only the indices between the
+        // old and the new position of the block change.
+        if (diff.OldIndex != diff.NewIndex)
+        {
+            ApplyIndexChanges(diff);
+            InvalidateRealizedIndicesHeldByLayout();
         }
-
-        InvalidateRealizedIndicesHeldByLayout();
         break;
     }
 
@@ -615,21 +582,21 @@ winrt::UIElement ViewManager::GetElementFromPinnedElements(int index)
     winrt::UIElement element = nullptr;
 
     // See if you can find something among the pinned elements.
-    for (size_t i = 0; i < m_pinnedPool.size(); ++i)
+    if (!m_pinnedPool.empty())
     {
-        auto elementInfo = m_pinnedPool[i];
-        auto virtInfo = elementInfo.VirtualizationInfo();
-
-        if (virtInfo->Index() == index)
+        EnsurePinnedPoolIndex();
+        const auto iterator = m_pinnedPoolIndex.find(index);
+        if (iterator != m_pinnedPoolIndex.end())
         {
-            m_pinnedPool.erase(m_pinnedPool.begin() + i);
+            const auto elementInfo = m_pinnedPool[iterator->second];
+            MUX_ASSERT(elementInfo.VirtualizationInfo()->Index() == index);
+            RemoveFromPinnedPool(iterator->second);
             element = elementInfo.PinnedElement();
             elementInfo.VirtualizationInfo()->MoveOwnershipToLayoutFromPinnedPool();
 
             // Update realized indices
             m_firstRealizedElementIndexHeldByLayout = std::min(m_firstRealizedElementIndexHeldByLayout, index);
             m_lastRealizedElementIndexHeldByLayout = std::max(m_lastRealizedElementIndexHeldByLayout, index);
-            break;
         }
     }
 
@@ -842,7 +809,7 @@ bool ViewManager::ClearElementToPinnedPool(const winrt::UIElement& element, cons
             MUX_ASSERT(m_pinnedPool[i].PinnedElement() != element);
         }
 #endif
-        m_pinnedPool.push_back(PinnedElementInfo(m_owner, element));
+        AddToPinnedPool(element);
         virtInfo->MoveOwnershipToPinnedPool();
     }
 
@@ -916,6 +883,35 @@ void ViewManager::EnsureEventSubscriptions()
     }
 }
 
+// Walks the children once and moves the index of every realized element to its index
+// after the change. Elements whose data was removed are cleared if we own the mapping.
+void ViewManager::ApplyIndexChanges(const CollectionChangeDiff& diff)
+{
+    const bool isRemove = diff.Action == winrt::NotifyCollectionChangedAction::Remove;
+    const int firstAffectedIndex = diff.FirstAffectedIndex();
+    const auto children = m_owner->Children();
+    for (unsigned i = 0u; i < children.Size(); ++i)
+    {
+        const auto element = children.GetAt(i);
+        const auto virtInfo = ItemsRepeater::GetVirtualizationInfo(element);
+        const auto dataIndex = virtInfo->Index();
+
+        if (virtInfo->IsRealized() && dataIndex >= firstAffectedIndex)
+        {
+            const int newIndex = diff.MapIndex(dataIndex);
+            if (newIndex >= 0)
+            {
+                UpdateElementIndex(element, virtInfo, newIndex);
+            }
+            else if (isRemove && virtInfo->AutoRecycleCandidate())
+            {
+                // If we are doing the mapping, remove the element who's data was removed.
+                m_owner->ClearElementImpl(element);
+            }
+        }
+    }
+}
+
 void ViewManager::UpdateElementIndex(const winrt::UIElement& element, const winrt::com_ptr<VirtualizationInfo>& virtInfo, int index)
 {
     const auto oldIndex = virtInfo->Index();
@@ -923,6 +919,71 @@ void ViewManager::UpdateElementIndex(const winrt::UIElement& element, const winr
     {
         virtInfo->UpdateIndex(index);
         m_owner->OnElementIndexChanged(element, oldIndex, index);
+
+        if (virtInfo->Owner() == ElementOwner::PinnedPool)
+        {
+            m_isPinnedPoolIndexValid = false;
+        }
+    }
+}
+
+void ViewManager::AddToPinnedPool(const winrt::UIElement& element)
+{
+    m_pinnedPool.push_back(PinnedElementInfo(m_owner, element));
+    if (m_isPinnedPoolIndexValid)
+    {
+        const auto index = m_pinnedPool.back().VirtualizationInfo()->Index();
+        if (!m_pinnedPoolIndex.emplace(index, m_pinnedPool.size() - 1).second)
+        {
+            m_pinnedPoolIndexHasCollisions = true;
+        }
+    }
+}
+
+// Removes the element at position by moving the last element into its place.
+void ViewManager::RemoveFromPinnedPool(size_t position)
+{
+    MUX_ASSERT(position < m_pinnedPool.size());
+    const size_t lastPosition = m_pinnedPool.size() - 1;
+
+    if (m_isPinnedPoolIndexValid)
+    {
+        if (m_pinnedPoolIndexHasCollisions)
+        {
+            // The element sharing the data index is not in the map, let the next lookup find it.
+            m_isPinnedPoolIndexValid = false;
+        }
+        else
+        {
+            m_pinnedPoolIndex.erase(m_pinnedPool[position].VirtualizationInfo()->Index());
+            if (position != lastPosition)
+            {
+                m_pinnedPoolIndex[m_pinnedPool[lastPosition].VirtualizationInfo()->Index()] = position;
+            }
+        }
+    }
+
+    if (position != lastPosition)
+    {
+        m_pinnedPool[position] = std::move(m_pinnedPool[lastPosition]);
+    }
+    m_pinnedPool.pop_back();
+}
+
+void ViewManager::EnsurePinnedPoolIndex()
+{
+    if (!m_isPinnedPoolIndexValid)
+    {
+        m_pinnedPoolIndex.clear();
+        m_pinnedPoolIndexHasCollisions = false;
+        for (size_t i = 0; i < m_pinnedPool.size(); ++i)
+        {
+            if (!m_pinnedPoolIndex.emplace(m_pinnedPool[i].VirtualizationInfo()->Index(), i).second)
+            {
+                m_pinnedPoolIndexHasCollisions = true;
+            }
+        }
+        m_isPinnedPoolIndexValid = true;
     }
 }
 
@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "UniqueIdElementPool.h"
 #include "VirtualizationInfo.h"
 #include "Phaser.h"
+#include "CollectionChangeDiff.h"
 
 class ItemsRepeater;
 
@@ -28,6 +31,8 @@ public:
     void OnLayoutChanging();
     void OnOwnerArranged();
 
+    ::Phaser& Phaser() { return m_phaser; }
+
 private:
 #pragma region GetElement providers
 
@@ -53,11 +58,16 @@ private:
 
     void EnsureEventSubscriptions();
 
+    void ApplyIndexChanges(const CollectionChangeDiff& diff);
     void UpdateElementIndex(const winrt::UIElement& element, const winrt::com_ptr<VirtualizationInfo>& virtInfo, int index);
 
     void InvalidateRealizedIndicesHeldByLayout();
     void EnsureFirstLastRealizedIndices();
 
+    void AddToPinnedPool(const winrt::UIElement& element);
+    void RemoveFromPinnedPool(size_t position);
+    void EnsurePinnedPoolIndex();
+
     struct PinnedElementInfo
     {
         PinnedElementInfo(const ITrackerHandleManager* owner, const winrt::UIElement& element);
@@ -79,7 +89,14 @@ private:
     ItemsRepeater* m_owner{ nullptr };
 
     // Pinned elements that are currently owned by layout are *NOT* in this pool.
+    // Unordered, elements are swap-removed.
     std::vector<PinnedElementInfo> m_pinnedPool;
+    // Data index of each pinned element to its position in m_pinnedPool. Rebuilt when
+    // the index of a pinned element changes. When elements share a data index (the
+    // item of one of them was removed), only one of them is in the map.
+    std::unordered_map<int /* data index */, size_t /* position */> m_pinnedPoolIndex;
+    bool m_isPinnedPoolIndexValid{ true };
+    bool m_pinnedPoolIndexHasCollisions{ false };
     UniqueIdElementPool m_resetPool;
 
     // _lastFocusedElement is listed in _pinnedPool.
@@ -28,4 +28,7 @@ public:
     virtual void ResetScrollers() = 0;
 
     virtual winrt::UIElement MadeAnchor() const = 0;
+
+    // Smoothed rate at which the visible window moves, in pixels per second. Zero when not scrolling.
+    virtual winrt::Point ScrollVelocity() const = 0;
 };
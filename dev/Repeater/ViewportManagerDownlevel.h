@@ -42,6 +42,9 @@ public:
 
     winrt::UIElement MadeAnchor() const override { return m_makeAnchorElement.get(); }
 
+    // Not tracked down-level.
+    winrt::Point ScrollVelocity() const override { return {}; }
+
 private:
     struct ScrollerInfo;
 
@@ -453,12 +453,44 @@ void ViewportManagerWithPlatformFeatures::UpdateViewport(winrt::Rect const& view
             GetLayoutId().data(),
             previousVisibleWindow.X, previousVisibleWindow.Y, previousVisibleWindow.Width, previousVisibleWindow.Height,
             currentVisibleWindow.X, currentVisibleWindow.Y, currentVisibleWindow.Width, currentVisibleWindow.Height);
+        UpdateScrollVelocity(previousVisibleWindow, currentVisibleWindow);
         m_visibleWindow = currentVisibleWindow;
     }
 
     TryInvalidateMeasure();
 }
 
+winrt::Point ViewportManagerWithPlatformFeatures::ScrollVelocity() const
+{
+    return m_viewportChangeTimer.DurationInMilliSeconds() > c_maxScrollSampleIntervalInMs ?
+        winrt::Point{} :
+        m_scrollVelocity;
+}
+
+void ViewportManagerWithPlatformFeatures::UpdateScrollVelocity(winrt::Rect const& previousVisibleWindow, winrt::Rect const& currentVisibleWindow)
+{
+    const double intervalInMs = m_viewportChangeTimer.DurationInMilliSeconds();
+    m_viewportChangeTimer.Reset();
+
+    // A resize or the first viewport after a pause is not a scroll sample.
+    if (intervalInMs <= 0.0 ||
+        intervalInMs > c_maxScrollSampleIntervalInMs ||
+        previousVisibleWindow == winrt::Rect{} ||
+        previousVisibleWindow.Width != currentVisibleWindow.Width ||
+        previousVisibleWindow.Height != currentVisibleWindow.Height)
+    {
+        m_scrollVelocity = {};
+        return;
+    }
+
+    const float intervalInSeconds = static_cast<float>(intervalInMs / 1000.0);
+    const winrt::Point sample{
+        (currentVisibleWindow.X - previousVisibleWindow.X) / intervalInSeconds,
+        (currentVisibleWindow.Y - previousVisibleWindow.Y) / intervalInSeconds };
+    m_scrollVelocity.X += (sample.X - m_scrollVelocity.X) * c_scrollVelocitySmoothing;
+    m_scrollVelocity.Y += (sample.Y - m_scrollVelocity.Y) * c_scrollVelocitySmoothing;
+}
+
 void ViewportManagerWithPlatformFeatures::ResetCacheBuffer()
 {
     m_horizontalCacheBufferPerSide = 0.0;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "ViewportManager.h"
+#include "QPCTimer.h"
 
 class ItemsRepeater;
 
@@ -44,6 +45,8 @@ public:
 
     winrt::UIElement MadeAnchor() const override { return m_makeAnchorElement.get(); }
 
+    winrt::Point ScrollVelocity() const override;
+
 private:
     struct ScrollerInfo;
 
@@ -54,6 +57,7 @@ private:
     void EnsureScroller();
     bool HasScroller() const { return m_scroller != nullptr; }
     void UpdateViewport(winrt::Rect const& args);
+    void UpdateScrollVelocity(winrt::Rect const& previousVisibleWindow, winrt::Rect const& currentVisibleWindow);
     void ResetCacheBuffer();
     void ValidateCacheLength(double cacheLength);
     void RegisterCacheBuildWork();
@@ -88,6 +92,13 @@ private:
     // in the parent chain can scroll in the shift direction.
     winrt::Point m_unshiftableShift{};
 
+    // Scroll velocity fields. The timer measures the time since the last viewport change.
+    QPCTimer m_viewportChangeTimer{};
+    winrt::Point m_scrollVelocity{};
+    // Viewport changes further apart than this are not part of the same scroll.
+    static constexpr double c_maxScrollSampleIntervalInMs = 200.0;
+    // Weight of the latest sample in the smoothed velocity.
+    static constexpr float c_scrollVelocitySmoothing = 0.5f;
 
     // Realization window cache fields
     double m_maximumHorizontalCacheLength{ 2.0 };
@@ -74,7 +74,7 @@ public:
     winrt::Rect ArrangeBounds() const { return m_arrangeBounds; }
     void ArrangeBounds(winrt::Rect value) { m_arrangeBounds = value; }
 
-    wstring_view UniqueId() const { return m_uniqueId; }
+    const winrt::hstring& UniqueId() const { return m_uniqueId; }
 
 #pragma region Keep element from being recycled
     bool KeepAlive() { return m_keepAlive; }
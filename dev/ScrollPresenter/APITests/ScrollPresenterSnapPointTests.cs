@@ -388,5 +388,81 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
                 Verify.AreEqual(5.0f, scrollPresenter.ZoomFactor);
             });
         }
+
+        [TestMethod]
+        [TestProperty("Description", "Snap to the snap point whose applicable zone includes the target offset, at zone boundaries and after the snap points change.")]
+        public void SnapToScrollSnapPointAtZoneBoundaries()
+        {
+            ScrollPresenter scrollPresenter = null;
+            Rectangle rectangleScrollPresenterContent = null;
+            AutoResetEvent scrollPresenterLoadedEvent = new AutoResetEvent(false);
+            ScrollSnapPoint snapPoint100 = null;
+            ScrollSnapPoint snapPoint300 = null;
+            ScrollSnapPoint snapPoint600 = null;
+
+            RunOnUIThread.Execute(() =>
+            {
+                rectangleScrollPresenterContent = new Rectangle();
+                scrollPresenter = new ScrollPresenter();
+
+                SetupDefaultUI(scrollPresenter, rectangleScrollPresenterContent, scrollPresenterLoadedEvent);
+            });
+
+            WaitForEvent("Waiting for Loaded event", scrollPresenterLoadedEvent);
+
+            RunOnUIThread.Execute(() =>
+            {
+                snapPoint100 = new ScrollSnapPoint(snapPointValue: 100, alignment: ScrollSnapPointsAlignment.Near);
+                snapPoint300 = new ScrollSnapPoint(snapPointValue: 300, alignment: ScrollSnapPointsAlignment.Near);
+                snapPoint600 = new ScrollSnapPoint(snapPointValue: 600, alignment: ScrollSnapPointsAlignment.Near);
+
+                scrollPresenter.HorizontalSnapPoints.Add(snapPoint600);
+                scrollPresenter.HorizontalSnapPoints.Add(snapPoint100);
+                scrollPresenter.HorizontalSnapPoints.Add(snapPoint300);
+            });
+
+            IdleSynchronizer.Wait();
+
+            RunOnUIThread.Execute(() =>
+            {
+                // Zones end halfway between neighboring snap points and the outer ones are unbounded.
+                Verify.AreEqual(new Vector2(float.NegativeInfinity, 200.0f), ScrollPresenterTestHooks.GetHorizontalSnapPointActualApplicableZone(scrollPresenter, snapPoint100));
+                Verify.AreEqual(new Vector2(200.0f, 450.0f), ScrollPresenterTestHooks.GetHorizontalSnapPointActualApplicableZone(scrollPresenter, snapPoint300));
+                Verify.AreEqual(new Vector2(450.0f, float.PositiveInfinity), ScrollPresenterTestHooks.GetHorizontalSnapPointActualApplicableZone(scrollPresenter, snapPoint600));
+            });
+
+            // A boundary shared by two zones belongs to the first snap point.
+            ScrollTo(scrollPresenter, 0.0, 0.0, AnimationMode.Disabled, SnapPointsMode.Default, expectedFinalHorizontalOffset: 100.0);
+            ScrollTo(scrollPresenter, 199.0, 0.0, AnimationMode.Disabled, SnapPointsMode.Default, expectedFinalHorizontalOffset: 100.0);
+            ScrollTo(scrollPresenter, 200.0, 0.0, AnimationMode.Disabled, SnapPointsMode.Default, expectedFinalHorizontalOffset: 100.0);
+            ScrollTo(scrollPresenter, 201.0, 0.0, AnimationMode.Disabled, SnapPointsMode.Default, expectedFinalHorizontalOffset: 300.0);
+            ScrollTo(scrollPresenter, 450.0, 0.0, AnimationMode.Disabled, SnapPointsMode.Default, expectedFinalHorizontalOffset: 300.0);
+            ScrollTo(scrollPresenter, 451.0, 0.0, AnimationMode.Disabled, SnapPointsMode.Default, expectedFinalHorizontalOffset: 600.0);
+            ScrollTo(scrollPresenter, 900.0, 0.0, AnimationMode.Disabled, SnapPointsMode.Default, expectedFinalHorizontalOffset: 600.0);
+
+            RunOnUIThread.Execute(() =>
+            {
+                Log.Comment("Replacing snap point 300 with snap point 500.");
+                scrollPresenter.HorizontalSnapPoints.Remove(snapPoint300);
+                scrollPresenter.HorizontalSnapPoints.Add(new ScrollSnapPoint(snapPointValue: 500, alignment: ScrollSnapPointsAlignment.Near));
+            });
+
+            IdleSynchronizer.Wait();
+
+            ScrollTo(scrollPresenter, 250.0, 0.0, AnimationMode.Disabled, SnapPointsMode.Default, expectedFinalHorizontalOffset: 100.0);
+            ScrollTo(scrollPresenter, 300.0, 0.0, AnimationMode.Disabled, SnapPointsMode.Default, expectedFinalHorizontalOffset: 100.0);
+            ScrollTo(scrollPresenter, 301.0, 0.0, AnimationMode.Disabled, SnapPointsMode.Default, expectedFinalHorizontalOffset: 500.0);
+            ScrollTo(scrollPresenter, 551.0, 0.0, AnimationMode.Disabled, SnapPointsMode.Default, expectedFinalHorizontalOffset: 600.0);
+
+            RunOnUIThread.Execute(() =>
+            {
+                Log.Comment("Clearing the snap points.");
+                scrollPresenter.HorizontalSnapPoints.Clear();
+            });
+
+            IdleSynchronizer.Wait();
+
+            ScrollTo(scrollPresenter, 250.0, 0.0, AnimationMode.Disabled, SnapPointsMode.Default);
+        }
     }
 }
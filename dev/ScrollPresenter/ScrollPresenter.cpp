@@ -1495,15 +1495,11 @@ winrt::float2 ScrollPresenter::ComputePositionFromOffsets(double zoomedHorizonta
 template <typename T>
 double ScrollPresenter::ComputeValueAfterSnapPoints(
     double value,
-    std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>> const& snapPointsSet)
+    SnapPointZoneIndex<SnapPointWrapper<T>> const& snapPointZoneIndex)
 {
-    for (std::shared_ptr<SnapPointWrapper<T>> snapPointWrapper : snapPointsSet)
+    if (const SnapPointWrapper<T>* snapPointWrapper = snapPointZoneIndex.Find(value))
     {
-        if (std::get<0>(snapPointWrapper->ActualApplicableZone()) <= value &&
-            std::get<1>(snapPointWrapper->ActualApplicableZone()) >= value)
-        {
-            return snapPointWrapper->Evaluate(static_cast<float>(value));
-        }
+        return snapPointWrapper->Evaluate(static_cast<float>(value));
     }
     return value;
 }
@@ -1686,9 +1682,9 @@ void ScrollPresenter::ComputeBringIntoViewTargetOffsets(
     {
         // Finally adjust the target offsets based on snap points
         targetZoomedHorizontalOffsetTmp = ComputeValueAfterSnapPoints<winrt::ScrollSnapPointBase>(
-            targetZoomedHorizontalOffsetTmp, m_sortedConsolidatedHorizontalSnapPoints);
+            targetZoomedHorizontalOffsetTmp, m_horizontalSnapPointZoneIndex);
         targetZoomedVerticalOffsetTmp = ComputeValueAfterSnapPoints<winrt::ScrollSnapPointBase>(
-            targetZoomedVerticalOffsetTmp, m_sortedConsolidatedVerticalSnapPoints);
+            targetZoomedVerticalOffsetTmp, m_verticalSnapPointZoneIndex);
 
         // Make sure the target offsets are within the scrollable boundaries
         targetZoomedHorizontalOffsetTmp = std::clamp(targetZoomedHorizontalOffsetTmp, 0.0, scrollableWidth);
@@ -1978,6 +1974,7 @@ void ScrollPresenter::SetupSnapPoints(
 
     // Update the regular and impulse actual applicable ranges.
     UpdateSnapPointsRanges(snapPointsSet, false /*forImpulseOnly*/);
+    UpdateSnapPointZoneIndex(*snapPointsSet, dimension);
 
     winrt::Compositor compositor = m_interactionTracker.Compositor();
     winrt::IVector<winrt::InteractionTrackerInertiaModifier> modifiers = winrt::make<Vector<winrt::InteractionTrackerInertiaModifier>>();
@@ -2097,6 +2094,32 @@ void ScrollPresenter::UpdateSnapPointsRanges(
     }
 }
 
+void ScrollPresenter::UpdateSnapPointZoneIndex(
+    std::set<std::shared_ptr<SnapPointWrapper<winrt::ScrollSnapPointBase>>, SnapPointWrapperComparator<winrt::ScrollSnapPointBase>> const& snapPointsSet,
+    ScrollPresenterDimension dimension)
+{
+    switch (dimension)
+    {
+    case ScrollPresenterDimension::HorizontalScroll:
+        m_horizontalSnapPointZoneIndex.Rebuild(snapPointsSet);
+        break;
+    case ScrollPresenterDimension::VerticalScroll:
+        m_verticalSnapPointZoneIndex.Rebuild(snapPointsSet);
+        break;
+    default:
+        MUX_ASSERT(false);
+    }
+}
+
+void ScrollPresenter::UpdateSnapPointZoneIndex(
+    std::set<std::shared_ptr<SnapPointWrapper<winrt::ZoomSnapPointBase>>, SnapPointWrapperComparator<winrt::ZoomSnapPointBase>> const& snapPointsSet,
+    ScrollPresenterDimension dimension)
+{
+    MUX_ASSERT(dimension == ScrollPresenterDimension::ZoomFactor);
+
+    m_zoomSnapPointZoneIndex.Rebuild(snapPointsSet);
+}
+
 template <typename T>
 void ScrollPresenter::UpdateSnapPointsIgnoredValue(
     std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet,
@@ -6656,8 +6679,8 @@ void ScrollPresenter::ProcessOffsetsChange(
 
     if (snapPointsMode == winrt::SnapPointsMode::Default)
     {
-        zoomedHorizontalOffset = ComputeValueAfterSnapPoints<winrt::ScrollSnapPointBase>(zoomedHorizontalOffset, m_sortedConsolidatedHorizontalSnapPoints);
-        zoomedVerticalOffset = ComputeValueAfterSnapPoints<winrt::ScrollSnapPointBase>(zoomedVerticalOffset, m_sortedConsolidatedVerticalSnapPoints);
+        zoomedHorizontalOffset = ComputeValueAfterSnapPoints<winrt::ScrollSnapPointBase>(zoomedHorizontalOffset, m_horizontalSnapPointZoneIndex);
+        zoomedVerticalOffset = ComputeValueAfterSnapPoints<winrt::ScrollSnapPointBase>(zoomedVerticalOffset, m_verticalSnapPointZoneIndex);
     }
 
     // On pre-RS5 versions, turn off the SnapPointBase::s_isInertiaFromImpulse boolean parameters on the snap points' composition expressions.
@@ -6844,7 +6867,7 @@ void ScrollPresenter::ProcessZoomFactorChange(
 
     if (snapPointsMode == winrt::SnapPointsMode::Default)
     {
-        zoomFactor = static_cast<float>(ComputeValueAfterSnapPoints<winrt::ZoomSnapPointBase>(zoomFactor, m_sortedConsolidatedZoomSnapPoints));
+        zoomFactor = static_cast<float>(ComputeValueAfterSnapPoints<winrt::ZoomSnapPointBase>(zoomFactor, m_zoomSnapPointZoneIndex));
     }
 
     // On pre-RS5 versions, turn off the SnapPointBase::s_isInertiaFromImpulse boolean parameters on the snap points' composition expressions.
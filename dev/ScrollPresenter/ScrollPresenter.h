@@ -12,6 +12,7 @@
 #include "ScrollingBringingIntoViewEventArgs.h"
 #include "ScrollingAnchorRequestedEventArgs.h"
 #include "SnapPointWrapper.h"
+#include "SnapPointZoneIndex.h"
 #include "ScrollPresenterTrace.h"
 #include "ViewChange.h"
 #include "OffsetsChange.h"
@@ -295,7 +296,7 @@ private:
     winrt::float2 ComputeEndOfInertiaPosition();
     void ComputeMinMaxPositions(float zoomFactor, _Out_opt_ winrt::float2* minPosition, _Out_opt_ winrt::float2* maxPosition);
     winrt::float2 ComputePositionFromOffsets(double zoomedHorizontalOffset, double zoomedVerticalOffset);
-    template <typename T> double ComputeValueAfterSnapPoints(double value, std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>> const& snapPointsSet);
+    template <typename T> double ComputeValueAfterSnapPoints(double value, SnapPointZoneIndex<SnapPointWrapper<T>> const& snapPointZoneIndex);
     winrt::float2 ComputeCenterPointerForMouseWheelZooming(const winrt::UIElement& content, const winrt::Point& pointerPosition) const;
     void ComputeBringIntoViewTargetOffsets(
         const winrt::UIElement& content,
@@ -333,6 +334,12 @@ private:
         std::set<std::shared_ptr<SnapPointWrapper<T>>, SnapPointWrapperComparator<T>>* snapPointsSet,
         ScrollPresenterDimension dimension,
         bool isInertiaFromImpulse);
+    void UpdateSnapPointZoneIndex(
+        std::set<std::shared_ptr<SnapPointWrapper<winrt::ScrollSnapPointBase>>, SnapPointWrapperComparator<winrt::ScrollSnapPointBase>> const& snapPointsSet,
+        ScrollPresenterDimension dimension);
+    void UpdateSnapPointZoneIndex(
+        std::set<std::shared_ptr<SnapPointWrapper<winrt::ZoomSnapPointBase>>, SnapPointWrapperComparator<winrt::ZoomSnapPointBase>> const& snapPointsSet,
+        ScrollPresenterDimension dimension);
     void SetupInteractionTrackerBoundaries();
     void SetupInteractionTrackerZoomFactorBoundaries(
         double minZoomFactor, double maxZoomFactor);
@@ -888,6 +895,11 @@ private:
     std::set<std::shared_ptr<SnapPointWrapper<winrt::ScrollSnapPointBase>>, SnapPointWrapperComparator<winrt::ScrollSnapPointBase>> m_sortedConsolidatedHorizontalSnapPoints{};
     std::set<std::shared_ptr<SnapPointWrapper<winrt::ScrollSnapPointBase>>, SnapPointWrapperComparator<winrt::ScrollSnapPointBase>> m_sortedConsolidatedVerticalSnapPoints{};
     std::set<std::shared_ptr<SnapPointWrapper<winrt::ZoomSnapPointBase>>, SnapPointWrapperComparator<winrt::ZoomSnapPointBase>> m_sortedConsolidatedZoomSnapPoints{};
+    // Flat copies of the actual applicable zones of the sets above, used to quickly find the snap point
+    // applicable to a given offset or zoom factor. Updated each time the sets are set up.
+    SnapPointZoneIndex<SnapPointWrapper<winrt::ScrollSnapPointBase>> m_horizontalSnapPointZoneIndex{};
+    SnapPointZoneIndex<SnapPointWrapper<winrt::ScrollSnapPointBase>> m_verticalSnapPointZoneIndex{};
+    SnapPointZoneIndex<SnapPointWrapper<winrt::ZoomSnapPointBase>> m_zoomSnapPointZoneIndex{};
 
     // Maximum difference for offsets to be considered equal. Used for pointer wheel scrolling.
     static constexpr float s_offsetEqualityEpsilon{ 0.00001f };
@@ -0,0 +1,103 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+// The SnapPointZoneIndex class is a flat, sorted copy of the actual applicable zones of a
+// consolidated snap points set. It is used to find the snap point that applies to a given
+// value in O(log n) instead of walking the entire set.
+// TWrapper is expected to expose ActualApplicableZone() like SnapPointWrapper<T>. Repeated snap points are
+// a single entry since SnapPointWrapper<T>::Evaluate resolves the closest repetition analytically.
+
+template <typename TWrapper>
+class SnapPointZoneIndex
+{
+public:
+    // Must be called each time the actual applicable zones of the set's snap points are re-evaluated,
+    // and each time the set itself changes. Entries are expected in the set's sorting order.
+    template <typename TSet>
+    void Rebuild(TSet const& snapPointsSet)
+    {
+        m_zoneStarts.clear();
+        m_zoneEnds.clear();
+        m_wrappers.clear();
+        m_zoneStarts.reserve(snapPointsSet.size());
+        m_zoneEnds.reserve(snapPointsSet.size());
+        m_wrappers.reserve(snapPointsSet.size());
+        m_isSorted = true;
+
+        for (std::shared_ptr<TWrapper> const& snapPointWrapper : snapPointsSet)
+        {
+            const auto zone = snapPointWrapper->ActualApplicableZone();
+            const double zoneStart = std::get<0>(zone);
+            const double zoneEnd = std::get<1>(zone);
+
+            if (!m_wrappers.empty() && (zoneStart < m_zoneStarts.back() || zoneEnd < m_zoneEnds.back()))
+            {
+                // Zones are expected to be ordered like the snap points themselves. Should that not be
+                // the case, Find falls back to the linear scan that preserves the set ordering semantic.
+                m_isSorted = false;
+            }
+
+            m_zoneStarts.push_back(zoneStart);
+            m_zoneEnds.push_back(zoneEnd);
+            m_wrappers.push_back(snapPointWrapper);
+        }
+    }
+
+    void Clear()
+    {
+        m_zoneStarts.clear();
+        m_zoneEnds.clear();
+        m_wrappers.clear();
+        m_isSorted = true;
+    }
+
+    size_t Size() const
+    {
+        return m_wrappers.size();
+    }
+
+    // Returns the first snap point, in set order, whose actual applicable zone includes the provided value,
+    // or nullptr when no snap point applies.
+    TWrapper* Find(double value) const
+    {
+        if (m_isSorted)
+        {
+            // Since both zone starts and zone ends are sorted, the first zone ending at or after the value is
+            // the only candidate: any earlier zone ends before the value and any later zone cannot start earlier.
+            const auto zoneEnd = std::lower_bound(m_zoneEnds.begin(), m_zoneEnds.end(), value);
+
+            if (zoneEnd != m_zoneEnds.end())
+            {
+                const size_t index = zoneEnd - m_zoneEnds.begin();
+
+                if (m_zoneStarts[index] <= value)
+                {
+                    return m_wrappers[index].get();
+                }
+            }
+            return nullptr;
+        }
+
+        for (size_t index = 0; index < m_wrappers.size(); index++)
+        {
+            if (m_zoneStarts[index] <= value && m_zoneEnds[index] >= value)
+            {
+                return m_wrappers[index].get();
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    std::vector<double> m_zoneStarts;
+    std::vector<double> m_zoneEnds;
+    std::vector<std::shared_ptr<TWrapper>> m_wrappers;
+    bool m_isSorted{ true };
+};
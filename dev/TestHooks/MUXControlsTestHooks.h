@@ -39,6 +39,13 @@ public:
     static winrt::event_token LoggingMessage(winrt::TypedEventHandler<winrt::IInspectable, winrt::MUXControlsTestHooksLoggingMessageEventArgs> const& value);
     static void LoggingMessage(winrt::event_token const& token);
 
+    static winrt::XamlMetadataProviderCounters GetXamlMetadataProviderCounters();
+    static void ResetXamlMetadataProviderCounters();
+
+    static winrt::IObservableVector<winrt::IInspectable> CreateObservableVector();
+    static void InsertRange(winrt::IObservableVector<winrt::IInspectable> const& vector, uint32_t index, winrt::array_view<winrt::IInspectable const> values);
+    static void RemoveRange(winrt::IObservableVector<winrt::IInspectable> const& vector, uint32_t index, uint32_t count);
+
     static winrt::event_token BuildTreeCompleted(winrt::TypedEventHandler<winrt::IInspectable, winrt::IInspectable> const& value); // subscribe
     static void BuildTreeCompleted(winrt::event_token const& token); // unsubscribe
     static void NotifyBuildTreeCompleted();
@@ -4,6 +4,10 @@
 #include "pch.h"
 #include "common.h"
 #include "MUXControlsTestHooks.h"
+#include "XamlMetadataProvider.h"
+#include "Vector.h"
+
+using ObservableObjectVector = Vector<winrt::IInspectable, MakeVectorParam<VectorFlag::Observable>()>;
 
 MUXControlsTestHooks* MUXControlsTestHooks::s_testHooks = nullptr;
 
@@ -46,3 +50,32 @@ void MUXControlsTestHooks::LoggingMessage(winrt::event_token const& token)
         s_testHooks->LoggingMessageImpl(token);
     }
 }
+
+winrt::XamlMetadataProviderCounters MUXControlsTestHooks::GetXamlMetadataProviderCounters()
+{
+    const auto counters = XamlMetadataProvider::Counters();
+    return winrt::XamlMetadataProviderCounters{
+        counters.Lookups,
+        counters.Misses,
+        counters.ColdTypeCreations };
+}
+
+void MUXControlsTestHooks::ResetXamlMetadataProviderCounters()
+{
+    XamlMetadataProvider::ResetCounters();
+}
+
+winrt::IObservableVector<winrt::IInspectable> MUXControlsTestHooks::CreateObservableVector()
+{
+    return winrt::make<ObservableObjectVector>();
+}
+
+void MUXControlsTestHooks::InsertRange(winrt::IObservableVector<winrt::IInspectable> const& vector, uint32_t index, winrt::array_view<winrt::IInspectable const> values)
+{
+    winrt::get_self<ObservableObjectVector>(vector)->InsertRange(index, values);
+}
+
+void MUXControlsTestHooks::RemoveRange(winrt::IObservableVector<winrt::IInspectable> const& vector, uint32_t index, uint32_t count)
+{
+    winrt::get_self<ObservableObjectVector>(vector)->RemoveRange(index, count);
+}
@@ -10,6 +10,7 @@ using System.Threading;
 using System.Collections.Generic;
 using Windows.Foundation.Collections;
 using Windows.UI.Xaml.Media;
+using Windows.UI.Xaml.Input;
 using Windows.UI.Xaml.Markup;
 using Windows.UI.Xaml.Media.Animation;
 using System.Collections.ObjectModel;
@@ -151,6 +152,225 @@ namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
             });
         }
 
+        [TestMethod]
+        public void TreeViewNestedInsertAndRemoveKeepsFlatOrder()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var treeView = new TreeView();
+
+                Content = treeView;
+                Content.UpdateLayout();
+                var listControl = FindVisualChildByName(treeView, "ListControl") as TreeViewList;
+
+                TreeViewNode a = new TreeViewNode() { Content = "A" };
+                TreeViewNode a1 = new TreeViewNode() { Content = "A:1" };
+                TreeViewNode a11 = new TreeViewNode() { Content = "A:1:1" };
+                TreeViewNode a2 = new TreeViewNode() { Content = "A:2" };
+                TreeViewNode b = new TreeViewNode() { Content = "B" };
+                a1.Children.Add(a11);
+                a.Children.Add(a1);
+                a.Children.Add(a2);
+
+                treeView.RootNodes.Add(a);
+                treeView.RootNodes.Add(b);
+                a1.IsExpanded = true;
+                a.IsExpanded = true;
+
+                Action<TreeViewNode[]> verifyFlatTree = (expectedNodes) =>
+                {
+                    Verify.AreEqual(expectedNodes.Length, listControl.Items.Count);
+                    for (int i = 0; i < expectedNodes.Length; i++)
+                    {
+                        Verify.AreEqual(expectedNodes[i], listControl.Items[i]);
+                        Verify.AreEqual(i, listControl.Items.IndexOf(expectedNodes[i]));
+                    }
+                };
+
+                verifyFlatTree(new[] { a, a1, a11, a2, b });
+
+                // Insert after a sibling that has visible descendants
+                TreeViewNode inserted = new TreeViewNode() { Content = "Inserted" };
+                a.Children.Insert(1, inserted);
+                verifyFlatTree(new[] { a, a1, a11, inserted, a2, b });
+
+                // Remove a sibling that has visible descendants
+                a.Children.RemoveAt(0);
+                verifyFlatTree(new[] { a, inserted, a2, b });
+
+                // Collapse removes all visible descendants at once
+                a.IsExpanded = false;
+                verifyFlatTree(new[] { a, b });
+                Verify.AreEqual(-1, listControl.Items.IndexOf(a2));
+
+                a.IsExpanded = true;
+                verifyFlatTree(new[] { a, inserted, a2, b });
+            });
+        }
+
+        [TestMethod]
+        public void TreeViewExpandAllAndCollapseAllTest()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var treeView = new TreeView();
+
+                Content = treeView;
+                Content.UpdateLayout();
+                var listControl = FindVisualChildByName(treeView, "ListControl") as TreeViewList;
+
+                // Enough nodes for the view to be updated with a single splice instead of node by node
+                TreeViewNode root = new TreeViewNode() { Content = "Root" };
+                for (int i = 0; i < 10; i++)
+                {
+                    var child = new TreeViewNode() { Content = "Child " + i };
+                    for (int j = 0; j < 10; j++)
+                    {
+                        var grandChild = new TreeViewNode() { Content = "Child " + i + ":" + j };
+                        grandChild.Children.Add(new TreeViewNode() { Content = "Child " + i + ":" + j + ":0" });
+                        child.Children.Add(grandChild);
+                    }
+                    root.Children.Add(child);
+                }
+                TreeViewNode sibling = new TreeViewNode() { Content = "Sibling" };
+                treeView.RootNodes.Add(root);
+                treeView.RootNodes.Add(sibling);
+                Verify.AreEqual(2, listControl.Items.Count);
+
+                int expandingCount = 0;
+                int collapsedCount = 0;
+                treeView.Expanding += (sender, args) => expandingCount++;
+                treeView.Collapsed += (sender, args) => collapsedCount++;
+
+                Action verifyFlatTree = () =>
+                {
+                    var expectedNodes = new List<TreeViewNode>();
+                    Action<TreeViewNode> appendVisible = null;
+                    appendVisible = (node) =>
+                    {
+                        expectedNodes.Add(node);
+                        if (node.IsExpanded)
+                        {
+                            foreach (var child in node.Children)
+                            {
+                                appendVisible(child);
+                            }
+                        }
+                    };
+                    appendVisible(root);
+                    appendVisible(sibling);
+
+                    Verify.AreEqual(expectedNodes.Count, listControl.Items.Count);
+                    for (int i = 0; i < expectedNodes.Count; i++)
+                    {
+                        Verify.AreEqual(expectedNodes[i], listControl.Items[i]);
+                    }
+                };
+
+                // Depth 1 expands root and its children, not the grand children
+                treeView.ExpandAll(root, 1);
+                Verify.AreEqual(11, expandingCount);
+                Verify.IsFalse(root.Children[0].Children[0].IsExpanded);
+                Verify.AreEqual(1 + 10 + 100 + 1, listControl.Items.Count);
+                verifyFlatTree();
+
+                // Negative depth expands everything that has children, leaves stay collapsed
+                treeView.ExpandAll(root, -1);
+                Verify.AreEqual(111, expandingCount);
+                Verify.IsFalse(root.Children[0].Children[0].Children[0].IsExpanded);
+                Verify.AreEqual(1 + 10 + 100 + 100 + 1, listControl.Items.Count);
+                verifyFlatTree();
+
+                // The view keeps tracking regular changes after a bulk update
+                root.Children[3].Children.RemoveAt(5);
+                root.Children[3].Children[0].IsExpanded = false;
+                verifyFlatTree();
+
+                // Depth 0 only collapses the node itself, its descendants stay expanded
+                treeView.CollapseAll(root.Children[0], 0);
+                Verify.AreEqual(1 + 1, collapsedCount);
+                Verify.IsTrue(root.Children[0].Children[0].IsExpanded);
+                verifyFlatTree();
+
+                // Depth 1 collapses root and its children, not the grand children
+                treeView.CollapseAll(root, 1);
+                Verify.AreEqual(1 + 1 + 10, collapsedCount);
+                Verify.IsTrue(root.Children[1].Children[0].IsExpanded);
+                Verify.AreEqual(2, listControl.Items.Count);
+                verifyFlatTree();
+
+                // Negative depth collapses everything
+                treeView.CollapseAll(root, -1);
+                Verify.AreEqual(1 + 1 + 10 + 98, collapsedCount);
+                Verify.IsFalse(root.Children[1].Children[0].IsExpanded);
+                Verify.AreEqual(2, listControl.Items.Count);
+                verifyFlatTree();
+
+                // Collapsed descendants stay collapsed when the node is expanded again
+                treeView.Expand(root);
+                Verify.AreEqual(1 + 10 + 1, listControl.Items.Count);
+                verifyFlatTree();
+            });
+        }
+
+        [TestMethod]
+        public void TreeViewExpandAllAndCollapseAllKeepSelectionAndFocus()
+        {
+            TreeView treeView = null;
+            TreeViewList listControl = null;
+            TreeViewNode root = null;
+            TreeViewNode sibling = null;
+
+            RunOnUIThread.Execute(() =>
+            {
+                treeView = new TreeView();
+                Content = treeView;
+                Content.UpdateLayout();
+                listControl = FindVisualChildByName(treeView, "ListControl") as TreeViewList;
+
+                // Enough nodes for the view to be updated with a single Reset
+                root = new TreeViewNode() { Content = "Root" };
+                for (int i = 0; i < 40; i++)
+                {
+                    root.Children.Add(new TreeViewNode() { Content = "Child " + i });
+                }
+                sibling = new TreeViewNode() { Content = "Sibling" };
+                treeView.RootNodes.Add(root);
+                treeView.RootNodes.Add(sibling);
+                Content.UpdateLayout();
+
+                treeView.SelectedNode = sibling;
+                Verify.AreEqual(sibling, listControl.SelectedItem);
+                ((TreeViewItem)treeView.ContainerFromNode(sibling)).Focus(FocusState.Keyboard);
+            });
+            IdleSynchronizer.Wait();
+
+            Action<Action> verifySelectionAndFocusSurvive = (updateExpansion) =>
+            {
+                RunOnUIThread.Execute(() =>
+                {
+                    Verify.AreEqual(treeView.ContainerFromNode(sibling), FocusManager.GetFocusedElement());
+                    updateExpansion();
+                });
+                IdleSynchronizer.Wait();
+
+                RunOnUIThread.Execute(() =>
+                {
+                    Verify.AreEqual(sibling, listControl.SelectedItem);
+                    Verify.AreEqual(sibling, treeView.SelectedNode);
+                    Verify.AreEqual(treeView.ContainerFromNode(sibling), FocusManager.GetFocusedElement());
+                });
+            };
+
+            Log.Comment("Expanding root inserts its 40 children with a Reset");
+            verifySelectionAndFocusSurvive(() => treeView.ExpandAll(root, 0));
+            RunOnUIThread.Execute(() => Verify.AreEqual(42, listControl.Items.Count));
+
+            Log.Comment("Collapsing root removes its 40 children with a Reset");
+            verifySelectionAndFocusSurvive(() => treeView.CollapseAll(root, 0));
+            RunOnUIThread.Execute(() => Verify.AreEqual(2, listControl.Items.Count));
+        }
+
         [TestMethod]
         public void TreeViewItemSourceResetRecreateItems()
         {
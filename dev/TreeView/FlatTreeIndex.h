@@ -0,0 +1,258 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Keeps track of the position of every key of a list (the flat tree of the TreeView
+// ViewModel) while items get inserted and removed anywhere in it.
+//
+// Internally this is an implicit treap: an order statistic tree ordered by position
+// where every node knows the size of its subtree, plus a hash map from key to tree
+// node. Insert, Remove and PositionOf are all O(log n) instead of the O(n) linear
+// search of the list.
+//
+// Keys must be unique and hashable.
+template <typename TKey>
+class FlatTreeIndex final
+{
+public:
+    uint32_t Size() const
+    {
+        return m_root == InvalidNode ? 0 : m_nodes[m_root].size;
+    }
+
+    bool Contains(TKey key) const
+    {
+        return m_keyToNode.find(key) != m_keyToNode.end();
+    }
+
+    void Clear()
+    {
+        m_nodes.clear();
+        m_freeNodes.clear();
+        m_keyToNode.clear();
+        m_root = InvalidNode;
+    }
+
+    bool PositionOf(TKey key, uint32_t& position) const
+    {
+        const auto it = m_keyToNode.find(key);
+        if (it == m_keyToNode.end())
+        {
+            return false;
+        }
+
+        int node = it->second;
+        position = SizeOf(m_nodes[node].left);
+        while (m_nodes[node].parent != InvalidNode)
+        {
+            const int parent = m_nodes[node].parent;
+            if (m_nodes[parent].right == node)
+            {
+                position += SizeOf(m_nodes[parent].left) + 1;
+            }
+            node = parent;
+        }
+        return true;
+    }
+
+    void Insert(uint32_t position, TKey key)
+    {
+        MUX_ASSERT(!Contains(key) && position <= Size());
+
+        const int node = AllocateNode(key);
+        m_keyToNode[key] = node;
+
+        int left;
+        int right;
+        Split(m_root, position, left, right);
+        m_root = Merge(Merge(left, node), right);
+        m_nodes[m_root].parent = InvalidNode;
+    }
+
+    void Remove(TKey key)
+    {
+        uint32_t position;
+        if (PositionOf(key, position))
+        {
+            RemoveAt(position);
+        }
+    }
+
+    void RemoveAt(uint32_t position)
+    {
+        MUX_ASSERT(position < Size());
+
+        int left;
+        int middle;
+        int right;
+        Split(m_root, position, left, right);
+        Split(right, 1, middle, right);
+
+        m_keyToNode.erase(m_nodes[middle].key);
+        m_freeNodes.push_back(middle);
+
+        m_root = Merge(left, right);
+        if (m_root != InvalidNode)
+        {
+            m_nodes[m_root].parent = InvalidNode;
+        }
+    }
+
+    // Replaces the key at position, keeping every position unchanged.
+    void Replace(uint32_t position, TKey key)
+    {
+        MUX_ASSERT(position < Size());
+
+        int node = m_root;
+        while (true)
+        {
+            const uint32_t leftSize = SizeOf(m_nodes[node].left);
+            if (position < leftSize)
+            {
+                node = m_nodes[node].left;
+            }
+            else if (position == leftSize)
+            {
+                break;
+            }
+            else
+            {
+                position -= leftSize + 1;
+                node = m_nodes[node].right;
+            }
+        }
+
+        m_keyToNode.erase(m_nodes[node].key);
+        m_nodes[node].key = key;
+        m_keyToNode[key] = node;
+    }
+
+private:
+    static constexpr int InvalidNode = -1;
+
+    struct Node
+    {
+        TKey key{};
+        uint32_t priority{};
+        uint32_t size{};
+        int left{ InvalidNode };
+        int right{ InvalidNode };
+        int parent{ InvalidNode };
+    };
+
+    uint32_t SizeOf(int node) const
+    {
+        return node == InvalidNode ? 0 : m_nodes[node].size;
+    }
+
+    void Update(int node)
+    {
+        Node& n = m_nodes[node];
+        n.size = SizeOf(n.left) + SizeOf(n.right) + 1;
+        if (n.left != InvalidNode)
+        {
+            m_nodes[n.left].parent = node;
+        }
+        if (n.right != InvalidNode)
+        {
+            m_nodes[n.right].parent = node;
+        }
+    }
+
+    // Splits the tree rooted at node into the first count items (left) and the rest (right).
+    void Split(int node, uint32_t count, int& left, int& right)
+    {
+        if (node == InvalidNode)
+        {
+            left = right = InvalidNode;
+            return;
+        }
+
+        const uint32_t leftSize = SizeOf(m_nodes[node].left);
+        if (count <= leftSize)
+        {
+            int subtreeRight;
+            Split(m_nodes[node].left, count, left, subtreeRight);
+            m_nodes[node].left = subtreeRight;
+            right = node;
+        }
+        else
+        {
+            int subtreeLeft;
+            Split(m_nodes[node].right, count - leftSize - 1, subtreeLeft, right);
+            m_nodes[node].right = subtreeLeft;
+            left = node;
+        }
+        Update(node);
+
+        if (left != InvalidNode)
+        {
+            m_nodes[left].parent = InvalidNode;
+        }
+        if (right != InvalidNode)
+        {
+            m_nodes[right].parent = InvalidNode;
+        }
+    }
+
+    int Merge(int left, int right)
+    {
+        if (left == InvalidNode)
+        {
+            return right;
+        }
+        if (right == InvalidNode)
+        {
+            return left;
+        }
+
+        if (m_nodes[left].priority > m_nodes[right].priority)
+        {
+            m_nodes[left].right = Merge(m_nodes[left].right, right);
+            Update(left);
+            return left;
+        }
+
+        m_nodes[right].left = Merge(left, m_nodes[right].left);
+        Update(right);
+        return right;
+    }
+
+    int AllocateNode(TKey key)
+    {
+        int node;
+        if (!m_freeNodes.empty())
+        {
+            node = m_freeNodes.back();
+            m_freeNodes.pop_back();
+        }
+        else
+        {
+            node = static_cast<int>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+
+        // xorshift32: treap priorities only need to be well spread, not unpredictable.
+        m_seed ^= m_seed << 13;
+        m_seed ^= m_seed >> 17;
+        m_seed ^= m_seed << 5;
+
+        Node& n = m_nodes[node];
+        n.key = key;
+        n.priority = m_seed;
+        n.size = 1;
+        n.left = n.right = n.parent = InvalidNode;
+        return node;
+    }
+
+    std::vector<Node> m_nodes{};
+    std::vector<int> m_freeNodes{};
+    std::unordered_map<TKey, int> m_keyToNode{};
+    int m_root{ InvalidNode };
+    uint32_t m_seed{ 2463534242u };
+};
@@ -149,6 +149,18 @@ void TreeView::Collapse(winrt::TreeViewNode const& value)
     vm->CollapseNode(value);
 }
 
+void TreeView::ExpandAll(winrt::TreeViewNode const& value, int32_t depth)
+{
+    const auto vm = ListControl()->ListViewModel();
+    vm->ExpandAll(value, depth);
+}
+
+void TreeView::CollapseAll(winrt::TreeViewNode const& value, int32_t depth)
+{
+    const auto vm = ListControl()->ListViewModel();
+    vm->CollapseAll(value, depth);
+}
+
 void TreeView::SelectAll()
 {
     const auto vm = ListControl()->ListViewModel();
@@ -40,6 +40,8 @@ public:
 
     void Expand(winrt::TreeViewNode const& value);
     void Collapse(winrt::TreeViewNode const& value);
+    void ExpandAll(winrt::TreeViewNode const& value, int32_t depth);
+    void CollapseAll(winrt::TreeViewNode const& value, int32_t depth);
     void SelectAll();
 
     void OnItemClick(const winrt::IInspectable& sender, const winrt::ItemClickEventArgs& args);
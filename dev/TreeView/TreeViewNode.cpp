@@ -455,13 +455,18 @@ void TreeViewNodeVector::Clear(bool updateItemsSource,bool updateIsExpanded)
 
     if (count > 0)
     {
+        m_clearedNodes.reserve(count);
         for (unsigned int i = 0; i < count; i++)
         {
             auto node = inner->GetAt(i);
             winrt::get_self<TreeViewNode>(node)->put_ParentImpl(nullptr);
+            m_clearedNodes.push_back(node);
         }
 
-        inner->Clear();
+        {
+            auto clearedNodes = gsl::finally([this]() { m_clearedNodes.clear(); });
+            inner->Clear();
+        }
 
         if (updateItemsSource)
         {
@@ -96,6 +96,8 @@ class TreeViewNodeVector :
 
 private:
     winrt::weak_ref<winrt::TreeViewNode> m_parent{ nullptr };
+    // Children removed by the Clear whose Reset notification is being raised.
+    std::vector<winrt::TreeViewNode> m_clearedNodes{};
 
 public:
     
@@ -113,4 +115,8 @@ public:
     void RemoveAtEnd(bool updateItemsSource = true);
     void ReplaceAll(winrt::array_view<winrt::TreeViewNode const> values, bool updateItemsSource = true);    
     void Clear(bool updateItemsSource = true, bool updateIsExpanded = true);
+
+    // Handlers of the Reset raised by Clear can no longer reach the removed children
+    // through the vector, this lists them for the duration of the notification.
+    const std::vector<winrt::TreeViewNode>& ClearedNodes() const { return m_clearedNodes; }
 };
@@ -9,6 +9,7 @@
 #include "VectorChangedEventArgs.h"
 #include "TreeViewList.h"
 #include <HashMap.h>
+#include <unordered_set>
 
 // Need to update node selection states on UI before vector changes.
 // Listen on vector change events don't solve the problem because the event already happened when the event handler gets called.
@@ -29,6 +30,8 @@ class SelectedTreeNodeVector :
 
 private:
     winrt::weak_ref<ViewModel> m_viewModel{ nullptr };
+    // Same nodes as the vector, so that Contains doesn't have to search it.
+    std::unordered_set<TreeViewNode*> m_nodeSet;
 
     void UpdateSelection(winrt::TreeViewNode const& node, TreeNodeSelectionState state)
     {
@@ -101,8 +104,7 @@ public:
 
     bool Contains(winrt::TreeViewNode const& node)
     {
-        uint32_t index;
-        return GetVectorInnerImpl()->IndexOf(node, index);
+        return m_nodeSet.find(winrt::get_self<TreeViewNode>(node)) != m_nodeSet.end();
     }
 
     // Default write methods will trigger TreeView visual updates.
@@ -110,6 +112,7 @@ public:
     void InsertAtCore(unsigned int index, winrt::TreeViewNode const& node)
     {
         GetVectorInnerImpl()->InsertAt(index, node);
+        m_nodeSet.insert(winrt::get_self<TreeViewNode>(node));
 
         // Keep SelectedItems and SelectedNodes in sync
         if (auto viewModel = m_viewModel.get())
@@ -131,7 +134,9 @@ public:
 
     void RemoveAtCore(unsigned int index)
     {
-        GetVectorInnerImpl()->RemoveAt(index);
+        auto inner = GetVectorInnerImpl();
+        m_nodeSet.erase(winrt::get_self<TreeViewNode>(inner->GetAt(index)));
+        inner->RemoveAt(index);
 
         // Keep SelectedItems and SelectedNodes in sync
         if (auto viewModel = m_viewModel.get())
@@ -422,6 +427,11 @@ bool ViewModel::IndexOf(winrt::IInspectable const& value, uint32_t& index)
     {
         return indexOfFunction(value, index);
     }
+    else if (auto node = value.try_as<winrt::TreeViewNode>())
+    {
+        index = 0;
+        return IndexOfNode(node, index);
+    }
     else
     {
         auto inner = GetVectorInnerImpl();
@@ -463,6 +473,8 @@ void ViewModel::SetAt(uint32_t index, winrt::IInspectable const& value)
     inner->SetAt(index, value);
 
     winrt::TreeViewNode newNode = value.as<winrt::TreeViewNode>();
+    RemoveFromFlatTreeIndex(index, current);
+    AddToFlatTreeIndex(index, newNode);
 
     auto tvnCurrent = winrt::get_self<TreeViewNode>(current);
     tvnCurrent->ChildrenChanged(m_collectionChangedEventTokenVector[index]);
@@ -478,6 +490,7 @@ void ViewModel::InsertAt(uint32_t index, winrt::IInspectable const& value)
 {
     GetVectorInnerImpl()->InsertAt(index, value);
     winrt::TreeViewNode newNode = value.as<winrt::TreeViewNode>();
+    AddToFlatTreeIndex(index, newNode);
 
     // Hook up events and save tokens
     auto tvnNewNode = winrt::get_self<TreeViewNode>(newNode);
@@ -490,6 +503,7 @@ void ViewModel::RemoveAt(uint32_t index)
     auto inner = GetVectorInnerImpl();
     auto current = inner->GetAt(index).as<winrt::TreeViewNode>();
     inner->RemoveAt(index);
+    RemoveFromFlatTreeIndex(index, current);
 
     // Unhook event handlers
     auto tvnCurrent = winrt::get_self<TreeViewNode>(current);
@@ -505,6 +519,7 @@ void ViewModel::Append(winrt::IInspectable const& value)
 {
     GetVectorInnerImpl()->Append(value);
     winrt::TreeViewNode newNode = value.as<winrt::TreeViewNode>();
+    AddToFlatTreeIndex(Size() - 1, newNode);
     
     // Hook up events and save tokens
     auto tvnNewNode = winrt::get_self<TreeViewNode>(newNode);
@@ -517,6 +532,7 @@ void ViewModel::RemoveAtEnd()
     auto inner = GetVectorInnerImpl();
     auto current = inner->GetAt(Size() - 1).as<winrt::TreeViewNode>();
     inner->RemoveAtEnd();
+    RemoveFromFlatTreeIndex(Size(), current);
 
     // Unhook events
     auto tvnCurrent = winrt::get_self<TreeViewNode>(current);
@@ -542,7 +558,28 @@ void ViewModel::Clear()
 void ViewModel::ReplaceAll(winrt::array_view<winrt::IInspectable const> items)
 {
     auto inner = GetVectorInnerImpl();
-    return inner->ReplaceAll(items);
+    inner->ReplaceAll(items);
+
+    // Rebuild the flat tree index, keeping only the origin node's entry.
+    m_flatTreeIndex.Clear();
+    auto originNode = m_originNode.safe_get();
+    for (auto it = m_flatTreeNodeInfos.begin(); it != m_flatTreeNodeInfos.end();)
+    {
+        if (originNode && it->first == winrt::get_self<TreeViewNode>(originNode))
+        {
+            it->second.visibleDescendantCount = 0;
+            ++it;
+        }
+        else
+        {
+            it = m_flatTreeNodeInfos.erase(it);
+        }
+    }
+
+    for (uint32_t i = 0; i < Size(); i++)
+    {
+        AddToFlatTreeIndex(i, GetNodeAt(i));
+    }
 }
 
 // Helper function
@@ -551,30 +588,26 @@ void ViewModel::PrepareView(const winrt::TreeViewNode& originNode)
     // Remove any existing RootNode events/children
     if (auto existingOriginNode = m_originNode.get())
     {
-        for (int i = (existingOriginNode.Children().Size() - 1); i >= 0; i--)
-        {
-            auto removeNode = existingOriginNode.Children().GetAt(i).as<winrt::TreeViewNode>();
-            RemoveNodeAndDescendantsFromView(removeNode);
-        }
+        // Every node in the view is a descendant of the origin node.
+        SpliceView(0, Size(), {});
 
         if (m_rootNodeChildrenChangedEventToken.value != 0)
         {
             existingOriginNode.Children().as<winrt::IObservableVector<winrt::TreeViewNode>>().VectorChanged(m_rootNodeChildrenChangedEventToken);
         }
+
+        m_flatTreeNodeInfos.erase(winrt::get_self<TreeViewNode>(existingOriginNode));
     }
 
     // Add new RootNode & children
     m_originNode.set(originNode);
+    m_flatTreeNodeInfos[winrt::get_self<TreeViewNode>(originNode)] = FlatTreeNodeInfo{};
     m_rootNodeChildrenChangedEventToken = winrt::get_self<TreeViewNode>(originNode)->ChildrenChanged({ this, &ViewModel::TreeViewNodeVectorChanged });
     originNode.IsExpanded(true);
 
-    int allOpenedDescendantsCount = 0;
-    for (unsigned int i = 0; i < originNode.Children().Size(); i++)
-    {
-        auto addNode = originNode.Children().GetAt(i).as<winrt::TreeViewNode>();
-        AddNodeToView(addNode, i + allOpenedDescendantsCount);
-        allOpenedDescendantsCount = AddNodeDescendantsToView(addNode, i, allOpenedDescendantsCount);
-    }
+    std::vector<winrt::TreeViewNode> nodes;
+    AppendVisibleDescendants(originNode, nodes);
+    SpliceView(0, 0, nodes);
 }
 
 void ViewModel::SetOwners(winrt::TreeViewList const& owningList, winrt::TreeView const& owningTreeView)
@@ -594,12 +627,15 @@ bool ViewModel::IsInSingleSelectionMode()
 }
 
 // Private helpers
-void ViewModel::AddNodeToView(const winrt::TreeViewNode& value, unsigned int index)
+void ViewModel::AddNodeAndDescendantsToView(const winrt::TreeViewNode& value, unsigned int index)
 {
-    InsertAt(index, value);
+    std::vector<winrt::TreeViewNode> nodes{ value };
+    AppendVisibleDescendants(value, nodes);
+    SpliceView(index, 0, nodes);
 }
 
-int ViewModel::AddNodeDescendantsToView(const winrt::TreeViewNode& value, unsigned int index, int offset)
+// Appends the descendants of value that are visible when value is in the view, in flat tree order.
+void ViewModel::AppendVisibleDescendants(const winrt::TreeViewNode& value, std::vector<winrt::TreeViewNode>& nodes)
 {
     if (value.IsExpanded())
     {
@@ -607,44 +643,205 @@ int ViewModel::AddNodeDescendantsToView(const winrt::TreeViewNode& value, unsign
         for (unsigned int i = 0; i < size; i++)
         {
             auto childNode = value.Children().GetAt(i).as<winrt::TreeViewNode>();
-            offset++;
-            AddNodeToView(childNode, offset + index);
-            offset = AddNodeDescendantsToView(childNode, index, offset);
+            nodes.push_back(childNode);
+            AppendVisibleDescendants(childNode, nodes);
         }
-
-        return offset;
     }
-
-    return offset;
 }
 
 void ViewModel::RemoveNodeAndDescendantsFromView(const winrt::TreeViewNode& value)
 {
     UINT32 valueIndex;
-    if (value.IsExpanded())
+    const bool containsValue = IndexOfNode(value, valueIndex);
+    if (containsValue)
     {
-        unsigned int size = value.Children().Size();
-        for (unsigned int i = 0; i < size; i++)
+        // The node's visible descendants are right after it in the flat tree.
+        SpliceView(valueIndex, VisibleDescendantCount(value) + 1, {});
+    }
+}
+
+// The range is expected to cover whole subtrees: a node is never removed without its visible descendants.
+void ViewModel::RemoveNodesAndDescendentsWithFlatIndexRange(unsigned int lowIndex, unsigned int highIndex)
+{
+    MUX_ASSERT(lowIndex <= highIndex);
+
+    SpliceView(lowIndex, highIndex - lowIndex + 1, {});
+}
+
+// Replaces removeCount nodes of the flat tree starting at index with nodes, which must be in flat tree
+// order. Small changes raise one notification per node like the IVector functions do, larger ones are
+// applied to the vector at once with a single Reset so that the list does one layout pass.
+void ViewModel::SpliceView(unsigned int index, unsigned int removeCount, std::vector<winrt::TreeViewNode> const& nodes)
+{
+    if (removeCount + nodes.size() <= c_maxItemNotificationsPerSplice)
+    {
+        // Back to front so that descendants go away before their ancestors.
+        for (unsigned int i = index + removeCount; i-- > index;)
         {
-            auto childNode = value.Children().GetAt(i).as<winrt::TreeViewNode>();
-            RemoveNodeAndDescendantsFromView(childNode);
+            RemoveAt(i);
         }
+
+        for (unsigned int i = 0; i < nodes.size(); i++)
+        {
+            InsertAt(index + i, nodes[i]);
+        }
+        return;
     }
 
-    const bool containsValue = IndexOfNode(value, valueIndex);
-    if (containsValue)
+    // The list drops its selection and recreates every container on a Reset, which loses focus.
+    // Remember both so that they can be restored for nodes that are still in the view.
+    const auto listControl = ListControl();
+    winrt::IInspectable selectedNode{ nullptr };
+    winrt::Control focusedContainer{ nullptr };
+    winrt::TreeViewNode focusedNode{ nullptr };
+    if (listControl)
+    {
+        if (IsInSingleSelectionMode())
+        {
+            selectedNode = listControl.SelectedItem();
+        }
+
+        focusedContainer = winrt::FocusManager::GetFocusedElement().try_as<winrt::Control>();
+        if (focusedContainer)
+        {
+            focusedNode = listControl.ItemFromContainer(focusedContainer).try_as<winrt::TreeViewNode>();
+        }
+    }
+
+    auto inner = GetVectorInnerImpl();
+    for (unsigned int i = index + removeCount; i-- > index;)
     {
-        RemoveAt(valueIndex);
+        auto current = inner->GetAt(i).as<winrt::TreeViewNode>();
+        RemoveFromFlatTreeIndex(i, current);
+
+        // Unhook event handlers
+        auto tvnCurrent = winrt::get_self<TreeViewNode>(current);
+        tvnCurrent->ChildrenChanged(m_collectionChangedEventTokenVector[i]);
+        tvnCurrent->RemoveExpandedChanged(m_IsExpandedChangedEventTokenVector[i]);
+    }
+    m_collectionChangedEventTokenVector.erase(m_collectionChangedEventTokenVector.begin() + index, m_collectionChangedEventTokenVector.begin() + index + removeCount);
+    m_IsExpandedChangedEventTokenVector.erase(m_IsExpandedChangedEventTokenVector.begin() + index, m_IsExpandedChangedEventTokenVector.begin() + index + removeCount);
+
+    std::vector<winrt::IInspectable> values;
+    std::vector<winrt::event_token> collectionChangedEventTokens;
+    std::vector<winrt::event_token> isExpandedChangedEventTokens;
+    values.reserve(nodes.size());
+    collectionChangedEventTokens.reserve(nodes.size());
+    isExpandedChangedEventTokens.reserve(nodes.size());
+    for (unsigned int i = 0; i < nodes.size(); i++)
+    {
+        auto const& newNode = nodes[i];
+        values.push_back(newNode);
+        AddToFlatTreeIndex(index + i, newNode);
+
+        // Hook up events and save tokens
+        auto tvnNewNode = winrt::get_self<TreeViewNode>(newNode);
+        collectionChangedEventTokens.push_back(tvnNewNode->ChildrenChanged({ this, &ViewModel::TreeViewNodeVectorChanged }));
+        isExpandedChangedEventTokens.push_back(tvnNewNode->AddExpandedChanged({ this, &ViewModel::TreeViewNodePropertyChanged }));
+    }
+    m_collectionChangedEventTokenVector.insert(m_collectionChangedEventTokenVector.begin() + index, collectionChangedEventTokens.begin(), collectionChangedEventTokens.end());
+    m_IsExpandedChangedEventTokenVector.insert(m_IsExpandedChangedEventTokenVector.begin() + index, isExpandedChangedEventTokens.begin(), isExpandedChangedEventTokens.end());
+
+    inner->ReplaceRange(index, removeCount, values);
+
+    uint32_t unused;
+    if (selectedNode && listControl.SelectedItem() != selectedNode && IndexOf(selectedNode, unused))
+    {
+        listControl.SelectedItem(selectedNode);
+    }
+
+    if (focusedNode && IndexOf(focusedNode, unused))
+    {
+        const auto focusState = focusedContainer.FocusState();
+        m_restoreFocusLayoutUpdatedRevoker = listControl.LayoutUpdated(winrt::auto_revoke,
+            [this, focusedNode, focusState](auto const&, auto const&)
+            {
+                m_restoreFocusLayoutUpdatedRevoker.revoke();
+                if (auto const listControl = ListControl())
+                {
+                    if (auto const container = listControl.ContainerFromItem(focusedNode).try_as<winrt::Control>())
+                    {
+                        container.Focus(focusState);
+                    }
+                }
+            });
     }
 }
 
-void ViewModel::RemoveNodesAndDescendentsWithFlatIndexRange(unsigned int lowIndex, unsigned int highIndex)
+// Expands value and its descendants down to depth levels below value, or all of them when depth
+// is negative. The Expanding event is raised for every node that gets expanded.
+void ViewModel::ExpandAll(const winrt::TreeViewNode& value, int depth)
 {
-    MUX_ASSERT(lowIndex <= highIndex);
+    UpdateExpansionInBulk(value, [this, &value, depth]()
+    {
+        SetIsExpandedToDepth(value, true, depth);
+    });
+}
 
-    for (int i = static_cast<int>(highIndex); i >= static_cast<int>(lowIndex); i--)
+// Collapses value and its descendants down to depth levels below value, or all of them when depth
+// is negative. The Collapsed event is raised for every node that gets collapsed.
+void ViewModel::CollapseAll(const winrt::TreeViewNode& value, int depth)
+{
+    UpdateExpansionInBulk(value, [this, &value, depth]()
     {
-        RemoveNodeAndDescendantsFromView(GetNodeAt(i));
+        SetIsExpandedToDepth(value, false, depth);
+    });
+}
+
+void ViewModel::SetIsExpandedToDepth(const winrt::TreeViewNode& value, bool isExpanded, int depth)
+{
+    // The origin node always stays expanded, and nodes without children are never expanded.
+    if (value.IsExpanded() != isExpanded &&
+        value != m_originNode.get() &&
+        (!isExpanded || value.Children().Size() > 0 || value.HasUnrealizedChildren()))
+    {
+        value.IsExpanded(isExpanded);
+
+        // Only nodes in the view listen to IsExpanded changes, raise the events of the other ones here.
+        if (m_flatTreeNodeInfos.find(winrt::get_self<TreeViewNode>(value)) == m_flatTreeNodeInfos.end())
+        {
+            if (isExpanded)
+            {
+                m_nodeExpandingEventSource(value, nullptr);
+            }
+            else
+            {
+                m_nodeCollapsedEventSource(value, nullptr);
+            }
+        }
+    }
+
+    if (depth != 0)
+    {
+        unsigned int size = value.Children().Size();
+        for (unsigned int i = 0; i < size; i++)
+        {
+            SetIsExpandedToDepth(value.Children().GetAt(i).as<winrt::TreeViewNode>(), isExpanded, depth - 1);
+        }
+    }
+}
+
+// Runs updateExpansion without updating the view for each node that gets expanded or collapsed,
+// then replaces the visible descendants of value with a single splice.
+void ViewModel::UpdateExpansionInBulk(const winrt::TreeViewNode& value, std::function<void()> const& updateExpansion)
+{
+    {
+        m_isUpdatingExpansionInBulk = true;
+        auto scopeGuard = gsl::finally([this]()
+        {
+            m_isUpdatingExpansionInBulk = false;
+        });
+
+        updateExpansion();
+    }
+
+    // Expanding handlers may have added children to the view meanwhile, so read the
+    // range of value's visible descendants only now.
+    if (m_flatTreeNodeInfos.find(winrt::get_self<TreeViewNode>(value)) != m_flatTreeNodeInfos.end())
+    {
+        std::vector<winrt::TreeViewNode> nodes;
+        AppendVisibleDescendants(value, nodes);
+        SpliceView(GetNextIndexInFlatTree(value), VisibleDescendantCount(value), nodes);
     }
 }
 
@@ -668,96 +865,92 @@ int ViewModel::GetNextIndexInFlatTree(const winrt::TreeViewNode& node)
 // When ViewModel receives a event, it only includes the sender(parent TreeViewNode) and index.
 // We can't use sender[index] directly because it is already updated/removed
 // To find the removed TreeViewNode:
-//   calcuate allOpenedDescendantsCount in sender[0..index-1] first
-//   then add offset and finally return TreeViewNode by looking up the flat tree.
+//   the removed node was right after its previous sibling and that sibling's visible descendants
+//   (or right after the parent for the first child), so look it up in the flat tree from there.
 winrt::TreeViewNode ViewModel::GetRemovedChildTreeViewNodeByIndex(winrt::TreeViewNode const& node, unsigned int childIndex)
 {
-    unsigned int allOpenedDescendantsCount = 0;
-    for (unsigned int i = 0; i < childIndex; i++)
+    unsigned int childIndexInFlatTree = GetNextIndexInFlatTree(node);
+    if (childIndex > 0)
     {
-        winrt::TreeViewNode calcNode = node.Children().GetAt(i).as<winrt::TreeViewNode>();
-        if (calcNode.IsExpanded())
-        {
-            allOpenedDescendantsCount += GetExpandedDescendantCount(calcNode);
-        }
+        auto previousSibling = node.Children().GetAt(childIndex - 1).as<winrt::TreeViewNode>();
+        childIndexInFlatTree = GetNextIndexInFlatTree(previousSibling) + VisibleDescendantCount(previousSibling);
     }
 
-    const unsigned int childIndexInFlatTree = GetNextIndexInFlatTree(node) + childIndex + allOpenedDescendantsCount;
     return GetNodeAt(childIndexInFlatTree);
 }
 
-int ViewModel::CountDescendants(const winrt::TreeViewNode& value)
+// Index of the first node after childNode and its visible descendants in the flat tree.
+unsigned int ViewModel::IndexOfNextSibling(winrt::TreeViewNode const& childNode)
 {
-    int descendantCount = 0;
-    unsigned int size = value.Children().Size();
-    for (unsigned int i = 0; i < size; i++)
+    return GetNextIndexInFlatTree(childNode) + VisibleDescendantCount(childNode);
+}
+
+unsigned int ViewModel::VisibleDescendantCount(winrt::TreeViewNode const& node)
+{
+    if (node)
     {
-        auto childNode = value.Children().GetAt(i).as<winrt::TreeViewNode>();
-        descendantCount++;
-        if (childNode.IsExpanded())
+        const auto it = m_flatTreeNodeInfos.find(winrt::get_self<TreeViewNode>(node));
+        if (it != m_flatTreeNodeInfos.end())
         {
-            descendantCount = descendantCount + CountDescendants(childNode);
+            return it->second.visibleDescendantCount;
         }
     }
-
-    return descendantCount;
+    return 0;
 }
 
-unsigned int ViewModel::IndexOfNextSibling(winrt::TreeViewNode const& childNode)
+void ViewModel::AddToFlatTreeIndex(uint32_t index, winrt::TreeViewNode const& node)
 {
-    auto child = childNode;
-    auto parentNode = child.Parent();
-    unsigned int stopIndex;
-    bool isLastRelativeChild = true;
-    while (parentNode && isLastRelativeChild)
+    auto tvnNode = winrt::get_self<TreeViewNode>(node);
+    m_flatTreeIndex.Insert(index, tvnNode);
+
+    TreeViewNode* parent = nullptr;
+    if (auto parentNode = node.Parent())
     {
-        unsigned int relativeIndex;
-        parentNode.Children().IndexOf(child, relativeIndex);
-        if (parentNode.Children().Size() - 1 != relativeIndex)
+        parent = winrt::get_self<TreeViewNode>(parentNode);
+        if (m_flatTreeNodeInfos.find(parent) == m_flatTreeNodeInfos.end())
         {
-            isLastRelativeChild = false;
-        }
-        else
-        {
-            child = parentNode;
-            parentNode = parentNode.Parent();
+            parent = nullptr;
         }
     }
 
-    if (parentNode)
-    {
-        unsigned int siblingIndex;
-        parentNode.Children().IndexOf(child, siblingIndex);
-        auto siblingNode = parentNode.Children().GetAt(siblingIndex + 1);
-        IndexOfNode(siblingNode, stopIndex);
-    }
-    else
+    m_flatTreeNodeInfos[tvnNode] = FlatTreeNodeInfo{ parent, 0 };
+    AdjustVisibleDescendantCounts(parent, 1);
+}
+
+void ViewModel::RemoveFromFlatTreeIndex(uint32_t index, winrt::TreeViewNode const& node)
+{
+    auto tvnNode = winrt::get_self<TreeViewNode>(node);
+    m_flatTreeIndex.RemoveAt(index);
+
+    // Use the parent recorded when the node was added since the node may
+    // already have been removed from its parent's children.
+    const auto it = m_flatTreeNodeInfos.find(tvnNode);
+    if (it != m_flatTreeNodeInfos.end())
     {
-        stopIndex = Size();
+        const auto parent = it->second.parent;
+        m_flatTreeNodeInfos.erase(it);
+        AdjustVisibleDescendantCounts(parent, -1);
     }
-
-    return stopIndex;
 }
 
-unsigned int ViewModel::GetExpandedDescendantCount(winrt::TreeViewNode const& parentNode)
+void ViewModel::AdjustVisibleDescendantCounts(TreeViewNode* parent, int delta)
 {
-    unsigned int allOpenedDescendantsCount = 0;
-    for (unsigned int i = 0; i < parentNode.Children().Size(); i++)
+    while (parent)
     {
-        auto childNode = parentNode.Children().GetAt(i).as<winrt::TreeViewNode>();
-        allOpenedDescendantsCount++;
-        if (childNode.IsExpanded())
+        const auto it = m_flatTreeNodeInfos.find(parent);
+        if (it == m_flatTreeNodeInfos.end())
         {
-            allOpenedDescendantsCount += CountDescendants(childNode);
+            break;
         }
+
+        it->second.visibleDescendantCount += delta;
+        parent = it->second.parent;
     }
-    return allOpenedDescendantsCount;
 }
 
 bool ViewModel::IsNodeSelected(winrt::TreeViewNode const& targetNode)
 {
-    unsigned int index;
-    return m_selectedNodes.get().IndexOf(targetNode, index);
+    return winrt::get_self<SelectedTreeNodeVector>(m_selectedNodes.get())->Contains(targetNode);
 }
 
 TreeNodeSelectionState ViewModel::NodeSelectionState(winrt::TreeViewNode const& targetNode)
@@ -782,7 +975,7 @@ void ViewModel::UpdateNodeSelection(winrt::TreeViewNode const& selectNode, TreeN
         case TreeNodeSelectionState::PartialSelected:
         case TreeNodeSelectionState::UnSelected:
             unsigned int index;
-            if (selectedNodes->IndexOf(selectNode, index))
+            if (selectedNodes->Contains(selectNode) && selectedNodes->IndexOf(selectNode, index))
             {
                 selectedNodes->RemoveAtCore(index);
                 winrt::get_self<TreeViewNode>(selectNode)->ChildrenChanged(m_selectedNodeChildrenChangedEventTokenVector[index]);
@@ -912,7 +1105,7 @@ winrt::TreeViewNode ViewModel::GetAssociatedNode(winrt::IInspectable item)
 
 bool ViewModel::IndexOfNode(winrt::TreeViewNode const& targetNode, uint32_t& index)
 {
-    return GetVectorInnerImpl()->IndexOf(targetNode, index);
+    return targetNode && m_flatTreeIndex.PositionOf(winrt::get_self<TreeViewNode>(targetNode), index);
 }
 
 void ViewModel::TreeViewNodeVectorChanged(winrt::TreeViewNode const& sender, winrt::IInspectable const& args)
@@ -928,12 +1121,31 @@ void ViewModel::TreeViewNodeVectorChanged(winrt::TreeViewNode const& sender, win
     case (winrt::CollectionChange::Reset):
     {
         auto resetNode = sender.as<winrt::TreeViewNode>();
+
+        // Range operations on the children raise a single Reset. Drop the children that clearing
+        // removed, along with their descendants, before registering the new children.
+        if (IsContentMode())
+        {
+            for (auto const& clearedNode : winrt::get_self<TreeViewNodeVector>(resetNode.Children())->ClearedNodes())
+            {
+                RemoveNodeAndDescendantsFromItemToNodeMap(clearedNode);
+            }
+
+            for (auto const& child : resetNode.Children())
+            {
+                m_itemToNodeMap.get().Insert(child.Content(), child);
+            }
+        }
+
         if (resetNode.IsExpanded())
         {
             //The lowIndex is the index of the first child, while the high index is the index of the last descendant in the list.
             const unsigned int lowIndex = GetNextIndexInFlatTree(resetNode);
-            const unsigned int highIndex = IndexOfNextSibling(resetNode) - 1;
-            RemoveNodesAndDescendentsWithFlatIndexRange(lowIndex, highIndex);
+            const unsigned int nextSiblingIndex = IndexOfNextSibling(resetNode);
+            if (nextSiblingIndex > lowIndex)
+            {
+                RemoveNodesAndDescendentsWithFlatIndexRange(lowIndex, nextSiblingIndex - 1);
+            }
 
             // reset the status of resetNodes children
             CollapseNode(resetNode);
@@ -944,11 +1156,8 @@ void ViewModel::TreeViewNodeVectorChanged(winrt::TreeViewNode const& sender, win
     }
 
     // We will find the correct index of insertion by first checking if the
-    // node we are inserting into is expanded. If it is we will start walking
-    // down the tree and counting the open items. This is to ensure we place
-    // the inserted item in the correct index. If along the way we bump into
-    // the item being inserted, we insert there then return, because we don't
-    // need to do anything further.
+    // node we are inserting into is expanded. If it is, the inserted item goes
+    // right after its previous sibling and that sibling's visible descendants.
     case (winrt::CollectionChange::ItemInserted):
     {
         auto targetNode = sender.as<winrt::TreeViewNode>().Children().GetAt(index).as<winrt::TreeViewNode>();
@@ -959,27 +1168,19 @@ void ViewModel::TreeViewNodeVectorChanged(winrt::TreeViewNode const& sender, win
         }
 
         auto parentNode = targetNode.Parent();
-        const unsigned int nextNodeIndex = GetNextIndexInFlatTree(parentNode);
-        int allOpenedDescendantsCount = 0;
 
         if (parentNode.IsExpanded())
         {
-            for (unsigned int i = 0; i < parentNode.Children().Size(); i++)
+            // The new node goes right after its previous sibling and that sibling's visible
+            // descendants, or right after its parent if it is the first child.
+            unsigned int insertIndex = GetNextIndexInFlatTree(parentNode);
+            if (index > 0)
             {
-                auto childNode = parentNode.Children().GetAt(i).as<winrt::TreeViewNode>();
-                if (childNode == targetNode)
-                {
-                    AddNodeToView(targetNode, nextNodeIndex + i + allOpenedDescendantsCount);
-                    if (targetNode.IsExpanded())
-                    {
-                        AddNodeDescendantsToView(targetNode, nextNodeIndex + i, allOpenedDescendantsCount);
-                    }
-                }
-                else if (childNode.IsExpanded())
-                {
-                    allOpenedDescendantsCount += CountDescendants(childNode);
-                }
+                auto previousSibling = parentNode.Children().GetAt(index - 1).as<winrt::TreeViewNode>();
+                insertIndex = GetNextIndexInFlatTree(previousSibling) + VisibleDescendantCount(previousSibling);
             }
+
+            AddNodeAndDescendantsToView(targetNode, insertIndex);
         }
 
         break;
@@ -1127,21 +1328,15 @@ void ViewModel::TreeViewNodePropertyChanged(winrt::TreeViewNode const& sender, w
 void ViewModel::TreeViewNodeIsExpandedPropertyChanged(winrt::TreeViewNode const& sender, winrt::IDependencyPropertyChangedEventArgs const& args)
 {
     auto targetNode = sender.as<winrt::TreeViewNode>();
+    // ExpandAll and CollapseAll update the view once they are done with all the nodes.
+    const bool updateView = !m_isUpdatingExpansionInBulk && m_flatTreeNodeInfos.find(winrt::get_self<TreeViewNode>(targetNode)) != m_flatTreeNodeInfos.end();
     if (targetNode.IsExpanded())
     {
-        if (targetNode.Children().Size() != 0)
+        if (updateView && targetNode.Children().Size() != 0)
         {
-            int openedDescendantOffset = 0;
-            unsigned int index;
-            IndexOfNode(targetNode, index);
-            index = index + 1;
-            for (unsigned int i = 0; i < targetNode.Children().Size(); i++)
-            {
-                winrt::TreeViewNode childNode{ nullptr };
-                childNode = targetNode.Children().GetAt(i).as<winrt::TreeViewNode>();
-                AddNodeToView(childNode, index + i + openedDescendantOffset);
-                openedDescendantOffset = AddNodeDescendantsToView(childNode, index + i, openedDescendantOffset);
-            }
+            std::vector<winrt::TreeViewNode> nodes;
+            AppendVisibleDescendants(targetNode, nodes);
+            SpliceView(GetNextIndexInFlatTree(targetNode), 0, nodes);
         }
 
         //Notify TreeView that a node is being expanded.
@@ -1149,11 +1344,9 @@ void ViewModel::TreeViewNodeIsExpandedPropertyChanged(winrt::TreeViewNode const&
     }
     else
     {
-        for (unsigned int i = 0; i < targetNode.Children().Size(); i++)
+        if (updateView)
         {
-            winrt::TreeViewNode childNode{ nullptr };
-            childNode = targetNode.Children().GetAt(i).as<winrt::TreeViewNode>();
-            RemoveNodeAndDescendantsFromView(childNode);
+            SpliceView(GetNextIndexInFlatTree(targetNode), VisibleDescendantCount(targetNode), {});
         }
 
         //Notify TreeView that a node is being collapsed
@@ -1185,6 +1378,21 @@ bool ViewModel::IsContentMode()
     return m_isContentMode;
 }
 
+// Removes the entries of node and its descendants, unless another node took over their item since.
+void ViewModel::RemoveNodeAndDescendantsFromItemToNodeMap(const winrt::TreeViewNode& node)
+{
+    const auto item = node.Content();
+    if (m_itemToNodeMap.get().Lookup(item) == node)
+    {
+        m_itemToNodeMap.get().Remove(item);
+    }
+
+    for (auto const& child : node.Children())
+    {
+        RemoveNodeAndDescendantsFromItemToNodeMap(child);
+    }
+}
+
 void ViewModel::ClearEventTokenVectors()
 {
     // Remove ChildrenChanged and ExpandedChanged events
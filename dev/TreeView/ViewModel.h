@@ -4,6 +4,7 @@
 #pragma once
 #include <Vector.h>
 #include "TreeViewNode.h"
+#include "FlatTreeIndex.h"
 
 using TreeNodeSelectionState = TreeViewNode::TreeNodeSelectionState;
 using ViewModelVectorOptions = typename VectorOptionsFromFlag<winrt::IInspectable, MakeVectorParam<VectorFlag::Observable, VectorFlag::DependencyObjectBase>()>;
@@ -26,6 +27,8 @@ public:
 
     void ExpandNode(const winrt::TreeViewNode& value);
     void CollapseNode(const winrt::TreeViewNode& value);
+    void ExpandAll(const winrt::TreeViewNode& value, int depth);
+    void CollapseAll(const winrt::TreeViewNode& value, int depth);
     winrt::event_token NodeExpanding(const winrt::TypedEventHandler<winrt::TreeViewNode, winrt::IInspectable>& handler);
     void NodeExpanding(const winrt::event_token token);
     winrt::event_token NodeCollapsed(const winrt::TypedEventHandler<winrt::TreeViewNode, winrt::IInspectable>& handler);
@@ -96,21 +99,48 @@ private:
     tracker_ref<winrt::IMap<winrt::IInspectable, winrt::TreeViewNode>> m_itemToNodeMap{ this };
     uint32_t m_selectionTrackingCounter{ 0 };
 
+    // Flat tree position of every node in the view, kept in sync by the IVector modify functions.
+    FlatTreeIndex<TreeViewNode*> m_flatTreeIndex;
+
+    // For the origin node and every node in the view: its parent and how many of its descendants
+    // are in the view. A node and its visible descendants are contiguous in the flat tree.
+    struct FlatTreeNodeInfo
+    {
+        TreeViewNode* parent{ nullptr };
+        uint32_t visibleDescendantCount{ 0 };
+    };
+    std::unordered_map<TreeViewNode*, FlatTreeNodeInfo> m_flatTreeNodeInfos;
+
+    // Set while ExpandAll or CollapseAll changes IsExpanded on many nodes, which defers view updates.
+    bool m_isUpdatingExpansionInBulk{ false };
+
+    // Splices that add or remove more nodes than this raise a single Reset instead of one notification per node.
+    static constexpr unsigned int c_maxItemNotificationsPerSplice = 32;
+
+    // Focuses the container of the node that had focus before a splice raised a Reset, once the list has recreated it.
+    winrt::FrameworkElement::LayoutUpdated_revoker m_restoreFocusLayoutUpdatedRevoker{};
+
     // Methods
     winrt::TreeViewNode GetRemovedChildTreeViewNodeByIndex(winrt::TreeViewNode const& node, unsigned int childIndex);
-    int CountDescendants(const winrt::TreeViewNode& value);
-    void AddNodeToView(const winrt::TreeViewNode& value, unsigned int index);
-    int AddNodeDescendantsToView(const winrt::TreeViewNode& value, unsigned int index, int offset);
+    void AddNodeAndDescendantsToView(const winrt::TreeViewNode& value, unsigned int index);
+    void AppendVisibleDescendants(const winrt::TreeViewNode& value, std::vector<winrt::TreeViewNode>& nodes);
     void RemoveNodeAndDescendantsFromView(const winrt::TreeViewNode& value);
     void RemoveNodesAndDescendentsWithFlatIndexRange(unsigned int startIndex, unsigned int stopIndex);
+    void SpliceView(unsigned int index, unsigned int removeCount, std::vector<winrt::TreeViewNode> const& nodes);
+    void SetIsExpandedToDepth(const winrt::TreeViewNode& value, bool isExpanded, int depth);
+    void UpdateExpansionInBulk(const winrt::TreeViewNode& value, std::function<void()> const& updateExpansion);
     int GetNextIndexInFlatTree(winrt::TreeViewNode const& indexNode);
     unsigned int IndexOfNextSibling(winrt::TreeViewNode const& childNode);
-    unsigned int GetExpandedDescendantCount(winrt::TreeViewNode const& parentNode);
+    unsigned int VisibleDescendantCount(winrt::TreeViewNode const& node);
+    void AddToFlatTreeIndex(uint32_t index, winrt::TreeViewNode const& node);
+    void RemoveFromFlatTreeIndex(uint32_t index, winrt::TreeViewNode const& node);
+    void AdjustVisibleDescendantCounts(TreeViewNode* parent, int delta);
     void UpdateNodeSelection(winrt::TreeViewNode const& selectNode, TreeNodeSelectionState const& selectionState);
     void UpdateSelectionStateOfDescendants(winrt::TreeViewNode const& targetNode, TreeNodeSelectionState const& selectionState);
     void UpdateSelectionStateOfAncestors(winrt::TreeViewNode const& targetNode);
     TreeNodeSelectionState SelectionStateBasedOnChildren(winrt::TreeViewNode const& node);
     void ClearEventTokenVectors();
+    void RemoveNodeAndDescendantsFromItemToNodeMap(const winrt::TreeViewNode& node);
     void BeginSelectionChanges();
     void EndSelectionChanges();
 };
@@ -8,6 +8,8 @@
 #include "MUXControlsFactory.h"
 
 std::vector<XamlMetadataProvider::Entry>* XamlMetadataProvider::s_types{ nullptr };
+std::unordered_map<wstring_view, size_t>* XamlMetadataProvider::s_typeIndices{ nullptr };
+XamlMetadataProvider::LookupCounters XamlMetadataProvider::s_counters{};
 
 XamlMetadataProvider::XamlMetadataProvider()
 {
@@ -29,33 +31,39 @@ bool XamlMetadataProvider::RegisterXamlType(
 #pragma warning(push)
 #pragma warning(disable : 26409) // Disable r.11, see comment in header file
         s_types = new std::vector<Entry>();
+        s_typeIndices = new std::unordered_map<wstring_view, size_t>();
 #pragma warning(pop)
     }
 
     Entry type{ typeName, createXamlTypeCallback };
 
     s_types->push_back(type);
+    const auto& registeredTypeName = s_types->back().typeName;
+    s_typeIndices->emplace(wstring_view{ registeredTypeName.data(), registeredTypeName.size() }, s_types->size() - 1);
     return true;
 }
 
 winrt::IXamlType XamlMetadataProvider::GetXamlType(
     const wstring_view& typeName)
 {
+    s_counters.Lookups++;
+
     if (s_types)
     {
-        for (auto& entry : *s_types)
+        const auto it = s_typeIndices->find(typeName);
+        if (it != s_typeIndices->end())
         {
-            if (typeName == entry.typeName)
+            auto& entry = (*s_types)[it->second];
+            if (!entry.xamlType)
             {
-                if (!entry.xamlType)
-                {
-                    entry.xamlType = entry.createXamlTypeCallback();
-                }
-                return entry.xamlType;
+                s_counters.ColdTypeCreations++;
+                entry.xamlType = entry.createXamlTypeCallback();
             }
+            return entry.xamlType;
         }
     }
 
+    s_counters.Misses++;
     return nullptr;
 }
 
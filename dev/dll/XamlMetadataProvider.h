@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "XamlType.h"
 #include "XamlMetadataProviderGenerated.h"
 #include "XamlControlsXamlMetaDataProvider.g.h"
@@ -42,6 +44,17 @@ public:
         const wstring_view& typeName
         );
 
+    struct LookupCounters
+    {
+        int64_t Lookups;
+        int64_t Misses;
+        // Lookups that had to run the registered callback to create the type.
+        int64_t ColdTypeCreations;
+    };
+
+    static LookupCounters Counters() { return s_counters; }
+    static void ResetCounters() { s_counters = {}; }
+
     // IXamlMetadataProvider
     winrt::IXamlType GetXamlType(winrt::TypeName const& type);
     winrt::IXamlType GetXamlTypeByFullName(winrt::hstring const& fullName);
@@ -58,4 +71,8 @@ private:
     // Defined as raw pointer so it doesn't have an initializer, this way we can control when it's initialized relative to other globals.
     // TODO: will clean this up with MSFT:9427272 - Codegen the IXamlMetadataProvider stuff
     static std::vector<Entry>* s_types;
+    // Index of each type in s_types by name. The keys point into the entries' hstrings, whose buffers
+    // don't move when s_types grows. The first registration of a name wins.
+    static std::unordered_map<wstring_view, size_t>* s_typeIndices;
+    static LookupCounters s_counters;
 };
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <array>
+#include <optional>
 #include <set>
+#include <vector>
 
 //
 // This is simple event implementation that is single-threaded and allows for customization of
@@ -15,8 +18,22 @@ static int64_t s_eventHandlerId = 0;
 template <typename ImplT, typename T, typename StorageT = T>
 class event_base
 {
+    // Tokens only grow, so appending keeps the handlers sorted by token, which is also the order
+    // they are invoked in.
+    using handler_entry = std::pair<int64_t, StorageT>;
+    using handler_list = std::vector<handler_entry>;
+
+    static constexpr size_t c_inlineHandlerCapacity = 4;
+
 protected:
-    std::shared_ptr<std::map<int64_t, StorageT>> m_handlers;
+    // The first few handlers are stored inline so that the common one-handler case never allocates.
+    // Invoke copies inline handlers out before calling them, so add/remove can modify them in place.
+    std::array<std::optional<handler_entry>, c_inlineHandlerCapacity> m_inlineHandlers;
+    size_t m_inlineHandlerCount{ 0 };
+    // Once there are more handlers than fit inline they move to a list that is never modified after
+    // it is published. Add/remove during an event call-out can happen, so they build a new list and
+    // swap it in while the call-out keeps iterating over its own snapshot.
+    std::shared_ptr<const handler_list> m_handlers;
 
 public:
 
@@ -32,56 +49,118 @@ public:
     winrt::event_token add(const T & value)
     {
         auto token = InterlockedIncrement64(&s_eventHandlerId);
-        
-        // Make a new map because add/remove during event call-out can happen and we want to
-        // swap in a new container instead of modifying the one that we're iterating over.
-        // This is a tradeoff -- either we copy the map every time during invoke in case add/remove
-        // happens or we make a new copy during add/remove. We (and the C++/WinRT implementation
-        // we're copied from) choose the latter.
-        auto handlers = std::make_shared<std::map<int64_t, StorageT>>();
-
-        if (auto * before = m_handlers.get())
+        auto holder = Impl()->wrap(value);
+
+        if (!m_handlers && m_inlineHandlerCount < c_inlineHandlerCapacity)
         {
-            handlers->insert(before->begin(), before->end());
+            m_inlineHandlers[m_inlineHandlerCount++].emplace(token, std::move(holder));
         }
-        
-        auto holder = Impl()->wrap(value);
-        handlers->insert({ token, holder });
-        m_handlers = std::move(handlers);
+        else
+        {
+            auto handlers = std::make_shared<handler_list>();
+            if (m_handlers)
+            {
+                handlers->reserve(m_handlers->size() + 1);
+                handlers->insert(handlers->end(), m_handlers->begin(), m_handlers->end());
+            }
+            else
+            {
+                handlers->reserve(m_inlineHandlerCount + 1);
+                for (size_t i = 0; i < m_inlineHandlerCount; i++)
+                {
+                    handlers->push_back(std::move(*m_inlineHandlers[i]));
+                    m_inlineHandlers[i].reset();
+                }
+                m_inlineHandlerCount = 0;
+            }
+
+            handlers->emplace_back(token, std::move(holder));
+            m_handlers = std::move(handlers);
+        }
+
         return winrt::event_token{ token };
     }
 
     void remove(const winrt::event_token token)
     {
-        // See comment in add(), we make a copy of the map on add/remove just like the C++/WinRT event implementation.
-        auto handlers = std::make_shared<std::map<int64_t, StorageT>>();
+        if (auto handlers = m_handlers)
+        {
+            const auto it = std::lower_bound(handlers->begin(), handlers->end(), token.value,
+                [](const handler_entry& entry, int64_t value) { return entry.first < value; });
+            if (it == handlers->end() || it->first != token.value)
+            {
+                return;
+            }
 
-        if (auto * before = m_handlers.get())
+            // Only move back inline once well below the inline capacity, so that a handler
+            // count going back and forth around it does not allocate on every add.
+            const auto remainingCount = handlers->size() - 1;
+            if (remainingCount <= c_inlineHandlerCapacity / 2)
+            {
+                for (auto entry = handlers->begin(); entry != handlers->end(); ++entry)
+                {
+                    if (entry != it)
+                    {
+                        m_inlineHandlers[m_inlineHandlerCount++].emplace(*entry);
+                    }
+                }
+                m_handlers = nullptr;
+            }
+            else
+            {
+                auto newHandlers = std::make_shared<handler_list>();
+                newHandlers->reserve(remainingCount);
+                newHandlers->insert(newHandlers->end(), handlers->begin(), it);
+                newHandlers->insert(newHandlers->end(), it + 1, handlers->end());
+                m_handlers = std::move(newHandlers);
+            }
+        }
+        else
         {
-            handlers->insert(before->begin(), before->end());
+            for (size_t i = 0; i < m_inlineHandlerCount; i++)
+            {
+                if (m_inlineHandlers[i]->first == token.value)
+                {
+                    for (size_t j = i + 1; j < m_inlineHandlerCount; j++)
+                    {
+                        m_inlineHandlers[j - 1] = std::move(m_inlineHandlers[j]);
+                    }
+                    m_inlineHandlers[--m_inlineHandlerCount].reset();
+                    break;
+                }
+            }
         }
-
-        handlers->erase(token.value);
-        m_handlers = std::move(handlers);
     }
 
     template <typename... A> void operator()(A const & ... args) const
     {
-        auto handlers = m_handlers;
-
-        if (auto * map = handlers.get())
+        if (auto handlers = m_handlers)
         {
-            for (const auto & pair : *map)
+            for (const auto & pair : *handlers)
             {
                 auto handler = Impl()->unwrap(pair.second);
                 handler(args...);
             }
         }
+        else if (m_inlineHandlerCount > 0)
+        {
+            const auto count = m_inlineHandlerCount;
+            std::array<T, c_inlineHandlerCapacity> inlineHandlers{};
+            for (size_t i = 0; i < count; i++)
+            {
+                inlineHandlers[i] = Impl()->unwrap(m_inlineHandlers[i]->second);
+            }
+
+            for (size_t i = 0; i < count; i++)
+            {
+                inlineHandlers[i](args...);
+            }
+        }
     }
 
     explicit operator bool() const noexcept
     {
-        return static_cast<bool>(m_handlers) && m_handlers.get()->size() > 0;
+        return m_inlineHandlerCount > 0 || (static_cast<bool>(m_handlers) && m_handlers.get()->size() > 0);
     }
 
 private:
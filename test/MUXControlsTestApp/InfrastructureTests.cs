@@ -0,0 +1,175 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License. See LICENSE in the project root for license information.
+
+using System.Collections.Generic;
+using System.Collections.ObjectModel;
+using System.Collections.Specialized;
+using System.Linq;
+
+using MUXControlsTestApp.Utilities;
+using Windows.Foundation.Collections;
+
+using Common;
+
+#if USING_TAEF
+using WEX.TestExecution;
+using WEX.TestExecution.Markup;
+using WEX.Logging.Interop;
+#else
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using Microsoft.VisualStudio.TestTools.UnitTesting.Logging;
+#endif
+
+using ColorSpectrum = Microsoft.UI.Xaml.Controls.Primitives.ColorSpectrum;
+using ItemsSourceView = Microsoft.UI.Xaml.Controls.ItemsSourceView;
+using MUXControlsTestHooks = Microsoft.UI.Private.Controls.MUXControlsTestHooks;
+using XamlControlsXamlMetaDataProvider = Microsoft.UI.Xaml.XamlTypeInfo.XamlControlsXamlMetaDataProvider;
+
+namespace Windows.UI.Xaml.Tests.MUXControls.ApiTests
+{
+    // Tests for the pieces shared by every control rather than for one control.
+    [TestClass]
+    public class InfrastructureTests : ApiTestBase
+    {
+        [TestMethod]
+        public void VerifyVectorRangeOperationsRaiseOneNotification()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                var vector = MUXControlsTestHooks.CreateObservableVector();
+                var changes = new List<IVectorChangedEventArgs>();
+                vector.VectorChanged += (sender, args) => changes.Add(args);
+
+                Log.Comment("Inserting one item raises ItemInserted");
+                MUXControlsTestHooks.InsertRange(vector, 0, new object[] { "a" });
+                Verify.AreEqual(1, changes.Count);
+                Verify.AreEqual(CollectionChange.ItemInserted, changes[0].CollectionChange);
+                Verify.AreEqual(0u, changes[0].Index);
+
+                Log.Comment("Inserting several items raises one Reset");
+                changes.Clear();
+                MUXControlsTestHooks.InsertRange(vector, 1, new object[] { "b", "c", "d" });
+                Verify.AreEqual(1, changes.Count);
+                Verify.AreEqual(CollectionChange.Reset, changes[0].CollectionChange);
+                Verify.IsTrue(new object[] { "a", "b", "c", "d" }.SequenceEqual(vector));
+
+                Log.Comment("Inserting nothing raises nothing");
+                changes.Clear();
+                MUXControlsTestHooks.InsertRange(vector, 2, new object[] { });
+                Verify.AreEqual(0, changes.Count);
+
+                Log.Comment("Removing one item raises ItemRemoved");
+                MUXControlsTestHooks.RemoveRange(vector, 1, 1);
+                Verify.AreEqual(1, changes.Count);
+                Verify.AreEqual(CollectionChange.ItemRemoved, changes[0].CollectionChange);
+                Verify.AreEqual(1u, changes[0].Index);
+
+                Log.Comment("Removing several items raises one Reset");
+                changes.Clear();
+                MUXControlsTestHooks.RemoveRange(vector, 0, 2);
+                Verify.AreEqual(1, changes.Count);
+                Verify.AreEqual(CollectionChange.Reset, changes[0].CollectionChange);
+                Verify.IsTrue(new object[] { "d" }.SequenceEqual(vector));
+
+                Log.Comment("Removing nothing raises nothing");
+                changes.Clear();
+                MUXControlsTestHooks.RemoveRange(vector, 1, 0);
+                Verify.AreEqual(0, changes.Count);
+            });
+        }
+
+        [TestMethod]
+        public void VerifyEventHandlersRunInOrderAcrossInlineCapacity()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                // The first four handlers of an event are stored inline, the rest spill over into a shared list.
+                var data = new ObservableCollection<int>();
+                var dataSource = new ItemsSourceView(data);
+                var invoked = new List<int>();
+                var handlers = new List<NotifyCollectionChangedEventHandler>();
+                for (int i = 0; i < 6; i++)
+                {
+                    int handlerIndex = i;
+                    handlers.Add((sender, args) => invoked.Add(handlerIndex));
+                }
+
+                void VerifyInvokedHandlers(params int[] expected)
+                {
+                    invoked.Clear();
+                    data.Add(0);
+                    Verify.IsTrue(invoked.SequenceEqual(expected),
+                        string.Format("Expected handlers [{0}], got [{1}]", string.Join(",", expected), string.Join(",", invoked)));
+                }
+
+                Log.Comment("Handlers run in subscription order while inline and once spilled over");
+                for (int i = 0; i < handlers.Count; i++)
+                {
+                    dataSource.CollectionChanged += handlers[i];
+                    VerifyInvokedHandlers(Enumerable.Range(0, i + 1).ToArray());
+                }
+
+                Log.Comment("Removing from the spilled over list keeps the order of the others");
+                dataSource.CollectionChanged -= handlers[2];
+                VerifyInvokedHandlers(0, 1, 3, 4, 5);
+                dataSource.CollectionChanged -= handlers[0];
+                VerifyInvokedHandlers(1, 3, 4, 5);
+                dataSource.CollectionChanged -= handlers[5];
+                VerifyInvokedHandlers(1, 3, 4);
+                dataSource.CollectionChanged -= handlers[3];
+                VerifyInvokedHandlers(1, 4);
+
+                Log.Comment("Handlers added after moving back inline run after the remaining ones");
+                dataSource.CollectionChanged += handlers[0];
+                dataSource.CollectionChanged += handlers[2];
+                VerifyInvokedHandlers(1, 4, 0, 2);
+                dataSource.CollectionChanged += handlers[5];
+                dataSource.CollectionChanged += handlers[3];
+                VerifyInvokedHandlers(1, 4, 0, 2, 5, 3);
+
+                Log.Comment("Removing a handler that is not subscribed changes nothing");
+                dataSource.CollectionChanged -= (sender, args) => invoked.Add(-2);
+                VerifyInvokedHandlers(1, 4, 0, 2, 5, 3);
+
+                Log.Comment("A handler removing itself during the call-out does not stop the others");
+                NotifyCollectionChangedEventHandler selfRemoving = null;
+                selfRemoving = (sender, args) => { invoked.Add(-1); dataSource.CollectionChanged -= selfRemoving; };
+                dataSource.CollectionChanged += selfRemoving;
+                foreach (var handler in new[] { handlers[4], handlers[0], handlers[5], handlers[3], handlers[2] })
+                {
+                    dataSource.CollectionChanged -= handler;
+                }
+
+                VerifyInvokedHandlers(1, -1);
+                VerifyInvokedHandlers(1);
+
+                dataSource.CollectionChanged -= handlers[1];
+                VerifyInvokedHandlers();
+            });
+        }
+
+        [TestMethod]
+        public void VerifyXamlTypeLookupCreatesEachTypeOnce()
+        {
+            RunOnUIThread.Execute(() =>
+            {
+                XamlControlsXamlMetaDataProvider provider = new XamlControlsXamlMetaDataProvider();
+                var colorSpectrumType = provider.GetXamlType(typeof(ColorSpectrum).FullName);
+                Verify.IsNotNull(colorSpectrumType);
+
+                MUXControlsTestHooks.ResetXamlMetadataProviderCounters();
+                Verify.AreSame(colorSpectrumType, provider.GetXamlType(typeof(ColorSpectrum).FullName));
+                var counters = MUXControlsTestHooks.GetXamlMetadataProviderCounters();
+                Verify.AreEqual(1, counters.Lookups);
+                Verify.AreEqual(0, counters.Misses);
+                Verify.AreEqual(0, counters.ColdTypeCreations);
+
+                Verify.IsNull(provider.GetXamlType("Microsoft.UI.Xaml.Controls.NotARegisteredType"));
+                counters = MUXControlsTestHooks.GetXamlMetadataProviderCounters();
+                Verify.AreEqual(2, counters.Lookups);
+                Verify.AreEqual(1, counters.Misses);
+                Verify.AreEqual(0, counters.ColdTypeCreations);
+            });
+        }
+    }
+}